@@ -506,6 +506,7 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 	D3DXVECTOR3	p1, p2, p3;
 	D3DXVECTOR3	a, b, n;
 	Edge		e;
+	edgelist	edges;
 	BYTE*		vdata		= 0;
 	WORD*		idata		= 0;
 	size_t		ind;
@@ -526,13 +527,10 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 	mesh->LockIndexBuffer(D3DLOCK_READONLY, (LPVOID*)&idata);
 	mesh->LockVertexBuffer(D3DLOCK_READONLY, (LPVOID*)&vdata);
 
-	out.reserve(512);
+	edges.reserve(numindices);
 
 	for( DWORD i = 0; i < numindices; i += 3 )
 	{
-		if( out.capacity() <= out.size() )
-			out.reserve(out.size() + 1024);
-
 		i1 = idata[i + 0];
 		i2 = idata[i + 1];
 		i3 = idata[i + 2];
@@ -555,8 +553,7 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 			e.v2 = p2;
 			e.n1 = n;
 
-			if( !out.insert(e).second )
-				std::cout << "Crack in mesh (first triangle)\n";
+			edges.push_back(e);
 		}
 
 		if( i2 < i3 )
@@ -567,8 +564,7 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 			e.v2 = p3;
 			e.n1 = n;
 
-			if( !out.insert(e).second )
-				std::cout << "Crack in mesh (first triangle)\n";
+			edges.push_back(e);
 		}
 
 		if( i3 < i1 )
@@ -579,11 +575,14 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 			e.v2 = p1;
 			e.n1 = n;
 
-			if( !out.insert(e).second )
-				std::cout << "Crack in mesh (first triangle)\n";
+			edges.push_back(e);
 		}
 	}
 
+	// sort and merge at once
+	if( out.insert_range(edges.begin(), edges.end()) < edges.size() )
+		std::cout << "Crack in mesh (first triangle)\n";
+
 	// find second triangle for each edge
 	for( DWORD i = 0; i < numindices; i += 3 )
 	{
@@ -91,6 +91,8 @@ SceneObjectPrototype*	prototypes[3]	= { 0, 0, 0 };
 ObjectArray				sceneobjects;
 BatchArray				tiles;
 BatchArray				visibletiles;
+OpenGLAABoxArray		tileboxes;
+std::vector<uint32_t>	visibleindices;
 BasicCamera				debugcamera;
 OpenGLScreenQuad*		screenquad		= 0;
 OpenGLEffect*			basic2D			= 0;
@@ -337,6 +339,11 @@ bool InitScene()
 	}
 
 	visibletiles.reserve(tiles.size());
+	visibleindices.resize(tiles.size());
+	tileboxes.Reserve(tiles.size());
+
+	for( size_t i = 0; i < tiles.size(); ++i )
+		tileboxes.Add(tiles[i]->GetBoundingBox());
 
 	// setup debug camera
 	OpenGLAABox worldbox;
@@ -380,13 +387,14 @@ void UpdateTiles(float* viewproj)
 	GLFrustumPlanes(planes, viewproj);
 	visibletiles.clear();
 
-	for( size_t i = 0; i < tiles.size(); ++i )
-	{
-		const OpenGLAABox& tilebox = tiles[i]->GetBoundingBox();
+	// visibleindices is empty without tiles
+	if( tileboxes.Size() == 0 )
+		return;
 
-		if( GLFrustumIntersect(planes, tilebox) > 0 )
-			visibletiles.push_back(tiles[i]);
-	}
+	size_t numvisible = GLFrustumCullIndices(&visibleindices[0], planes, tileboxes);
+
+	for( size_t i = 0; i < numvisible; ++i )
+		visibletiles.push_back(tiles[visibleindices[i]]);
 }
 
 void UninitScene()
@@ -406,6 +414,8 @@ void UninitScene()
 	visibletiles.clear();
 	visibletiles.swap(BatchArray());
 
+	tileboxes.Clear();
+
 	for( size_t i = 0; i < sceneobjects.size(); ++i )
 		delete sceneobjects[i];
 
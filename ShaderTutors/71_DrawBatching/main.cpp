@@ -138,6 +138,8 @@ SceneObjectPrototype*	prototypes[3]		= { 0, 0, 0 };
 ObjectArray				sceneobjects;
 BatchArray				tiles;
 BatchArray				visibletiles;
+VulkanAABoxArray		tileboxes;
+std::vector<uint32_t>	tilemask;
 BasicCamera				debugcamera;
 float					debugworld[16];
 float					debugcolor[4];
@@ -625,6 +627,11 @@ bool InitScene()
 	}
 
 	visibletiles.reserve(tiles.size());
+	tilemask.resize((tiles.size() + 31) / 32);
+	tileboxes.Reserve(tiles.size());
+
+	for( size_t i = 0; i < tiles.size(); ++i )
+		tileboxes.Add(tiles[i]->GetBoundingBox());
 
 	// setup debug camera
 	VulkanAABox worldbox;
@@ -730,10 +737,12 @@ void UpdateTiles(float* viewproj, uint32_t currentimage)
 	for( size_t i = 0; i < sceneobjects.size(); ++i )
 		sceneobjects[i]->SetEncoded(false);
 
-	for( size_t i = 0; i < tiles.size(); ++i ) {
-		const VulkanAABox& tilebox = tiles[i]->GetBoundingBox();
+	// tilemask is empty without tiles
+	if( tileboxes.Size() > 0 )
+		VKFrustumCullMask(&tilemask[0], planes, tileboxes);
 
-		if( VKFrustumIntersect(planes, tilebox) > 0 ) {
+	for( size_t i = 0; i < tiles.size(); ++i ) {
+		if( tilemask[i / 32] & (1u << (i % 32)) ) {
 			visibletiles.push_back(tiles[i]);
 
 			// mark tile-encoded objects encoded (to avoid double encoding)
@@ -813,6 +822,8 @@ void UninitScene()
 	visibletiles.clear();
 	visibletiles.swap(BatchArray());
 
+	tileboxes.Clear();
+
 	for( size_t i = 0; i < sceneobjects.size(); ++i )
 		delete sceneobjects[i];
 
@@ -0,0 +1,6 @@
+
+// the same code without SIMD, under the D3D prefix so that both versions can be linked
+#define USE_D3D_PREFIX
+#define MATH_NO_SIMD
+
+#include "../common/3Dmath.cpp"
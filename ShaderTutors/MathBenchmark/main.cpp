@@ -0,0 +1,990 @@
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include "../common/3Dmath.h"
+#include "../common/3Dmathtypes.h"
+#include "../common/fft.h"
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <Windows.h>
+#else
+#	include <time.h>
+#endif
+
+// scalar versions (see 3Dmath_scalar.cpp)
+void D3DVec3Transform(float out[3], const float v[3], const float m[16]);
+void D3DVec3TransformCoord(float out[3], const float v[3], const float m[16]);
+void D3DVec4Transform(float out[4], const float v[4], const float m[16]);
+void D3DMatrixMultiply(float out[16], const float a[16], const float b[16]);
+void D3DMatrixTranspose(float out[16], float m[16]);
+void D3DQuaternionMultiply(float out[4], float a[4], float b[4]);
+void D3DVec3TransformArray(float* out, size_t outstride, const float* in, size_t instride, const float m[16], size_t count);
+void D3DVec3TransformCoordArray(float* out, size_t outstride, const float* in, size_t instride, const float m[16], size_t count);
+void D3DVec3TransformCoordSoA(float* outx, float* outy, float* outz, const float* x, const float* y, const float* z, const float m[16], size_t count);
+
+#define NUM_ELEMENTS	1024
+#define NUM_ROUNDS		2000
+#define NUM_VERTICES	(1024 * 1024)
+#define NUM_BOXES		100000
+#define NUM_TEXELS		(3840 * 2160 * 4)	// 4K RGBA
+#define FFT_TOLERANCE	1e-4f				// the algorithms differ, the results can't be identical
+
+struct testdata
+{
+	float matrices[NUM_ELEMENTS][16];
+	float vectors[NUM_ELEMENTS][4];
+	float results[2][NUM_ELEMENTS][16];
+};
+
+typedef void (*benchfunc)(testdata& data, int which);
+
+static double GetTime()
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, now;
+
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+static float Random(float low, float high)
+{
+	return low + (high - low) * ((float)rand() / (float)RAND_MAX);
+}
+
+// which == 0 is the scalar code, which == 1 is the vectorized one
+
+static void BenchVec3Transform(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		if( which == 0 )
+			D3DVec3Transform(data.results[0][i], data.vectors[i], data.matrices[i]);
+		else
+			GLVec3Transform(data.results[1][i], data.vectors[i], data.matrices[i]);
+	}
+}
+
+static void BenchVec3TransformCoord(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		if( which == 0 )
+			D3DVec3TransformCoord(data.results[0][i], data.vectors[i], data.matrices[i]);
+		else
+			GLVec3TransformCoord(data.results[1][i], data.vectors[i], data.matrices[i]);
+	}
+}
+
+static void BenchVec4Transform(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		if( which == 0 )
+			D3DVec4Transform(data.results[0][i], data.vectors[i], data.matrices[i]);
+		else
+			GLVec4Transform(data.results[1][i], data.vectors[i], data.matrices[i]);
+	}
+}
+
+static void BenchMatrixMultiply(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		const float* next = data.matrices[(i + 1) % NUM_ELEMENTS];
+
+		if( which == 0 )
+			D3DMatrixMultiply(data.results[0][i], data.matrices[i], next);
+		else
+			GLMatrixMultiply(data.results[1][i], data.matrices[i], next);
+	}
+}
+
+static void BenchMatrixTranspose(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		if( which == 0 )
+			D3DMatrixTranspose(data.results[0][i], data.matrices[i]);
+		else
+			GLMatrixTranspose(data.results[1][i], data.matrices[i]);
+	}
+}
+
+static void BenchQuaternionMultiply(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		float* next = data.vectors[(i + 1) % NUM_ELEMENTS];
+
+		if( which == 0 )
+			D3DQuaternionMultiply(data.results[0][i], data.vectors[i], next);
+		else
+			GLQuaternionMultiply(data.results[1][i], data.vectors[i], next);
+	}
+}
+
+// which == 0 is the C API, which == 1 is the value types
+
+static void BenchTypesVec3Mad(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		const float* a = data.vectors[i];
+		const float* b = data.vectors[(i + 1) % NUM_ELEMENTS];
+		const float* c = data.vectors[(i + 2) % NUM_ELEMENTS];
+
+		if( which == 0 )
+		{
+			float tmp[3];
+
+			GLVec3Mad(tmp, a, b, 0.5f);
+			GLVec3Subtract(data.results[0][i], tmp, c);
+		}
+		else
+			*((vec3*)data.results[1][i]) = vec3(a) + vec3(b) * 0.5f - vec3(c);
+	}
+}
+
+static void BenchTypesVec3Cross(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		const float* a = data.vectors[i];
+		const float* b = data.vectors[(i + 1) % NUM_ELEMENTS];
+
+		if( which == 0 )
+		{
+			GLVec3Cross(data.results[0][i], a, b);
+			GLVec3Normalize(data.results[0][i], data.results[0][i]);
+		}
+		else
+			*((vec3*)data.results[1][i]) = normalize(cross(vec3(a), vec3(b)));
+	}
+}
+
+static void BenchTypesVec4Lerp(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		const float* a = data.vectors[i];
+		const float* b = data.vectors[(i + 1) % NUM_ELEMENTS];
+
+		if( which == 0 )
+			GLVec4Lerp(data.results[0][i], a, b, 0.3f);
+		else
+			*((vec4*)data.results[1][i]) = lerp(vec4(a), vec4(b), 0.3f);
+	}
+}
+
+static void BenchTypesMatrixMultiply(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		const float* a = data.matrices[i];
+		const float* b = data.matrices[(i + 1) % NUM_ELEMENTS];
+		const float* c = data.matrices[(i + 2) % NUM_ELEMENTS];
+
+		if( which == 0 )
+		{
+			float tmp[16];
+
+			GLMatrixMultiply(tmp, a, b);
+			GLMatrixMultiply(data.results[0][i], tmp, c);
+		}
+		else
+			*((mat4*)data.results[1][i]) = mat4(a) * mat4(b) * mat4(c);
+	}
+}
+
+static void BenchTypesMatrixInverse(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		if( which == 0 )
+			GLMatrixInverse(data.results[0][i], data.matrices[i]);
+		else
+			*((mat4*)data.results[1][i]) = mat4(data.matrices[i]).Inverse();
+	}
+}
+
+static void BenchTypesQuaternionRotate(testdata& data, int which)
+{
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		float* q = data.vectors[(i + 1) % NUM_ELEMENTS];
+
+		if( which == 0 )
+			GLVec3Rotate(data.results[0][i], data.vectors[i], q);
+		else
+			*((vec3*)data.results[1][i]) = Rotate(vec3(data.vectors[i]), quat(q));
+	}
+}
+
+static bool Run(testdata& data, const char* name, benchfunc func, int numfloats)
+{
+	double best[2] = { 1e10, 1e10 };
+	double start;
+
+	memset(data.results, 0, sizeof(data.results));
+
+	// interleaved, so that clock changes hit both the same way
+	for( int pass = 0; pass < 5; ++pass )
+	{
+		for( int which = 0; which < 2; ++which )
+		{
+			start = GetTime();
+
+			for( int round = 0; round < NUM_ROUNDS; ++round )
+				func(data, which);
+
+			best[which] = std::min(best[which], GetTime() - start);
+		}
+	}
+
+	bool identical = true;
+
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		if( 0 != memcmp(data.results[0][i], data.results[1][i], numfloats * sizeof(float)) )
+			identical = false;
+	}
+
+	double scale = 1e9 / ((double)NUM_ELEMENTS * NUM_ROUNDS);
+
+	std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << best[0] * scale << " ns"
+		<< std::setw(10) << best[1] * scale << " ns"
+		<< std::setw(8) << best[0] / best[1] << "x"
+		<< (identical ? "" : "   MISMATCH") << "\n";
+
+	return identical;
+}
+
+static void* AlignedAlloc(size_t size)
+{
+#ifdef _WIN32
+	return _aligned_malloc(size, 32);
+#else
+	void* ptr = 0;
+	return (0 == posix_memalign(&ptr, 32, size) ? ptr : 0);
+#endif
+}
+
+static void AlignedFree(void* ptr)
+{
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+static bool RunStream(const float m[16])
+{
+	// packed xyz, SoA (x, y, z after each other) and a 32 byte vertex
+	float* input	= (float*)AlignedAlloc(NUM_VERTICES * 8 * sizeof(float));
+	float* output	= (float*)AlignedAlloc(NUM_VERTICES * 8 * sizeof(float));
+	float* expected	= (float*)AlignedAlloc(NUM_VERTICES * 8 * sizeof(float));
+	bool success = true;
+
+	for( size_t i = 0; i < NUM_VERTICES * 8; ++i )
+		input[i] = Random(-5, 5);
+
+	for( int test = 0; test < 6; ++test )
+	{
+		const char* name = 0;
+		double best[2] = { 1e10, 1e10 };
+		double start;
+		size_t instride = 12;
+		size_t outstride = 12;
+		size_t count = NUM_VERTICES;
+		int offset = 0;
+
+		switch( test )
+		{
+		case 0: name = "Vec3TransformArray";		break;
+		case 1: name = "Vec3TransformCoordArray";	break;
+		case 2: name = "  unaligned";				offset = 1; count -= 3;	break;
+		case 3: name = "  32 byte stride";			instride = 32;	break;
+		case 4: name = "  32 byte strides";			instride = outstride = 32;	break;
+		case 5: name = "Vec3TransformCoordSoA";		break;
+		}
+
+		const float* in = input + offset;
+
+		memset(output, 0, NUM_VERTICES * 8 * sizeof(float));
+		memset(expected, 0, NUM_VERTICES * 8 * sizeof(float));
+
+		for( int pass = 0; pass < 5; ++pass )
+		{
+			for( int which = 0; which < 2; ++which )
+			{
+				float* out = (which == 0 ? expected : output) + offset;
+
+				start = GetTime();
+
+				if( test == 0 )
+					(which == 0 ? &D3DVec3TransformArray : &GLVec3TransformArray)(out, outstride, in, instride, m, count);
+				else if( test < 5 )
+					(which == 0 ? &D3DVec3TransformCoordArray : &GLVec3TransformCoordArray)(out, outstride, in, instride, m, count);
+				else
+					(which == 0 ? &D3DVec3TransformCoordSoA : &GLVec3TransformCoordSoA)(
+						out, out + count, out + 2 * count, in, in + count, in + 2 * count, m, count);
+
+				best[which] = std::min(best[which], GetTime() - start);
+			}
+		}
+
+		// also checks that nothing is written between the interleaved outputs
+		bool identical = (0 == memcmp(expected, output, NUM_VERTICES * 8 * sizeof(float)));
+		double bytes = (double)count * (instride + outstride);
+
+		std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(10) << best[0] * 1e3 << " ms"
+			<< std::setw(10) << best[1] * 1e3 << " ms"
+			<< std::setw(8) << best[0] / best[1] << "x"
+			<< std::setw(8) << bytes / best[1] * 1e-9 << " GB/s"
+			<< (identical ? "" : "   MISMATCH") << "\n";
+
+		success &= identical;
+	}
+
+	AlignedFree(expected);
+	AlignedFree(output);
+	AlignedFree(input);
+
+	return success;
+}
+
+static bool RunCulling()
+{
+	OpenGLAABoxArray		boxes;
+	OpenGLAABox				box;
+	std::vector<uint32_t>	mask((NUM_BOXES + 31) / 32);
+	std::vector<uint32_t>	indices(NUM_BOXES);
+	std::vector<int>		expected(NUM_BOXES);
+	float					eye[3] = { 0, 10, 0 };
+	float					look[3] = { 100, 0, 100 };
+	float					up[3] = { 0, 1, 0 };
+	float					view[16], proj[16], viewproj[16];
+	float					planes[6][4];
+	double					best[3] = { 1e10, 1e10, 1e10 };
+	double					start;
+	size_t					numvisible[3] = { 0, 0, 0 };
+	bool					success = true;
+
+	// boxes scattered in a 1000 x 1000 area, the camera sees about a tenth of them
+	for( int i = 0; i < NUM_BOXES; ++i )
+	{
+		float size = Random(0.5f, 5);
+
+		box.Min[0] = Random(-500, 500);
+		box.Min[1] = Random(-10, 10);
+		box.Min[2] = Random(-500, 500);
+
+		GLVec3Set(box.Max, box.Min[0] + size, box.Min[1] + size, box.Min[2] + size);
+		boxes.Add(box);
+	}
+
+	GLMatrixLookAtRH(view, eye, look, up);
+	GLMatrixPerspectiveFovRH(proj, GL_PI / 3, 16.0f / 9.0f, 0.1f, 300.0f);
+	GLMatrixMultiply(viewproj, view, proj);
+	GLFrustumPlanes(planes, viewproj);
+
+	for( int pass = 0; pass < 10; ++pass )
+	{
+		start = GetTime();
+		numvisible[0] = 0;
+
+		for( int i = 0; i < NUM_BOXES; ++i )
+		{
+			boxes.Get(i, box);
+			expected[i] = (GLFrustumIntersect(planes, box) > 0);
+			numvisible[0] += expected[i];
+		}
+
+		best[0] = std::min(best[0], GetTime() - start);
+
+		start = GetTime();
+		numvisible[1] = GLFrustumCullMask(&mask[0], planes, boxes);
+		best[1] = std::min(best[1], GetTime() - start);
+
+		start = GetTime();
+		numvisible[2] = GLFrustumCullIndices(&indices[0], planes, boxes);
+		best[2] = std::min(best[2], GetTime() - start);
+	}
+
+	success = (numvisible[0] == numvisible[1] && numvisible[0] == numvisible[2]);
+
+	for( size_t i = 0, j = 0; i < NUM_BOXES; ++i )
+	{
+		if( expected[i] != (int)((mask[i / 32] >> (i % 32)) & 1) )
+			success = false;
+
+		if( expected[i] && (j >= numvisible[2] || indices[j++] != i) )
+			success = false;
+	}
+
+	for( int i = 1; i < 3; ++i )
+	{
+		std::cout << std::left << std::setw(24) << (i == 1 ? "FrustumCullMask" : "FrustumCullIndices")
+			<< std::right << std::fixed << std::setprecision(3)
+			<< std::setw(10) << best[0] * 1e3 << " ms"
+			<< std::setw(10) << best[i] * 1e3 << " ms"
+			<< std::setprecision(2) << std::setw(8) << best[0] / best[i] << "x"
+			<< (success ? "" : "   MISMATCH") << "\n";
+	}
+
+	std::cout << "(" << numvisible[0] << " visible)\n";
+	return success;
+}
+
+static void PrintConversion(const char* name, double loop, double bulk, bool identical)
+{
+	std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << loop * 1e3 << " ms"
+		<< std::setw(10) << bulk * 1e3 << " ms"
+		<< std::setw(8) << loop / bulk << "x"
+		<< (identical ? "" : "   MISMATCH") << "\n";
+}
+
+static bool RunConversions()
+{
+	std::vector<uint16_t>	halfs(NUM_TEXELS), halfs2(NUM_TEXELS);
+	std::vector<float>		floats(NUM_TEXELS), floats2(NUM_TEXELS);
+	std::vector<uint8_t>	bytes(NUM_TEXELS), bytes2(NUM_TEXELS);
+	double					start, loop, bulk;
+	bool					identical;
+	bool					success = true;
+
+	for( size_t i = 0; i < NUM_TEXELS; ++i )
+	{
+		floats[i] = Random(0, 2);
+		bytes[i] = (uint8_t)(rand() & 0xff);
+	}
+
+	// float -> half
+	start = GetTime();
+
+	for( size_t i = 0; i < NUM_TEXELS; ++i )
+		halfs[i] = GLFloatToHalf(floats[i]);
+
+	loop = GetTime() - start;
+	start = GetTime();
+
+	GLFloatToHalfArray(&halfs2[0], &floats[0], NUM_TEXELS);
+
+	bulk = GetTime() - start;
+	identical = (halfs == halfs2);
+
+	PrintConversion("FloatToHalfArray", loop, bulk, identical);
+	success &= identical;
+
+	// half -> float
+	start = GetTime();
+
+	for( size_t i = 0; i < NUM_TEXELS; ++i )
+		floats[i] = GLHalfToFloat(halfs[i]);
+
+	loop = GetTime() - start;
+	start = GetTime();
+
+	GLHalfToFloatArray(&floats2[0], &halfs[0], NUM_TEXELS);
+
+	bulk = GetTime() - start;
+	identical = (0 == memcmp(&floats[0], &floats2[0], NUM_TEXELS * sizeof(float)));
+
+	PrintConversion("HalfToFloatArray", loop, bulk, identical);
+	success &= identical;
+
+	// sRGB -> linear
+	start = GetTime();
+
+	for( size_t i = 0; i < NUM_TEXELS; ++i )
+		floats[i] = OpenGLColor::sRGBToLinear(bytes[i], 0, 0).r;
+
+	loop = GetTime() - start;
+	start = GetTime();
+
+	GLsRGBToLinearArray(&floats2[0], &bytes[0], NUM_TEXELS);
+
+	bulk = GetTime() - start;
+	identical = (0 == memcmp(&floats[0], &floats2[0], NUM_TEXELS * sizeof(float)));
+
+	PrintConversion("sRGBToLinearArray", loop, bulk, identical);
+	success &= identical;
+
+	// linear -> sRGB (there is no scalar version, compared with the formula)
+	start = GetTime();
+
+	for( size_t i = 0; i < NUM_TEXELS; ++i )
+	{
+		float f = std::min(std::max(floats[i], 0.0f), 1.0f);
+		float s = (f <= 0.0031308f ? f * 12.92f : 1.055f * powf(f, 1.0f / 2.4f) - 0.055f);
+
+		bytes2[i] = (uint8_t)(s * 255.0f + 0.5f);
+	}
+
+	loop = GetTime() - start;
+	start = GetTime();
+
+	GLLinearTosRGBArray(&bytes[0], &floats[0], NUM_TEXELS);
+
+	bulk = GetTime() - start;
+	identical = (bytes == bytes2);
+
+	PrintConversion("LinearTosRGBArray", loop, bulk, identical);
+	success &= identical;
+
+	// normals
+	size_t numnormals = NUM_TEXELS / 4;
+	uint32_t* packed = (uint32_t*)&halfs[0];
+	uint32_t* packed2 = (uint32_t*)&halfs2[0];
+
+	start = GetTime();
+
+	for( size_t i = 0; i < numnormals; ++i )
+		packed[i] = GLVec3ToUbyte4(&floats[i * 3]);
+
+	loop = GetTime() - start;
+	start = GetTime();
+
+	GLVec3ToUbyte4Array(packed2, sizeof(uint32_t), &floats[0], 3 * sizeof(float), numnormals);
+
+	bulk = GetTime() - start;
+	identical = (0 == memcmp(packed, packed2, numnormals * sizeof(uint32_t)));
+
+	PrintConversion("Vec3ToUbyte4Array", loop, bulk, identical);
+	success &= identical;
+
+	start = GetTime();
+
+	for( size_t i = 0; i < numnormals; ++i )
+		GLUbyte4ToVec3(&floats[i * 3], packed[i]);
+
+	loop = GetTime() - start;
+	start = GetTime();
+
+	GLUbyte4ToVec3Array(&floats2[0], 3 * sizeof(float), packed, sizeof(uint32_t), numnormals);
+
+	bulk = GetTime() - start;
+	identical = (0 == memcmp(&floats[0], &floats2[0], numnormals * 3 * sizeof(float)));
+
+	PrintConversion("Ubyte4ToVec3Array", loop, bulk, identical);
+	success &= identical;
+
+	return success;
+}
+
+// the CPU version of the compute shader FFT in 56_Ocean/fft_test.cpp
+static void ReferenceFFT(Complex* data, Complex* tmp, int n)
+{
+	int log2_n = GLLog2OfPow2(n);
+	Complex* src = tmp;
+	Complex* dst = data;
+
+	for( int j = 0; j < n; ++j )
+	{
+		int nj = (GLReverseBits32(j) >> (32 - log2_n)) & (n - 1);
+		src[nj] = data[j];
+	}
+
+	for( int s = 1; s <= log2_n; ++s )
+	{
+		int m = 1 << s;
+		int mh = m >> 1;
+
+		for( int l = 0; l < n; ++l )
+		{
+			int k = (l * (n / m)) & (n - 1);
+			int i = (l & ~(m - 1));
+			int j = (l & (mh - 1));
+
+			float theta = (GL_2PI * k) / (float)n;
+			Complex W_N_k(cosf(theta), -sinf(theta));
+
+			Complex t = W_N_k * src[i + j + mh];
+			Complex u = src[i + j];
+
+			dst[l] = u + t;
+		}
+
+		std::swap(src, dst);
+	}
+
+	if( src != data )
+		memcpy(data, src, n * sizeof(Complex));
+}
+
+static void ReferenceFFT2D(Complex* data, int width, int height)
+{
+	std::vector<Complex> column(height), tmp(std::max(width, height));
+
+	for( int i = 0; i < height; ++i )
+		ReferenceFFT(data + i * width, &tmp[0], width);
+
+	for( int j = 0; j < width; ++j )
+	{
+		for( int i = 0; i < height; ++i )
+			column[i] = data[i * width + j];
+
+		ReferenceFFT(&column[0], &tmp[0], height);
+
+		for( int i = 0; i < height; ++i )
+			data[i * width + j] = column[i];
+	}
+}
+
+// relative to the largest element
+static float MaxError(const Complex* a, const Complex* b, size_t count)
+{
+	float error = 0;
+	float largest = 0;
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		error = std::max(error, std::max(fabsf(a[i].a - b[i].a), fabsf(a[i].b - b[i].b)));
+		largest = std::max(largest, std::max(fabsf(a[i].a), fabsf(a[i].b)));
+	}
+
+	return error / largest;
+}
+
+static float MaxError(const float* a, const float* b, size_t count)
+{
+	float error = 0;
+	float largest = 0;
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		error = std::max(error, fabsf(a[i] - b[i]));
+		largest = std::max(largest, fabsf(a[i]));
+	}
+
+	return error / largest;
+}
+
+// the inverse transforms are not scaled
+static void Normalize(Complex* data, size_t count)
+{
+	float scale = 1.0f / count;
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		data[i].a *= scale;
+		data[i].b *= scale;
+	}
+}
+
+static void Normalize(float* data, size_t count)
+{
+	float scale = 1.0f / count;
+
+	for( size_t i = 0; i < count; ++i )
+		data[i] *= scale;
+}
+
+static void PrintFFT(const char* name, double reference, double time, float error, bool micro)
+{
+	double scale = (micro ? 1e6 : 1e3);
+	const char* unit = (micro ? " us" : " ms");
+
+	std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << reference * scale << unit
+		<< std::setw(10) << time * scale << unit
+		<< std::setw(8) << reference / time << "x"
+		<< std::setw(12) << std::scientific << std::setprecision(1) << error << std::fixed
+		<< (error < FFT_TOLERANCE ? "" : "   MISMATCH") << "\n";
+}
+
+// Inverse(Forward(x)) / N against x, nothing to time
+static void PrintRoundTrip(float error)
+{
+	std::cout << std::left << std::setw(24) << "  round trip" << std::right << std::setw(35) << ""
+		<< std::setw(12) << std::scientific << std::setprecision(1) << error << std::fixed
+		<< (error < FFT_TOLERANCE ? "" : "   MISMATCH") << "\n";
+}
+
+static bool RunFFT()
+{
+	const int sizes1D[] = { 256, 1024, 4096 };
+	const int sizes2D[] = { 512, 1024, 2048 };
+
+	char		name[64];
+	double		start, reference, time;
+	float		error;
+	bool		success = true;
+	int			numthreads = 0;
+
+	for( int i = 0; i < 3; ++i )
+	{
+		int n = sizes1D[i];
+		int repeat = (1 << 22) / n;
+		FFT fft;
+
+		std::vector<Complex>	input(n), expected(n), actual(n), tmp(n);
+		std::vector<float>		work;
+
+		fft.Initialize(n);
+		work.resize(fft.WorkSize());
+
+		for( int j = 0; j < n; ++j )
+			input[j] = Complex(Random(-1, 1), Random(-1, 1));
+
+		start = GetTime();
+
+		for( int j = 0; j < repeat; ++j )
+		{
+			expected = input;
+			ReferenceFFT(&expected[0], &tmp[0], n);
+		}
+
+		reference = (GetTime() - start) / repeat;
+		start = GetTime();
+
+		for( int j = 0; j < repeat; ++j )
+		{
+			actual = input;
+			fft.Forward(&actual[0], &work[0]);
+		}
+
+		time = (GetTime() - start) / repeat;
+		error = MaxError(&expected[0], &actual[0], n);
+
+		sprintf(name, "FFT %d", n);
+		PrintFFT(name, reference, time, error, true);
+
+		success &= (error < FFT_TOLERANCE);
+
+		fft.Inverse(&actual[0], &work[0]);
+		Normalize(&actual[0], n);
+
+		error = MaxError(&input[0], &actual[0], n);
+
+		PrintRoundTrip(error);
+
+		success &= (error < FFT_TOLERANCE);
+	}
+
+	// against the complex FFT of the same values
+	for( int i = 0; i < 3; ++i )
+	{
+		int n = sizes1D[i];
+		int repeat = (1 << 22) / n;
+		FFT fft;
+		RealFFT rfft;
+
+		std::vector<float>		input(n), output(n);
+		std::vector<Complex>	expected(n), actual(n / 2 + 1);
+		std::vector<float>		work, rwork;
+
+		fft.Initialize(n);
+		rfft.Initialize(n);
+
+		work.resize(fft.WorkSize());
+		rwork.resize(rfft.WorkSize());
+
+		for( int j = 0; j < n; ++j )
+			input[j] = Random(-1, 1);
+
+		start = GetTime();
+
+		for( int j = 0; j < repeat; ++j )
+		{
+			for( int k = 0; k < n; ++k )
+				expected[k] = Complex(input[k], 0);
+
+			fft.Forward(&expected[0], &work[0]);
+		}
+
+		reference = (GetTime() - start) / repeat;
+		start = GetTime();
+
+		for( int j = 0; j < repeat; ++j )
+			rfft.Forward(&actual[0], &input[0], &rwork[0]);
+
+		time = (GetTime() - start) / repeat;
+		error = MaxError(&expected[0], &actual[0], n / 2 + 1);
+
+		sprintf(name, "RealFFT %d", n);
+		PrintFFT(name, reference, time, error, true);
+
+		success &= (error < FFT_TOLERANCE);
+
+		rfft.Inverse(&output[0], &actual[0], &rwork[0]);
+		Normalize(&output[0], n);
+
+		error = MaxError(&input[0], &output[0], n);
+
+		PrintRoundTrip(error);
+
+		success &= (error < FFT_TOLERANCE);
+	}
+
+	for( int i = 0; i < 3; ++i )
+	{
+		int n = sizes2D[i];
+		size_t count = (size_t)n * n;
+		FFT2D single, multi;
+
+		std::vector<Complex> input(count), expected, actual;
+
+		single.Initialize(n, n, 1);
+		multi.Initialize(n, n, 0);
+
+		numthreads = multi.NumThreads();
+
+		for( size_t j = 0; j < count; ++j )
+			input[j] = Complex(Random(-1, 1), Random(-1, 1));
+
+		// the first call allocates
+		actual = input;
+
+		single.Forward(&actual[0]);
+		multi.Forward(&actual[0]);
+
+		expected = input;
+
+		start = GetTime();
+		ReferenceFFT2D(&expected[0], n, n);
+		reference = GetTime() - start;
+
+		actual = input;
+
+		start = GetTime();
+		single.Forward(&actual[0]);
+		time = GetTime() - start;
+
+		error = MaxError(&expected[0], &actual[0], count);
+
+		sprintf(name, "FFT2D %dx%d", n, n);
+		PrintFFT(name, reference, time, error, false);
+
+		success &= (error < FFT_TOLERANCE);
+
+		actual = input;
+
+		start = GetTime();
+		multi.Forward(&actual[0]);
+		time = GetTime() - start;
+
+		error = MaxError(&expected[0], &actual[0], count);
+
+		sprintf(name, "FFT2D %dx%d (MT)", n, n);
+		PrintFFT(name, reference, time, error, false);
+
+		success &= (error < FFT_TOLERANCE);
+
+		multi.Inverse(&actual[0]);
+		Normalize(&actual[0], count);
+
+		error = MaxError(&input[0], &actual[0], count);
+
+		PrintRoundTrip(error);
+
+		success &= (error < FFT_TOLERANCE);
+	}
+
+	std::cout << "\n(MT) uses " << numthreads << " threads\n";
+	return success;
+}
+
+int main()
+{
+	testdata* data = new testdata();
+	bool success = true;
+
+	srand(12345);
+
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		float axis[3] = { Random(-1, 1), Random(-1, 1), Random(0.1f, 1) };
+		float rotation[16];
+		float translation[16];
+
+		GLVec3Normalize(axis, axis);
+		GLMatrixRotationAxis(rotation, Random(0, GL_2PI), axis[0], axis[1], axis[2]);
+		GLMatrixTranslation(translation, Random(-10, 10), Random(-10, 10), Random(-10, 10));
+
+		// some perspective too, so that the w divide is not always by 1
+		GLMatrixMultiply(data->matrices[i], rotation, translation);
+
+		data->matrices[i][3] = Random(-0.1f, 0.1f);
+		data->matrices[i][7] = Random(-0.1f, 0.1f);
+
+		for( int j = 0; j < 4; ++j )
+			data->vectors[i][j] = Random(-5, 5);
+	}
+
+	std::cout << std::left << std::setw(24) << "function" << std::right
+		<< std::setw(13) << "scalar" << std::setw(13) << "simd" << std::setw(9) << "speedup" << "\n\n";
+
+	success &= Run(*data, "Vec3Transform", &BenchVec3Transform, 3);
+	success &= Run(*data, "Vec3TransformCoord", &BenchVec3TransformCoord, 3);
+	success &= Run(*data, "Vec4Transform", &BenchVec4Transform, 4);
+	success &= Run(*data, "MatrixMultiply", &BenchMatrixMultiply, 16);
+	success &= Run(*data, "MatrixTranspose", &BenchMatrixTranspose, 16);
+	success &= Run(*data, "QuaternionMultiply", &BenchQuaternionMultiply, 4);
+
+	// out is allowed to be the same as a
+	for( int i = 0; i < NUM_ELEMENTS; ++i )
+	{
+		float expected[16];
+		float actual[16];
+
+		memcpy(actual, data->matrices[i], sizeof(actual));
+
+		D3DMatrixMultiply(expected, actual, data->matrices[0]);
+		GLMatrixMultiply(actual, actual, data->matrices[0]);
+		success &= (0 == memcmp(expected, actual, sizeof(actual)));
+	}
+
+	std::cout << "\n" << std::left << std::setw(24) << "value types" << std::right
+		<< std::setw(13) << "C API" << std::setw(13) << "types" << "\n\n";
+
+	success &= Run(*data, "a + b * s - c", &BenchTypesVec3Mad, 3);
+	success &= Run(*data, "normalize(cross(a, b))", &BenchTypesVec3Cross, 3);
+	success &= Run(*data, "lerp(a, b, s)", &BenchTypesVec4Lerp, 4);
+	success &= Run(*data, "A * B * C", &BenchTypesMatrixMultiply, 16);
+	success &= Run(*data, "A.Inverse()", &BenchTypesMatrixInverse, 16);
+	success &= Run(*data, "Rotate(v, q)", &BenchTypesQuaternionRotate, 3);
+
+	std::cout << "\n" << NUM_VERTICES << " vertices:\n\n";
+	success &= RunStream(data->matrices[1]);
+
+	std::cout << "\n" << NUM_BOXES << " boxes:\n\n";
+	success &= RunCulling();
+
+	std::cout << "\n" << NUM_TEXELS << " texels (4K RGBA):\n\n";
+	success &= RunConversions();
+
+	std::cout << "\n" << std::left << std::setw(24) << "fft" << std::right
+		<< std::setw(13) << "reference" << std::setw(13) << "new" << std::setw(9) << "speedup" << std::setw(12) << "error" << "\n\n";
+
+	success &= RunFFT();
+
+	std::cout << "\n" << (success ? "All results match" : "The results differ") << "\n";
+
+	delete data;
+	return (success ? 0 : 1);
+}
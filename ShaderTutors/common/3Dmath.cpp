@@ -2,6 +2,25 @@
 #include "3Dmath.h"
 #include <cstring>
 
+// SSE2 is there on every x86 CPU the samples run on, AVX only if the compiler targets it;
+// the vectorized functions do the same operations in the same order (no FMA), so the results are
+// identical to the scalar code as long as that doesn't use the x87 (x64 or /arch:SSE2)
+#if !defined(MATH_NO_SIMD) && (defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__))
+#	define MATH_USE_SSE
+#	include <emmintrin.h>
+
+#	ifdef __AVX__
+#		define MATH_USE_AVX
+#		include <immintrin.h>
+#	endif
+
+// GCC and Clang enable F16C separately, MSVC only has __AVX2__ (which implies it)
+#	if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#		define MATH_USE_F16C
+#		include <immintrin.h>
+#	endif
+#endif
+
 // *****************************************************************************************************************************
 //
 // Color impl
@@ -301,6 +320,67 @@ float CLASS_PROTO(AABox)::Farthest(float from[4]) const
 	return dist;
 }
 
+// *****************************************************************************************************************************
+//
+// AABoxArray impl
+//
+// *****************************************************************************************************************************
+
+void CLASS_PROTO(AABoxArray)::Add(const CLASS_PROTO(AABox)& box)
+{
+	MinX.push_back(box.Min[0]);
+	MinY.push_back(box.Min[1]);
+	MinZ.push_back(box.Min[2]);
+
+	MaxX.push_back(box.Max[0]);
+	MaxY.push_back(box.Max[1]);
+	MaxZ.push_back(box.Max[2]);
+}
+
+void CLASS_PROTO(AABoxArray)::Set(size_t index, const CLASS_PROTO(AABox)& box)
+{
+	MinX[index] = box.Min[0];
+	MinY[index] = box.Min[1];
+	MinZ[index] = box.Min[2];
+
+	MaxX[index] = box.Max[0];
+	MaxY[index] = box.Max[1];
+	MaxZ[index] = box.Max[2];
+}
+
+void CLASS_PROTO(AABoxArray)::Get(size_t index, CLASS_PROTO(AABox)& outbox) const
+{
+	outbox.Min[0] = MinX[index];
+	outbox.Min[1] = MinY[index];
+	outbox.Min[2] = MinZ[index];
+
+	outbox.Max[0] = MaxX[index];
+	outbox.Max[1] = MaxY[index];
+	outbox.Max[2] = MaxZ[index];
+}
+
+void CLASS_PROTO(AABoxArray)::Reserve(size_t count)
+{
+	MinX.reserve(count);
+	MinY.reserve(count);
+	MinZ.reserve(count);
+
+	MaxX.reserve(count);
+	MaxY.reserve(count);
+	MaxZ.reserve(count);
+}
+
+void CLASS_PROTO(AABoxArray)::Clear()
+{
+	MinX.clear();
+	MinY.clear();
+	MinZ.clear();
+
+	MaxX.clear();
+	MaxY.clear();
+	MaxZ.clear();
+}
+
 // *****************************************************************************************************************************
 //
 // Math functions impl
@@ -507,6 +587,17 @@ void FUNC_PROTO(Vec3Rotate)(float out[3], float v[3], float q[4])
 
 void FUNC_PROTO(Vec3Transform)(float out[3], const float v[3], const float m[16])
 {
+#ifdef MATH_USE_SSE
+	__m128 tmp;
+
+	tmp = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(m));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(m + 4)));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(m + 8)));
+
+	// out has only 3 elements
+	_mm_storel_pi((__m64*)out, tmp);
+	_mm_store_ss(out + 2, _mm_movehl_ps(tmp, tmp));
+#else
 	float tmp[3];
 
 	tmp[0] = v[0] * m[0] + v[1] * m[4] + v[2] * m[8];
@@ -516,6 +607,7 @@ void FUNC_PROTO(Vec3Transform)(float out[3], const float v[3], const float m[16]
 	out[0] = tmp[0];
 	out[1] = tmp[1];
 	out[2] = tmp[2];
+#endif
 }
 
 void FUNC_PROTO(Vec3TransformTranspose)(float out[3], const float m[16], const float v[3])
@@ -533,6 +625,18 @@ void FUNC_PROTO(Vec3TransformTranspose)(float out[3], const float m[16], const f
 
 void FUNC_PROTO(Vec3TransformCoord)(float out[3], const float v[3], const float m[16])
 {
+#ifdef MATH_USE_SSE
+	__m128 tmp;
+
+	tmp = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(m));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(m + 4)));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(m + 8)));
+	tmp = _mm_add_ps(tmp, _mm_loadu_ps(m + 12));
+	tmp = _mm_div_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(3, 3, 3, 3)));
+
+	_mm_storel_pi((__m64*)out, tmp);
+	_mm_store_ss(out + 2, _mm_movehl_ps(tmp, tmp));
+#else
 	float tmp[4];
 
 	tmp[0] = v[0] * m[0] + v[1] * m[4] + v[2] * m[8] + m[12];
@@ -543,6 +647,7 @@ void FUNC_PROTO(Vec3TransformCoord)(float out[3], const float v[3], const float
 	out[0] = tmp[0] / tmp[3];
 	out[1] = tmp[1] / tmp[3];
 	out[2] = tmp[2] / tmp[3];
+#endif
 }
 
 void FUNC_PROTO(Vec3TransformCoordTranspose)(float out[3], const float m[16], const float v[3])
@@ -559,6 +664,286 @@ void FUNC_PROTO(Vec3TransformCoordTranspose)(float out[3], const float m[16], co
 	out[2] = tmp[2] / tmp[3];
 }
 
+// outputs larger than this (in bytes) are written with non-temporal stores, they wouldn't stay in the cache anyway
+#define STREAMING_THRESHOLD		(512 * 1024)
+
+#ifdef MATH_USE_SSE
+static inline void TransformSoA(__m128& x, __m128& y, __m128& z, const __m128 mm[16], bool coord)
+{
+	__m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, mm[0]), _mm_mul_ps(y, mm[4])), _mm_mul_ps(z, mm[8]));
+	__m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, mm[1]), _mm_mul_ps(y, mm[5])), _mm_mul_ps(z, mm[9]));
+	__m128 tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, mm[2]), _mm_mul_ps(y, mm[6])), _mm_mul_ps(z, mm[10]));
+
+	if( coord )
+	{
+		__m128 tw = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, mm[3]), _mm_mul_ps(y, mm[7])), _mm_mul_ps(z, mm[11])), mm[15]);
+
+		tx = _mm_div_ps(_mm_add_ps(tx, mm[12]), tw);
+		ty = _mm_div_ps(_mm_add_ps(ty, mm[13]), tw);
+		tz = _mm_div_ps(_mm_add_ps(tz, mm[14]), tw);
+	}
+
+	x = tx;
+	y = ty;
+	z = tz;
+}
+
+template <bool coord, bool aligned, bool streaming>
+static void TransformPacked(float* out, const float* in, const __m128 mm[16], size_t count)
+{
+	__m128 a, b, c, t, u;
+	__m128 x, y, z;
+
+	// 4 points (48 bytes) per iteration
+	for( size_t i = 0; i < count; i += 4, in += 12, out += 12 )
+	{
+		a = (aligned ? _mm_load_ps(in) : _mm_loadu_ps(in));
+		b = (aligned ? _mm_load_ps(in + 4) : _mm_loadu_ps(in + 4));
+		c = (aligned ? _mm_load_ps(in + 8) : _mm_loadu_ps(in + 8));
+
+		// (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) -> (x0 x1 x2 x3) (y0 y1 y2 y3) (z0 z1 z2 z3)
+		t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+		x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+
+		t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+		u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+		y = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+		t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+		z = _mm_shuffle_ps(t, c, _MM_SHUFFLE(3, 0, 2, 0));
+
+		TransformSoA(x, y, z, mm, coord);
+
+		// and back
+		t = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0));
+		u = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+		a = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+		t = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+		u = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+		b = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+		t = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+		u = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+		c = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 2, 0));
+
+		if( streaming )
+		{
+			_mm_stream_ps(out, a);
+			_mm_stream_ps(out + 4, b);
+			_mm_stream_ps(out + 8, c);
+		}
+		else if( aligned )
+		{
+			_mm_store_ps(out, a);
+			_mm_store_ps(out + 4, b);
+			_mm_store_ps(out + 8, c);
+		}
+		else
+		{
+			_mm_storeu_ps(out, a);
+			_mm_storeu_ps(out + 4, b);
+			_mm_storeu_ps(out + 8, c);
+		}
+	}
+}
+
+template <bool aligned, bool streaming>
+static void TransformSeparate(float* outx, float* outy, float* outz, const float* inx, const float* iny, const float* inz, const float m[16], size_t count)
+{
+#ifdef MATH_USE_AVX
+	__m256 mm[16];
+	__m256 x, y, z, w;
+
+	for( int i = 0; i < 16; ++i )
+		mm[i] = _mm256_set1_ps(m[i]);
+
+	for( size_t i = 0; i < count; i += 8 )
+	{
+		x = (aligned ? _mm256_load_ps(inx + i) : _mm256_loadu_ps(inx + i));
+		y = (aligned ? _mm256_load_ps(iny + i) : _mm256_loadu_ps(iny + i));
+		z = (aligned ? _mm256_load_ps(inz + i) : _mm256_loadu_ps(inz + i));
+
+		w = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, mm[3]), _mm256_mul_ps(y, mm[7])), _mm256_mul_ps(z, mm[11])), mm[15]);
+
+		__m256 tx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, mm[0]), _mm256_mul_ps(y, mm[4])), _mm256_mul_ps(z, mm[8])), mm[12]);
+		__m256 ty = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, mm[1]), _mm256_mul_ps(y, mm[5])), _mm256_mul_ps(z, mm[9])), mm[13]);
+		__m256 tz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, mm[2]), _mm256_mul_ps(y, mm[6])), _mm256_mul_ps(z, mm[10])), mm[14]);
+
+		tx = _mm256_div_ps(tx, w);
+		ty = _mm256_div_ps(ty, w);
+		tz = _mm256_div_ps(tz, w);
+
+		if( streaming )
+		{
+			_mm256_stream_ps(outx + i, tx);
+			_mm256_stream_ps(outy + i, ty);
+			_mm256_stream_ps(outz + i, tz);
+		}
+		else if( aligned )
+		{
+			_mm256_store_ps(outx + i, tx);
+			_mm256_store_ps(outy + i, ty);
+			_mm256_store_ps(outz + i, tz);
+		}
+		else
+		{
+			_mm256_storeu_ps(outx + i, tx);
+			_mm256_storeu_ps(outy + i, ty);
+			_mm256_storeu_ps(outz + i, tz);
+		}
+	}
+#else
+	__m128 mm[16];
+	__m128 x, y, z;
+
+	for( int i = 0; i < 16; ++i )
+		mm[i] = _mm_set1_ps(m[i]);
+
+	for( size_t i = 0; i < count; i += 4 )
+	{
+		x = (aligned ? _mm_load_ps(inx + i) : _mm_loadu_ps(inx + i));
+		y = (aligned ? _mm_load_ps(iny + i) : _mm_loadu_ps(iny + i));
+		z = (aligned ? _mm_load_ps(inz + i) : _mm_loadu_ps(inz + i));
+
+		TransformSoA(x, y, z, mm, true);
+
+		if( streaming )
+		{
+			_mm_stream_ps(outx + i, x);
+			_mm_stream_ps(outy + i, y);
+			_mm_stream_ps(outz + i, z);
+		}
+		else if( aligned )
+		{
+			_mm_store_ps(outx + i, x);
+			_mm_store_ps(outy + i, y);
+			_mm_store_ps(outz + i, z);
+		}
+		else
+		{
+			_mm_storeu_ps(outx + i, x);
+			_mm_storeu_ps(outy + i, y);
+			_mm_storeu_ps(outz + i, z);
+		}
+	}
+#endif
+}
+
+static inline bool IsAligned(const void* ptr, size_t alignment)
+{
+	return ((size_t)ptr % alignment == 0);
+}
+
+typedef void (*packedtransform)(float*, const float*, const __m128*, size_t);
+
+static void TransformArray(float* out, size_t outstride, const float* in, size_t instride, const float m[16], size_t count, bool coord)
+{
+	size_t i = 0;
+
+	if( outstride == 3 * sizeof(float) && instride == 3 * sizeof(float) && count >= 4 )
+	{
+		packedtransform func;
+		size_t packed = count & ~(size_t)3;
+		bool streaming = false;
+		__m128 mm[16];
+
+		for( int j = 0; j < 16; ++j )
+			mm[j] = _mm_set1_ps(m[j]);
+
+		if( !IsAligned(out, 16) || !IsAligned(in, 16) )
+			func = (coord ? &TransformPacked<true, false, false> : &TransformPacked<false, false, false>);
+		else if( packed * outstride < STREAMING_THRESHOLD )
+			func = (coord ? &TransformPacked<true, true, false> : &TransformPacked<false, true, false>);
+		else
+		{
+			func = (coord ? &TransformPacked<true, true, true> : &TransformPacked<false, true, true>);
+			streaming = true;
+		}
+
+		func(out, in, mm, packed);
+
+		if( streaming )
+			_mm_sfence();
+
+		i = packed;
+	}
+
+	// interleaved vertices (or the remainder)
+	for( ; i < count; ++i )
+	{
+		const float* v = (const float*)((const char*)in + i * instride);
+		float* o = (float*)((char*)out + i * outstride);
+
+		if( coord )
+			FUNC_PROTO(Vec3TransformCoord)(o, v, m);
+		else
+			FUNC_PROTO(Vec3Transform)(o, v, m);
+	}
+}
+#endif
+
+void FUNC_PROTO(Vec3TransformArray)(float* out, size_t outstride, const float* in, size_t instride, const float m[16], size_t count)
+{
+#ifdef MATH_USE_SSE
+	TransformArray(out, outstride, in, instride, m, count, false);
+#else
+	for( size_t i = 0; i < count; ++i )
+		FUNC_PROTO(Vec3Transform)((float*)((char*)out + i * outstride), (const float*)((const char*)in + i * instride), m);
+#endif
+}
+
+void FUNC_PROTO(Vec3TransformCoordArray)(float* out, size_t outstride, const float* in, size_t instride, const float m[16], size_t count)
+{
+#ifdef MATH_USE_SSE
+	TransformArray(out, outstride, in, instride, m, count, true);
+#else
+	for( size_t i = 0; i < count; ++i )
+		FUNC_PROTO(Vec3TransformCoord)((float*)((char*)out + i * outstride), (const float*)((const char*)in + i * instride), m);
+#endif
+}
+
+void FUNC_PROTO(Vec3TransformCoordSoA)(float* outx, float* outy, float* outz, const float* x, const float* y, const float* z, const float m[16], size_t count)
+{
+	size_t i = 0;
+
+#ifdef MATH_USE_SSE
+#	ifdef MATH_USE_AVX
+	const size_t width = 8;
+#	else
+	const size_t width = 4;
+#	endif
+
+	size_t vectorized = count & ~(width - 1);
+	bool aligned = (
+		IsAligned(outx, width * sizeof(float)) && IsAligned(outy, width * sizeof(float)) && IsAligned(outz, width * sizeof(float)) &&
+		IsAligned(x, width * sizeof(float)) && IsAligned(y, width * sizeof(float)) && IsAligned(z, width * sizeof(float)));
+
+	if( !aligned )
+		TransformSeparate<false, false>(outx, outy, outz, x, y, z, m, vectorized);
+	else if( vectorized * 3 * sizeof(float) < STREAMING_THRESHOLD )
+		TransformSeparate<true, false>(outx, outy, outz, x, y, z, m, vectorized);
+	else
+	{
+		TransformSeparate<true, true>(outx, outy, outz, x, y, z, m, vectorized);
+		_mm_sfence();
+	}
+
+	i = vectorized;
+#endif
+
+	for( ; i < count; ++i )
+	{
+		float v[3] = { x[i], y[i], z[i] };
+
+		FUNC_PROTO(Vec3TransformCoord)(v, v, m);
+
+		outx[i] = v[0];
+		outy[i] = v[1];
+		outz[i] = v[2];
+	}
+}
+
 void FUNC_PROTO(Vec4Assign)(float out[4], const float a[4])
 {
 	out[0] = a[0];
@@ -611,6 +996,16 @@ void FUNC_PROTO(Vec4Scale)(float out[4], const float a[4], float scale)
 
 void FUNC_PROTO(Vec4Transform)(float out[4], const float v[4], const float m[16])
 {
+#ifdef MATH_USE_SSE
+	__m128 tmp;
+
+	tmp = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(m));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(m + 4)));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(m + 8)));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_set1_ps(v[3]), _mm_loadu_ps(m + 12)));
+
+	_mm_storeu_ps(out, tmp);
+#else
 	float tmp[4];
 
 	tmp[0] = v[0] * m[0] + v[1] * m[4] + v[2] * m[8] + v[3] * m[12];
@@ -622,6 +1017,7 @@ void FUNC_PROTO(Vec4Transform)(float out[4], const float v[4], const float m[16]
 	out[1] = tmp[1];
 	out[2] = tmp[2];
 	out[3] = tmp[3];
+#endif
 }
 
 void FUNC_PROTO(Vec4TransformTranspose)(float out[4], const float m[16], const float v[4])
@@ -862,6 +1258,61 @@ void FUNC_PROTO(MatrixOrthoRH)(float out[16], float left, float right, float bot
 
 void FUNC_PROTO(MatrixMultiply)(float out[16], const float a[16], const float b[16])
 {
+#if defined(MATH_USE_AVX)
+	// two rows of the result at once
+	__m256 b0 = _mm256_broadcast_ps((const __m128*)b);
+	__m256 b1 = _mm256_broadcast_ps((const __m128*)(b + 4));
+	__m256 b2 = _mm256_broadcast_ps((const __m128*)(b + 8));
+	__m256 b3 = _mm256_broadcast_ps((const __m128*)(b + 12));
+
+	__m256 a01 = _mm256_loadu_ps(a);
+	__m256 a23 = _mm256_loadu_ps(a + 8);
+	__m256 r01, r23;
+
+	r01 = _mm256_mul_ps(_mm256_permute_ps(a01, 0x00), b0);
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, 0x55), b1));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, 0xaa), b2));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, 0xff), b3));
+
+	r23 = _mm256_mul_ps(_mm256_permute_ps(a23, 0x00), b0);
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, 0x55), b1));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, 0xaa), b2));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, 0xff), b3));
+
+	_mm256_storeu_ps(out, r01);
+	_mm256_storeu_ps(out + 8, r23);
+#elif defined(MATH_USE_SSE)
+	__m128 b0 = _mm_loadu_ps(b);
+	__m128 b1 = _mm_loadu_ps(b + 4);
+	__m128 b2 = _mm_loadu_ps(b + 8);
+	__m128 b3 = _mm_loadu_ps(b + 12);
+	__m128 r0 = _mm_loadu_ps(a);
+	__m128 r1 = _mm_loadu_ps(a + 4);
+	__m128 r2 = _mm_loadu_ps(a + 8);
+	__m128 r3 = _mm_loadu_ps(a + 12);
+
+#define MULTIPLY_ROW(r) \
+	r = _mm_add_ps( \
+		_mm_add_ps( \
+			_mm_add_ps( \
+				_mm_mul_ps(_mm_shuffle_ps(r, r, 0x00), b0), \
+				_mm_mul_ps(_mm_shuffle_ps(r, r, 0x55), b1)), \
+			_mm_mul_ps(_mm_shuffle_ps(r, r, 0xaa), b2)), \
+		_mm_mul_ps(_mm_shuffle_ps(r, r, 0xff), b3));
+// END
+
+	MULTIPLY_ROW(r0);
+	MULTIPLY_ROW(r1);
+	MULTIPLY_ROW(r2);
+	MULTIPLY_ROW(r3);
+
+#undef MULTIPLY_ROW
+
+	_mm_storeu_ps(out, r0);
+	_mm_storeu_ps(out + 4, r1);
+	_mm_storeu_ps(out + 8, r2);
+	_mm_storeu_ps(out + 12, r3);
+#else
 	float tmp[16];
 
 	tmp[0] = a[0] * b[0] + a[1] * b[4] + a[2] * b[8] + a[3] * b[12];
@@ -885,6 +1336,7 @@ void FUNC_PROTO(MatrixMultiply)(float out[16], const float a[16], const float b[
 	tmp[15] = a[12] * b[3] + a[13] * b[7] + a[14] * b[11] + a[15] * b[15];
 
 	memcpy(out, tmp, 16 * sizeof(float));
+#endif
 }
 
 void FUNC_PROTO(MatrixTranslation)(float out[16], float x, float y, float z)
@@ -898,6 +1350,19 @@ void FUNC_PROTO(MatrixTranslation)(float out[16], float x, float y, float z)
 
 void FUNC_PROTO(MatrixTranspose)(float out[16], float m[16])
 {
+#ifdef MATH_USE_SSE
+	__m128 r0 = _mm_loadu_ps(m);
+	__m128 r1 = _mm_loadu_ps(m + 4);
+	__m128 r2 = _mm_loadu_ps(m + 8);
+	__m128 r3 = _mm_loadu_ps(m + 12);
+
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	_mm_storeu_ps(out, r0);
+	_mm_storeu_ps(out + 4, r1);
+	_mm_storeu_ps(out + 8, r2);
+	_mm_storeu_ps(out + 12, r3);
+#else
 	out[0] = m[0];
 	out[1] = m[4];
 	out[2] = m[8];
@@ -917,6 +1382,7 @@ void FUNC_PROTO(MatrixTranspose)(float out[16], float m[16])
 	out[13] = m[7];
 	out[14] = m[11];
 	out[15] = m[15];
+#endif
 }
 
 void FUNC_PROTO(MatrixScaling)(float out[16], float x, float y, float z)
@@ -1076,6 +1542,21 @@ void FUNC_PROTO(QuaternionIdentity)(float out[4])
 
 void FUNC_PROTO(QuaternionMultiply)(float out[4], float a[4], float b[4])
 {
+#ifdef MATH_USE_SSE
+	const __m128 signw = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, (int)0x80000000));
+
+	__m128 qa = _mm_loadu_ps(a);
+	__m128 qb = _mm_loadu_ps(b);
+	__m128 tmp;
+
+	// w is a3 * b3 + (-a0 * b0) + (-a1 * b1) - a2 * b2, which rounds the same as the scalar code
+	tmp = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(3, 3, 3, 3)), qb);
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(0, 2, 1, 0)), signw), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 3, 3, 3))));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(1, 0, 2, 1)), signw), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 1, 0, 2))));
+	tmp = _mm_sub_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(2, 1, 0, 2)), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 0, 2, 1))));
+
+	_mm_storeu_ps(out, tmp);
+#else
 	float tmp[4];
 
 	tmp[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
@@ -1087,6 +1568,7 @@ void FUNC_PROTO(QuaternionMultiply)(float out[4], float a[4], float b[4])
 	out[1] = tmp[1];
 	out[2] = tmp[2];
 	out[3] = tmp[3];
+#endif
 }
 
 void FUNC_PROTO(QuaternionSet)(float out[4], float x, float y, float z, float w)
@@ -1302,8 +1784,16 @@ float FUNC_PROTO(HalfToFloat)(uint16_t bits)
 
 	if( exp == 0 )
 	{
-		fp32 = magic + mant;
-		(*(float*)&fp32) -= (*(float*)&magic);
+		uint32_t denorm = magic + mant;
+		float fdenorm, fmagic;
+
+		memcpy(&fdenorm, &denorm, sizeof(float));
+		memcpy(&fmagic, &magic, sizeof(float));
+
+		fdenorm -= fmagic;
+
+		memcpy(&denorm, &fdenorm, sizeof(float));
+		fp32 |= denorm;
 	}
 	else
 	{
@@ -1318,7 +1808,10 @@ float FUNC_PROTO(HalfToFloat)(uint16_t bits)
 		fp32 |= mant;
 	}
 
-	return *((float*)&fp32);
+	float ret;
+
+	memcpy(&ret, &fp32, sizeof(float));
+	return ret;
 }
 
 int FUNC_PROTO(FrustumIntersect)(float frustum[6][4], const CLASS_PROTO(AABox)& box)
@@ -1347,6 +1840,168 @@ int FUNC_PROTO(FrustumIntersect)(float frustum[6][4], const CLASS_PROTO(AABox)&
 	return result;
 }
 
+#if defined(MATH_USE_AVX)
+typedef __m256 cullvector;
+#	define CULL_WIDTH	8
+#elif defined(MATH_USE_SSE)
+typedef __m128 cullvector;
+#	define CULL_WIDTH	4
+#endif
+
+#ifdef CULL_WIDTH
+// same arithmetic as FrustumIntersect, a box is culled if it's behind any of the planes
+static inline uint32_t CullGroup(const cullvector planes[6][4], const CLASS_PROTO(AABoxArray)& boxes, size_t i)
+{
+#ifdef MATH_USE_AVX
+	__m256 half = _mm256_set1_ps(0.5f);
+	__m256 sign = _mm256_set1_ps(-0.0f);
+	__m256 dist, maxdist, outside;
+
+	__m256 lx = _mm256_loadu_ps(&boxes.MinX[i]), ux = _mm256_loadu_ps(&boxes.MaxX[i]);
+	__m256 ly = _mm256_loadu_ps(&boxes.MinY[i]), uy = _mm256_loadu_ps(&boxes.MaxY[i]);
+	__m256 lz = _mm256_loadu_ps(&boxes.MinZ[i]), uz = _mm256_loadu_ps(&boxes.MaxZ[i]);
+
+	__m256 cx = _mm256_mul_ps(_mm256_add_ps(lx, ux), half);
+	__m256 cy = _mm256_mul_ps(_mm256_add_ps(ly, uy), half);
+	__m256 cz = _mm256_mul_ps(_mm256_add_ps(lz, uz), half);
+
+	__m256 hx = _mm256_mul_ps(_mm256_sub_ps(ux, lx), half);
+	__m256 hy = _mm256_mul_ps(_mm256_sub_ps(uy, ly), half);
+	__m256 hz = _mm256_mul_ps(_mm256_sub_ps(uz, lz), half);
+
+	outside = _mm256_setzero_ps();
+
+	for( int j = 0; j < 6; ++j )
+	{
+		dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(planes[j][0], cx), _mm256_mul_ps(planes[j][1], cy)), _mm256_mul_ps(planes[j][2], cz)), planes[j][3]);
+
+		maxdist = _mm256_add_ps(_mm256_add_ps(
+			_mm256_andnot_ps(sign, _mm256_mul_ps(planes[j][0], hx)),
+			_mm256_andnot_ps(sign, _mm256_mul_ps(planes[j][1], hy))),
+			_mm256_andnot_ps(sign, _mm256_mul_ps(planes[j][2], hz)));
+
+		outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, _mm256_xor_ps(maxdist, sign), _CMP_LT_OQ));
+	}
+
+	return (uint32_t)(~_mm256_movemask_ps(outside) & 0xff);
+#else
+	__m128 half = _mm_set1_ps(0.5f);
+	__m128 sign = _mm_set1_ps(-0.0f);
+	__m128 dist, maxdist, outside;
+
+	__m128 lx = _mm_loadu_ps(&boxes.MinX[i]), ux = _mm_loadu_ps(&boxes.MaxX[i]);
+	__m128 ly = _mm_loadu_ps(&boxes.MinY[i]), uy = _mm_loadu_ps(&boxes.MaxY[i]);
+	__m128 lz = _mm_loadu_ps(&boxes.MinZ[i]), uz = _mm_loadu_ps(&boxes.MaxZ[i]);
+
+	__m128 cx = _mm_mul_ps(_mm_add_ps(lx, ux), half);
+	__m128 cy = _mm_mul_ps(_mm_add_ps(ly, uy), half);
+	__m128 cz = _mm_mul_ps(_mm_add_ps(lz, uz), half);
+
+	__m128 hx = _mm_mul_ps(_mm_sub_ps(ux, lx), half);
+	__m128 hy = _mm_mul_ps(_mm_sub_ps(uy, ly), half);
+	__m128 hz = _mm_mul_ps(_mm_sub_ps(uz, lz), half);
+
+	outside = _mm_setzero_ps();
+
+	for( int j = 0; j < 6; ++j )
+	{
+		dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(planes[j][0], cx), _mm_mul_ps(planes[j][1], cy)), _mm_mul_ps(planes[j][2], cz)), planes[j][3]);
+
+		maxdist = _mm_add_ps(_mm_add_ps(
+			_mm_andnot_ps(sign, _mm_mul_ps(planes[j][0], hx)),
+			_mm_andnot_ps(sign, _mm_mul_ps(planes[j][1], hy))),
+			_mm_andnot_ps(sign, _mm_mul_ps(planes[j][2], hz)));
+
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_xor_ps(maxdist, sign)));
+	}
+
+	return (uint32_t)(~_mm_movemask_ps(outside) & 0xf);
+#endif
+}
+#endif
+
+static size_t CullBoxes(uint32_t* outmask, uint32_t* outindices, float frustum[6][4], const CLASS_PROTO(AABoxArray)& boxes)
+{
+	CLASS_PROTO(AABox) box;
+	size_t count = boxes.Size();
+	size_t numvisible = 0;
+	size_t i = 0;
+
+	if( outmask )
+		memset(outmask, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+#ifdef CULL_WIDTH
+	cullvector planes[6][4];
+	uint32_t bits;
+
+	for( int j = 0; j < 6; ++j )
+	{
+		for( int k = 0; k < 4; ++k )
+		{
+#	ifdef MATH_USE_AVX
+			planes[j][k] = _mm256_set1_ps(frustum[j][k]);
+#	else
+			planes[j][k] = _mm_set1_ps(frustum[j][k]);
+#	endif
+		}
+	}
+
+	for( ; i + CULL_WIDTH <= count; i += CULL_WIDTH )
+	{
+		bits = CullGroup(planes, boxes, i);
+
+		// CULL_WIDTH divides 32, a group never spans two words
+		if( outmask )
+			outmask[i / 32] |= (bits << (i % 32));
+
+		if( outindices )
+		{
+			// branchless compaction
+			for( size_t k = 0; k < CULL_WIDTH; ++k )
+			{
+				outindices[numvisible] = (uint32_t)(i + k);
+				numvisible += ((bits >> k) & 1);
+			}
+		}
+		else
+		{
+			for( ; bits != 0; bits &= (bits - 1) )
+				++numvisible;
+		}
+	}
+#endif
+
+	for( ; i < count; ++i )
+	{
+		boxes.Get(i, box);
+
+		if( FUNC_PROTO(FrustumIntersect)(frustum, box) > 0 )
+		{
+			if( outmask )
+				outmask[i / 32] |= (1u << (i % 32));
+
+			if( outindices )
+				outindices[numvisible] = (uint32_t)i;
+
+			++numvisible;
+		}
+	}
+
+	return numvisible;
+}
+
+size_t FUNC_PROTO(FrustumCullMask)(uint32_t* outmask, float frustum[6][4], const CLASS_PROTO(AABoxArray)& boxes)
+{
+	return CullBoxes(outmask, 0, frustum, boxes);
+}
+
+size_t FUNC_PROTO(FrustumCullIndices)(uint32_t* outindices, float frustum[6][4], const CLASS_PROTO(AABoxArray)& boxes)
+{
+	return CullBoxes(0, outindices, frustum, boxes);
+}
+
 uint32_t FUNC_PROTO(Vec3ToUbyte4)(const float a[3])
 {
 	uint32_t ret = 0;
@@ -1361,7 +2016,10 @@ uint32_t FUNC_PROTO(Vec3ToUbyte4)(const float a[3])
 
 uint16_t FUNC_PROTO(FloatToHalf)(float f)
 {
-	uint32_t u = *(uint32_t*)(&f);
+	uint32_t u;
+
+	memcpy(&u, &f, sizeof(uint32_t));
+
 	uint32_t signbit = (u & 0x80000000) >> 16;
 	int32_t exponent = ((u & 0x7F800000) >> 23) - 112;
 	uint32_t mantissa = (u & 0x007FFFFF);
@@ -1387,6 +2045,314 @@ uint8_t FUNC_PROTO(FloatToByte)(float f)
 	return (uint8_t)i;
 }
 
+void FUNC_PROTO(Ubyte4ToVec3)(float out[3], uint32_t v)
+{
+	const uint8_t* bytes = (const uint8_t*)(&v);
+
+	out[0] = bytes[0] * (2.0f / 255.0f) - 1.0f;
+	out[1] = bytes[1] * (2.0f / 255.0f) - 1.0f;
+	out[2] = bytes[2] * (2.0f / 255.0f) - 1.0f;
+}
+
+// *****************************************************************************************************************************
+//
+// Bulk conversions impl
+//
+// *****************************************************************************************************************************
+
+// linear to 8 bit sRGB: the exponent and the top mantissa bits of the clamped value select a bucket; a bucket is narrower
+// than half a code, so it contains at most one rounding threshold and one comparison gives the correctly rounded result
+#define SRGB_MANTISSA_BITS	7
+#define SRGB_MIN_EXPONENT	13		// below 2^-13 everything rounds to 0
+#define SRGB_NUM_BUCKETS	((SRGB_MIN_EXPONENT << SRGB_MANTISSA_BITS) + 1)
+#define SRGB_MIN_VALUE		(1.0f / (1 << SRGB_MIN_EXPONENT))
+
+static float	sRGBToLinearTable[256];
+static float	sRGBThresholds[257];			// smallest linear value that rounds to the given code
+static uint8_t	sRGBBuckets[SRGB_NUM_BUCKETS];	// code of the first value in the bucket
+
+static inline uint32_t FloatBits(float f)
+{
+	uint32_t u;
+
+	memcpy(&u, &f, sizeof(float));
+	return u;
+}
+
+static inline float BitsToFloat(uint32_t u)
+{
+	float f;
+
+	memcpy(&f, &u, sizeof(float));
+	return f;
+}
+
+static bool InitSRGBTables()
+{
+	CLASS_PROTO(Color) color;
+	double srgb, linear;
+	float threshold;
+	int code = 0;
+
+	for( int i = 0; i < 256; ++i )
+	{
+		color = CLASS_PROTO(Color)::sRGBToLinear((uint8_t)i, 0, 0);
+		sRGBToLinearTable[i] = color.r;
+	}
+
+	sRGBThresholds[0] = 0;
+	sRGBThresholds[256] = FLT_MAX;
+
+	for( int i = 1; i < 256; ++i )
+	{
+		srgb = (i - 0.5) / 255.0;
+		linear = (srgb <= 0.04045 ? srgb / 12.92 : pow((srgb + 0.055) / 1.055, 2.4));
+		threshold = (float)linear;
+
+		if( (double)threshold < linear )
+			threshold = BitsToFloat(FloatBits(threshold) + 1);
+
+		sRGBThresholds[i] = threshold;
+	}
+
+	for( int i = 0; i < SRGB_NUM_BUCKETS; ++i )
+	{
+		float start = BitsToFloat(FloatBits(SRGB_MIN_VALUE) + (i << (23 - SRGB_MANTISSA_BITS)));
+
+		while( code < 255 && sRGBThresholds[code + 1] <= start )
+			++code;
+
+		sRGBBuckets[i] = (uint8_t)code;
+	}
+
+	return true;
+}
+
+static bool sRGBTablesReady = InitSRGBTables();
+
+static inline uint8_t LinearTosRGBByte(float f)
+{
+	// NaN goes to the lower bound too
+	f = (f >= SRGB_MIN_VALUE ? f : SRGB_MIN_VALUE);
+	f = (f <= 1.0f ? f : 1.0f);
+
+	uint8_t code = sRGBBuckets[(FloatBits(f) - FloatBits(SRGB_MIN_VALUE)) >> (23 - SRGB_MANTISSA_BITS)];
+	return code + (f >= sRGBThresholds[code + 1] ? 1 : 0);
+}
+
+#ifdef MATH_USE_SSE
+static inline __m128 HalfToFloat4(__m128i h)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i magic = _mm_set1_epi32(126 << 23);
+
+	__m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+	__m128i mant = _mm_and_si128(h, _mm_set1_epi32(0x3ff));
+	__m128i exp = _mm_and_si128(_mm_srli_epi32(h, 10), _mm_set1_epi32(0x1f));
+	__m128i denormal = _mm_cmpeq_epi32(exp, zero);
+	__m128i special = _mm_cmpeq_epi32(exp, _mm_set1_epi32(31));
+
+	// rebias, inf and NaN keep their mantissa
+	exp = _mm_add_epi32(exp, _mm_set1_epi32(127 - 15));
+	exp = _mm_or_si128(_mm_andnot_si128(special, exp), _mm_and_si128(special, _mm_set1_epi32(255)));
+
+	__m128i normalbits = _mm_or_si128(_mm_slli_epi32(exp, 23), _mm_slli_epi32(mant, 13));
+	__m128i denormalbits = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(magic, mant)), _mm_castsi128_ps(magic)));
+
+	__m128i result = _mm_or_si128(_mm_andnot_si128(denormal, normalbits), _mm_and_si128(denormal, denormalbits));
+	return _mm_castsi128_ps(_mm_or_si128(result, sign));
+}
+
+static inline __m128i FloatToHalf4(__m128 f)
+{
+	__m128i u = _mm_castps_si128(f);
+
+	__m128i sign = _mm_srli_epi32(_mm_and_si128(u, _mm_set1_epi32((int)0x80000000)), 16);
+	__m128i exponent = _mm_sub_epi32(_mm_srli_epi32(_mm_and_si128(u, _mm_set1_epi32(0x7F800000)), 23), _mm_set1_epi32(112));
+	__m128i mantissa = _mm_and_si128(u, _mm_set1_epi32(0x007FFFFF));
+
+	__m128i result = _mm_or_si128(sign, _mm_or_si128(_mm_slli_epi32(exponent, 10), _mm_srli_epi32(mantissa, 13)));
+	__m128i overflow = _mm_cmpgt_epi32(exponent, _mm_set1_epi32(30));
+	__m128i underflow = _mm_cmplt_epi32(exponent, _mm_set1_epi32(1));
+
+	// same as FloatToHalf: clamped to the largest half, small values (and their sign) flushed to 0
+	result = _mm_or_si128(_mm_andnot_si128(overflow, result), _mm_and_si128(overflow, _mm_or_si128(sign, _mm_set1_epi32(0x7BFF))));
+	result = _mm_andnot_si128(underflow, result);
+
+	// sign extend, so that the signed pack doesn't saturate
+	return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+}
+#endif
+
+void FUNC_PROTO(HalfToFloatArray)(float* out, const uint16_t* in, size_t count)
+{
+	size_t i = 0;
+
+#if defined(MATH_USE_F16C)
+	for( ; i + 8 <= count; i += 8 )
+		_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+#elif defined(MATH_USE_SSE)
+	const __m128i zero = _mm_setzero_si128();
+	__m128i h;
+
+	for( ; i + 8 <= count; i += 8 )
+	{
+		h = _mm_loadu_si128((const __m128i*)(in + i));
+
+		_mm_storeu_ps(out + i, HalfToFloat4(_mm_unpacklo_epi16(h, zero)));
+		_mm_storeu_ps(out + i + 4, HalfToFloat4(_mm_unpackhi_epi16(h, zero)));
+	}
+#endif
+
+	for( ; i < count; ++i )
+		out[i] = FUNC_PROTO(HalfToFloat)(in[i]);
+}
+
+void FUNC_PROTO(FloatToHalfArray)(uint16_t* out, const float* in, size_t count)
+{
+	size_t i = 0;
+
+#ifdef MATH_USE_SSE
+	__m128i lo, hi;
+
+	for( ; i + 8 <= count; i += 8 )
+	{
+		lo = FloatToHalf4(_mm_loadu_ps(in + i));
+		hi = FloatToHalf4(_mm_loadu_ps(in + i + 4));
+
+		_mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(lo, hi));
+	}
+#endif
+
+	for( ; i < count; ++i )
+		out[i] = FUNC_PROTO(FloatToHalf)(in[i]);
+}
+
+void FUNC_PROTO(sRGBToLinearArray)(float* out, const uint8_t* in, size_t count)
+{
+	size_t i = 0;
+
+	// a gather is not faster than this
+	for( ; i + 4 <= count; i += 4 )
+	{
+		out[i + 0] = sRGBToLinearTable[in[i + 0]];
+		out[i + 1] = sRGBToLinearTable[in[i + 1]];
+		out[i + 2] = sRGBToLinearTable[in[i + 2]];
+		out[i + 3] = sRGBToLinearTable[in[i + 3]];
+	}
+
+	for( ; i < count; ++i )
+		out[i] = sRGBToLinearTable[in[i]];
+}
+
+void FUNC_PROTO(LinearTosRGBArray)(uint8_t* out, const float* in, size_t count)
+{
+	size_t i = 0;
+
+#ifdef MATH_USE_SSE
+	const __m128 minvalue = _mm_set1_ps(SRGB_MIN_VALUE);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128i minbits = _mm_set1_epi32((int)FloatBits(SRGB_MIN_VALUE));
+
+	__m128 f;
+	__m128i buckets;
+	uint32_t index[4];
+	float value[4];
+	uint8_t code;
+
+	for( ; i + 4 <= count; i += 4 )
+	{
+		// maxps returns the second operand for NaN
+		f = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), minvalue), one);
+		buckets = _mm_srli_epi32(_mm_sub_epi32(_mm_castps_si128(f), minbits), 23 - SRGB_MANTISSA_BITS);
+
+		_mm_storeu_si128((__m128i*)index, buckets);
+		_mm_storeu_ps(value, f);
+
+		for( int j = 0; j < 4; ++j )
+		{
+			code = sRGBBuckets[index[j]];
+			out[i + j] = code + (value[j] >= sRGBThresholds[code + 1] ? 1 : 0);
+		}
+	}
+#endif
+
+	for( ; i < count; ++i )
+		out[i] = LinearTosRGBByte(in[i]);
+}
+
+void FUNC_PROTO(Vec3ToUbyte4Array)(uint32_t* out, size_t outstride, const float* in, size_t instride, size_t count)
+{
+	size_t i = 0;
+
+#ifdef MATH_USE_SSE
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f / 2.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128i mask = _mm_set1_epi32(0x00ffffff);
+
+	__m128i t[4];
+	__m128i packed;
+	uint32_t result[4];
+
+	for( ; i + 4 <= count; i += 4 )
+	{
+		for( int j = 0; j < 4; ++j )
+		{
+			const float* v = (const float*)((const char*)in + (i + j) * instride);
+			__m128 a = _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd((const double*)v)), _mm_load_ss(v + 2));
+
+			// truncated like FloatToByte, out of range values saturate in the packs
+			t[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(a, one), scale), half));
+		}
+
+		packed = _mm_packus_epi16(_mm_packs_epi32(t[0], t[1]), _mm_packs_epi32(t[2], t[3]));
+		packed = _mm_and_si128(packed, mask);
+
+		if( outstride == sizeof(uint32_t) )
+		{
+			_mm_storeu_si128((__m128i*)(out + i), packed);
+		}
+		else
+		{
+			_mm_storeu_si128((__m128i*)result, packed);
+
+			for( int j = 0; j < 4; ++j )
+				*(uint32_t*)((char*)out + (i + j) * outstride) = result[j];
+		}
+	}
+#endif
+
+	for( ; i < count; ++i )
+		*(uint32_t*)((char*)out + i * outstride) = FUNC_PROTO(Vec3ToUbyte4)((const float*)((const char*)in + i * instride));
+}
+
+void FUNC_PROTO(Ubyte4ToVec3Array)(float* out, size_t outstride, const uint32_t* in, size_t instride, size_t count)
+{
+	size_t i = 0;
+
+#ifdef MATH_USE_SSE
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(2.0f / 255.0f);
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	for( ; i < count; ++i )
+	{
+		uint32_t bits = *(const uint32_t*)((const char*)in + i * instride);
+		float* v = (float*)((char*)out + i * outstride);
+
+		__m128i b = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)bits), zero), zero);
+		__m128 a = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(b), scale), one);
+
+		_mm_storel_pi((__m64*)v, a);
+		_mm_store_ss(v + 2, _mm_movehl_ps(a, a));
+	}
+#endif
+
+	for( ; i < count; ++i )
+		FUNC_PROTO(Ubyte4ToVec3)((float*)((char*)out + i * outstride), *(const uint32_t*)((const char*)in + i * instride));
+}
+
 std::string& FUNC_PROTO(GetPath)(std::string& out, const std::string& str)
 {
 	size_t pos = str.find_last_of("\\/");
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cfloat>
 #include <string>
+#include <vector>
 
 #if defined(USE_VULKAN_PREFIX)
 #	define FUNC_PROTO(x)	VK##x
@@ -95,6 +96,26 @@ public:
 	float Farthest(float from[4]) const;
 };
 
+/**
+ * \brief Axis-aligned bounding boxes in SoA layout (for culling many at once)
+ */
+class CLASS_PROTO(AABoxArray)
+{
+public:
+	std::vector<float> MinX, MinY, MinZ;
+	std::vector<float> MaxX, MaxY, MaxZ;
+
+	void Add(const CLASS_PROTO(AABox)& box);
+	void Set(size_t index, const CLASS_PROTO(AABox)& box);
+	void Get(size_t index, CLASS_PROTO(AABox)& outbox) const;
+	void Reserve(size_t count);
+	void Clear();
+
+	inline size_t Size() const {
+		return MinX.size();
+	}
+};
+
 class Complex
 {
 public:
@@ -162,6 +183,14 @@ void FUNC_PROTO(Vec3TransformTranspose)(float out[3], const float m[16], const f
 void FUNC_PROTO(Vec3TransformCoord)(float out[3], const float v[3], const float m[16]);
 void FUNC_PROTO(Vec3TransformCoordTranspose)(float out[3], const float m[16], const float v[3]);
 
+// strides are in bytes, out can be the same as in, only x, y, z is written. Packed arrays (12 byte strides) are
+// transformed 4 vertices at a time, interleaved ones (positions in a vertex struct) one by one with the SSE versions
+// of Vec3Transform(Coord), gathering 4 of them costs more shuffles than it saves (about 1.2x faster than plain C
+// code, packed arrays 1.7x or more)
+void FUNC_PROTO(Vec3TransformArray)(float* out, size_t outstride, const float* in, size_t instride, const float m[16], size_t count);
+void FUNC_PROTO(Vec3TransformCoordArray)(float* out, size_t outstride, const float* in, size_t instride, const float m[16], size_t count);
+void FUNC_PROTO(Vec3TransformCoordSoA)(float* outx, float* outy, float* outz, const float* x, const float* y, const float* z, const float m[16], size_t count);
+
 void FUNC_PROTO(Vec4Assign)(float out[4], const float a[4]);
 void FUNC_PROTO(Vec4Lerp)(float out[4], const float a[4], const float b[4], float s);
 void FUNC_PROTO(Vec4Set)(float out[4], float x, float y, float z, float w);
@@ -210,10 +239,25 @@ float FUNC_PROTO(RayIntersectCapsule)(const float a[3], const float b[3], const
 float FUNC_PROTO(HalfToFloat)(uint16_t bits);
 
 int FUNC_PROTO(FrustumIntersect)(float frustum[6][4], const CLASS_PROTO(AABox)& box);
+
+// these return the number of boxes for which FrustumIntersect would return > 0;
+// outmask needs (boxes.Size() + 31) / 32 elements, outindices boxes.Size() elements
+size_t FUNC_PROTO(FrustumCullMask)(uint32_t* outmask, float frustum[6][4], const CLASS_PROTO(AABoxArray)& boxes);
+size_t FUNC_PROTO(FrustumCullIndices)(uint32_t* outindices, float frustum[6][4], const CLASS_PROTO(AABoxArray)& boxes);
 uint32_t FUNC_PROTO(Vec3ToUbyte4)(const float a[3]);
 uint16_t FUNC_PROTO(FloatToHalf)(float f);
 uint8_t FUNC_PROTO(FloatToByte)(float f);
 
+void FUNC_PROTO(Ubyte4ToVec3)(float out[3], uint32_t v);
+
+// bulk versions of the above; FloatToHalfArray keeps the truncating behavior of FloatToHalf
+void FUNC_PROTO(HalfToFloatArray)(float* out, const uint16_t* in, size_t count);
+void FUNC_PROTO(FloatToHalfArray)(uint16_t* out, const float* in, size_t count);
+void FUNC_PROTO(sRGBToLinearArray)(float* out, const uint8_t* in, size_t count);
+void FUNC_PROTO(LinearTosRGBArray)(uint8_t* out, const float* in, size_t count);
+void FUNC_PROTO(Vec3ToUbyte4Array)(uint32_t* out, size_t outstride, const float* in, size_t instride, size_t count);
+void FUNC_PROTO(Ubyte4ToVec3Array)(float* out, size_t outstride, const uint32_t* in, size_t instride, size_t count);
+
 std::string& FUNC_PROTO(GetPath)(std::string& out, const std::string& str);
 std::string& FUNC_PROTO(GetFile)(std::string& out, const std::string& str);
 std::string& FUNC_PROTO(GetExtension)(std::string& out, const std::string& str);
@@ -0,0 +1,687 @@
+
+#ifndef _3DMATHTYPES_H_
+#define _3DMATHTYPES_H_
+
+#include <cmath>
+#include <cstring>
+
+// same rules as in 3Dmath.cpp, the vectorized operations round exactly like the scalar ones; mostly SSE here,
+// the values are temporaries that were just written with 16 byte stores, AVX loads of them would stall. Only
+// mat4 products use AVX, and then mat4 is stored in 32 byte halves everywhere
+#if !defined(MATH_NO_SIMD) && (defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__))
+#	define MATHTYPES_USE_SSE
+#	include <emmintrin.h>
+#	ifdef __AVX__
+#		define MATHTYPES_USE_AVX
+#		include <immintrin.h>
+#	endif
+#endif
+
+// for functions that are too long for the inlining heuristics; out of line they pass the matrix through
+// memory twice, and the vectorized copies don't match the width of the stores before them (both stall)
+#if defined(_MSC_VER)
+#	define MATHTYPES_FORCEINLINE __forceinline
+#elif defined(__GNUC__)
+#	define MATHTYPES_FORCEINLINE inline __attribute__((always_inline))
+#else
+#	define MATHTYPES_FORCEINLINE inline
+#endif
+
+// Header-only value types for the math in 3Dmath.h. Everything is inline, so the compiler can keep the values
+// in registers instead of passing float arrays through memory. Vector arithmetic builds expression templates:
+// a chain like a + b * s - c is evaluated element by element in one pass, without temporaries.
+//
+// The operations are done in the same order as in the C API (the results are identical), and the types convert
+// to float pointers, so they can be passed to it directly. Don't store expressions in 'auto' variables, they
+// reference their operands.
+
+template <int N, typename E>
+struct vecexpr
+{
+	inline float eval(int i) const {
+		return static_cast<const E&>(*this).eval(i);
+	}
+};
+
+// unrolls the loops over the elements, the compiler won't do it for every N
+template <int I>
+struct vecloop
+{
+	template <typename E>
+	static inline void assign(float* v, const E& e) {
+		vecloop<I - 1>::assign(v, e);
+		v[I - 1] = e.eval(I - 1);
+	}
+
+	static inline void fill(float* v, float s) {
+		vecloop<I - 1>::fill(v, s);
+		v[I - 1] = s;
+	}
+
+	static inline void load(float* v, const float* p) {
+		vecloop<I - 1>::load(v, p);
+		v[I - 1] = p[I - 1];
+	}
+
+	// summed from the first element, like Vec3Dot
+	template <typename L, typename R>
+	static inline float dot(const L& a, const R& b) {
+		return vecloop<I - 1>::dot(a, b) + a.eval(I - 1) * b.eval(I - 1);
+	}
+};
+
+template <>
+struct vecloop<1>
+{
+	template <typename E>
+	static inline void assign(float* v, const E& e) {
+		v[0] = e.eval(0);
+	}
+
+	static inline void fill(float* v, float s) {
+		v[0] = s;
+	}
+
+	static inline void load(float* v, const float* p) {
+		v[0] = p[0];
+	}
+
+	template <typename L, typename R>
+	static inline float dot(const L& a, const R& b) {
+		return a.eval(0) * b.eval(0);
+	}
+};
+
+template <int N>
+struct vec : public vecexpr<N, vec<N> >
+{
+	float v[N];
+
+	// uninitialized, like a float array
+	inline vec() {
+	}
+
+	explicit inline vec(float s) {
+		vecloop<N>::fill(v, s);
+	}
+
+	// element by element: memcpy splits into 8 and 4 byte moves, which later loads can't forward from
+	explicit inline vec(const float* p) {
+		vecloop<N>::load(v, p);
+	}
+
+	inline vec(float x, float y) {
+		static_assert(N == 2, "vec: wrong number of components");
+
+		v[0] = x;
+		v[1] = y;
+	}
+
+	inline vec(float x, float y, float z) {
+		static_assert(N == 3, "vec: wrong number of components");
+
+		v[0] = x;
+		v[1] = y;
+		v[2] = z;
+	}
+
+	inline vec(float x, float y, float z, float w) {
+		static_assert(N == 4, "vec: wrong number of components");
+
+		v[0] = x;
+		v[1] = y;
+		v[2] = z;
+		v[3] = w;
+	}
+
+	template <typename E>
+	inline vec(const vecexpr<N, E>& e) {
+		vecloop<N>::assign(v, static_cast<const E&>(e));
+	}
+
+	// element i of the result only depends on element i of the operands, so 'a = b + a * s' is fine
+	template <typename E>
+	inline vec& operator =(const vecexpr<N, E>& e) {
+		vecloop<N>::assign(v, static_cast<const E&>(e));
+		return *this;
+	}
+
+	template <typename E>
+	inline vec& operator +=(const vecexpr<N, E>& e);
+
+	template <typename E>
+	inline vec& operator -=(const vecexpr<N, E>& e);
+
+	inline vec& operator *=(float s);
+
+	inline float eval(int i) const {
+		return v[i];
+	}
+
+	// also gives v[i]
+	inline operator float*() {
+		return v;
+	}
+
+	inline operator const float*() const {
+		return v;
+	}
+
+	inline float& x()				{ return v[0]; }
+	inline float& y()				{ return v[1]; }
+	inline float& z()				{ static_assert(N > 2, "vec: no z component"); return v[2]; }
+	inline float& w()				{ static_assert(N > 3, "vec: no w component"); return v[3]; }
+
+	inline float x() const			{ return v[0]; }
+	inline float y() const			{ return v[1]; }
+	inline float z() const			{ static_assert(N > 2, "vec: no z component"); return v[2]; }
+	inline float w() const			{ static_assert(N > 3, "vec: no w component"); return v[3]; }
+};
+
+typedef vec<2> vec2;
+typedef vec<3> vec3;
+typedef vec<4> vec4;
+
+// vectors are referenced, intermediate nodes are copied (they are only a few pointers)
+template <typename E>
+struct vecoperand
+{
+	typedef const E type;
+};
+
+template <int N>
+struct vecoperand<vec<N> >
+{
+	typedef const vec<N>& type;
+};
+
+template <int N, typename L, typename R>
+struct vecadd : public vecexpr<N, vecadd<N, L, R> >
+{
+	typename vecoperand<L>::type a;
+	typename vecoperand<R>::type b;
+
+	inline vecadd(const L& l, const R& r) : a(l), b(r) {
+	}
+
+	inline float eval(int i) const {
+		return a.eval(i) + b.eval(i);
+	}
+};
+
+template <int N, typename L, typename R>
+struct vecsub : public vecexpr<N, vecsub<N, L, R> >
+{
+	typename vecoperand<L>::type a;
+	typename vecoperand<R>::type b;
+
+	inline vecsub(const L& l, const R& r) : a(l), b(r) {
+	}
+
+	inline float eval(int i) const {
+		return a.eval(i) - b.eval(i);
+	}
+};
+
+template <int N, typename L, typename R>
+struct vecmodulate : public vecexpr<N, vecmodulate<N, L, R> >
+{
+	typename vecoperand<L>::type a;
+	typename vecoperand<R>::type b;
+
+	inline vecmodulate(const L& l, const R& r) : a(l), b(r) {
+	}
+
+	inline float eval(int i) const {
+		return a.eval(i) * b.eval(i);
+	}
+};
+
+template <int N, typename E>
+struct vecscale : public vecexpr<N, vecscale<N, E> >
+{
+	typename vecoperand<E>::type a;
+	float s;
+
+	inline vecscale(const E& e, float scale) : a(e), s(scale) {
+	}
+
+	inline float eval(int i) const {
+		return a.eval(i) * s;
+	}
+};
+
+template <int N, typename E>
+struct vecnegate : public vecexpr<N, vecnegate<N, E> >
+{
+	typename vecoperand<E>::type a;
+
+	inline vecnegate(const E& e) : a(e) {
+	}
+
+	inline float eval(int i) const {
+		return -a.eval(i);
+	}
+};
+
+template <int N, typename L, typename R>
+inline vecadd<N, L, R> operator +(const vecexpr<N, L>& a, const vecexpr<N, R>& b) {
+	return vecadd<N, L, R>(static_cast<const L&>(a), static_cast<const R&>(b));
+}
+
+template <int N, typename L, typename R>
+inline vecsub<N, L, R> operator -(const vecexpr<N, L>& a, const vecexpr<N, R>& b) {
+	return vecsub<N, L, R>(static_cast<const L&>(a), static_cast<const R&>(b));
+}
+
+// component-wise, like Vec3Modulate
+template <int N, typename L, typename R>
+inline vecmodulate<N, L, R> operator *(const vecexpr<N, L>& a, const vecexpr<N, R>& b) {
+	return vecmodulate<N, L, R>(static_cast<const L&>(a), static_cast<const R&>(b));
+}
+
+template <int N, typename E>
+inline vecscale<N, E> operator *(const vecexpr<N, E>& a, float s) {
+	return vecscale<N, E>(static_cast<const E&>(a), s);
+}
+
+template <int N, typename E>
+inline vecscale<N, E> operator *(float s, const vecexpr<N, E>& a) {
+	return vecscale<N, E>(static_cast<const E&>(a), s);
+}
+
+template <int N, typename E>
+inline vecnegate<N, E> operator -(const vecexpr<N, E>& a) {
+	return vecnegate<N, E>(static_cast<const E&>(a));
+}
+
+template <int N>
+template <typename E>
+inline vec<N>& vec<N>::operator +=(const vecexpr<N, E>& e) {
+	return (*this = *this + e);
+}
+
+template <int N>
+template <typename E>
+inline vec<N>& vec<N>::operator -=(const vecexpr<N, E>& e) {
+	return (*this = *this - e);
+}
+
+template <int N>
+inline vec<N>& vec<N>::operator *=(float s) {
+	return (*this = *this * s);
+}
+
+template <int N, typename L, typename R>
+inline float dot(const vecexpr<N, L>& a, const vecexpr<N, R>& b) {
+	return vecloop<N>::dot(static_cast<const L&>(a), static_cast<const R&>(b));
+}
+
+template <int N, typename E>
+inline float length(const vecexpr<N, E>& e) {
+	vec<N> t(e);
+	return sqrtf(dot(t, t));
+}
+
+template <int N, typename E>
+inline vec<N> normalize(const vecexpr<N, E>& e) {
+	vec<N> t(e);
+	float il = 1.0f / sqrtf(dot(t, t));
+
+	return vec<N>(t * il);
+}
+
+template <int N, typename L, typename R>
+inline vecadd<N, vecscale<N, L>, vecscale<N, R> > lerp(const vecexpr<N, L>& a, const vecexpr<N, R>& b, float s) {
+	return a * (1.0f - s) + b * s;
+}
+
+template <typename L, typename R>
+inline vec3 cross(const vecexpr<3, L>& a, const vecexpr<3, R>& b) {
+	vec3 u(a), v(b);
+
+	return vec3(
+		u.v[1] * v.v[2] - u.v[2] * v.v[1],
+		u.v[2] * v.v[0] - u.v[0] * v.v[2],
+		u.v[0] * v.v[1] - u.v[1] * v.v[0]);
+}
+
+// row major, row vectors (v * M), like the C API
+struct mat4
+{
+	float m[16];
+
+	inline mat4() {
+	}
+
+	// in the widths the operators load them (a 32 byte copy would stall 16 byte loads of the upper half)
+	explicit inline mat4(const float* p) {
+#if defined(MATHTYPES_USE_AVX)
+		_mm256_storeu_ps(m, _mm256_loadu_ps(p));
+		_mm256_storeu_ps(m + 8, _mm256_loadu_ps(p + 8));
+#elif defined(MATHTYPES_USE_SSE)
+		_mm_storeu_ps(m, _mm_loadu_ps(p));
+		_mm_storeu_ps(m + 4, _mm_loadu_ps(p + 4));
+		_mm_storeu_ps(m + 8, _mm_loadu_ps(p + 8));
+		_mm_storeu_ps(m + 12, _mm_loadu_ps(p + 12));
+#else
+		for( int i = 0; i < 16; ++i )
+			m[i] = p[i];
+#endif
+	}
+
+	inline operator float*() {
+		return m;
+	}
+
+	inline operator const float*() const {
+		return m;
+	}
+
+	static inline mat4 Identity() {
+		mat4 ret;
+
+		memset(ret.m, 0, 16 * sizeof(float));
+		ret.m[0] = ret.m[5] = ret.m[10] = ret.m[15] = 1;
+
+		return ret;
+	}
+
+	static inline mat4 Translation(float x, float y, float z) {
+		mat4 ret = Identity();
+
+		ret.m[12] = x;
+		ret.m[13] = y;
+		ret.m[14] = z;
+
+		return ret;
+	}
+
+	static inline mat4 Scaling(float x, float y, float z) {
+		mat4 ret = Identity();
+
+		ret.m[0] = x;
+		ret.m[5] = y;
+		ret.m[10] = z;
+
+		return ret;
+	}
+
+	inline mat4 Transpose() const {
+		mat4 ret;
+
+		for( int i = 0; i < 4; ++i )
+		{
+			for( int j = 0; j < 4; ++j )
+				ret.m[i * 4 + j] = m[j * 4 + i];
+		}
+
+		return ret;
+	}
+
+	mat4 Inverse() const;
+};
+
+#ifdef MATHTYPES_USE_SSE
+// the rows of m weighted by the elements of r: r[0] * m[0] + r[1] * m[1] + r[2] * m[2] + r[3] * m[3]
+inline __m128 MultiplyRow(__m128 r, const float* m)
+{
+	__m128 tmp;
+
+	tmp = _mm_mul_ps(_mm_shuffle_ps(r, r, 0x00), _mm_loadu_ps(m));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(r, r, 0x55), _mm_loadu_ps(m + 4)));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(r, r, 0xaa), _mm_loadu_ps(m + 8)));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(r, r, 0xff), _mm_loadu_ps(m + 12)));
+
+	return tmp;
+}
+#endif
+
+inline mat4 operator *(const mat4& a, const mat4& b)
+{
+	mat4 ret;
+
+#if defined(MATHTYPES_USE_AVX)
+	// two rows at once, like MatrixMultiply
+	__m256 b0 = _mm256_broadcast_ps((const __m128*)b.m);
+	__m256 b1 = _mm256_broadcast_ps((const __m128*)(b.m + 4));
+	__m256 b2 = _mm256_broadcast_ps((const __m128*)(b.m + 8));
+	__m256 b3 = _mm256_broadcast_ps((const __m128*)(b.m + 12));
+
+	__m256 a01 = _mm256_loadu_ps(a.m);
+	__m256 a23 = _mm256_loadu_ps(a.m + 8);
+	__m256 r01, r23;
+
+	r01 = _mm256_mul_ps(_mm256_permute_ps(a01, 0x00), b0);
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, 0x55), b1));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, 0xaa), b2));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, 0xff), b3));
+
+	r23 = _mm256_mul_ps(_mm256_permute_ps(a23, 0x00), b0);
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, 0x55), b1));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, 0xaa), b2));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, 0xff), b3));
+
+	_mm256_storeu_ps(ret.m, r01);
+	_mm256_storeu_ps(ret.m + 8, r23);
+#elif defined(MATHTYPES_USE_SSE)
+	_mm_storeu_ps(ret.m, MultiplyRow(_mm_loadu_ps(a.m), b.m));
+	_mm_storeu_ps(ret.m + 4, MultiplyRow(_mm_loadu_ps(a.m + 4), b.m));
+	_mm_storeu_ps(ret.m + 8, MultiplyRow(_mm_loadu_ps(a.m + 8), b.m));
+	_mm_storeu_ps(ret.m + 12, MultiplyRow(_mm_loadu_ps(a.m + 12), b.m));
+#else
+	for( int i = 0; i < 16; i += 4 )
+	{
+		const float* r = a.m + i;
+
+		ret.m[i + 0] = r[0] * b.m[0] + r[1] * b.m[4] + r[2] * b.m[8] + r[3] * b.m[12];
+		ret.m[i + 1] = r[0] * b.m[1] + r[1] * b.m[5] + r[2] * b.m[9] + r[3] * b.m[13];
+		ret.m[i + 2] = r[0] * b.m[2] + r[1] * b.m[6] + r[2] * b.m[10] + r[3] * b.m[14];
+		ret.m[i + 3] = r[0] * b.m[3] + r[1] * b.m[7] + r[2] * b.m[11] + r[3] * b.m[15];
+	}
+#endif
+
+	return ret;
+}
+
+// like Vec4Transform
+inline vec4 operator *(const vec4& v, const mat4& m)
+{
+	vec4 ret;
+
+#ifdef MATHTYPES_USE_SSE
+	_mm_storeu_ps(ret.v, MultiplyRow(_mm_loadu_ps(v.v), m.m));
+#else
+	ret.v[0] = v.v[0] * m.m[0] + v.v[1] * m.m[4] + v.v[2] * m.m[8] + v.v[3] * m.m[12];
+	ret.v[1] = v.v[0] * m.m[1] + v.v[1] * m.m[5] + v.v[2] * m.m[9] + v.v[3] * m.m[13];
+	ret.v[2] = v.v[0] * m.m[2] + v.v[1] * m.m[6] + v.v[2] * m.m[10] + v.v[3] * m.m[14];
+	ret.v[3] = v.v[0] * m.m[3] + v.v[1] * m.m[7] + v.v[2] * m.m[11] + v.v[3] * m.m[15];
+#endif
+
+	return ret;
+}
+
+// like Vec3Transform (no translation)
+inline vec3 Transform(const vec3& v, const mat4& m)
+{
+	return vec3(
+		v.v[0] * m.m[0] + v.v[1] * m.m[4] + v.v[2] * m.m[8],
+		v.v[0] * m.m[1] + v.v[1] * m.m[5] + v.v[2] * m.m[9],
+		v.v[0] * m.m[2] + v.v[1] * m.m[6] + v.v[2] * m.m[10]);
+}
+
+// like Vec3TransformCoord
+inline vec3 TransformCoord(const vec3& v, const mat4& m)
+{
+	float tmp[4];
+
+	tmp[0] = v.v[0] * m.m[0] + v.v[1] * m.m[4] + v.v[2] * m.m[8] + m.m[12];
+	tmp[1] = v.v[0] * m.m[1] + v.v[1] * m.m[5] + v.v[2] * m.m[9] + m.m[13];
+	tmp[2] = v.v[0] * m.m[2] + v.v[1] * m.m[6] + v.v[2] * m.m[10] + m.m[14];
+	tmp[3] = v.v[0] * m.m[3] + v.v[1] * m.m[7] + v.v[2] * m.m[11] + m.m[15];
+
+	return vec3(tmp[0] / tmp[3], tmp[1] / tmp[3], tmp[2] / tmp[3]);
+}
+
+MATHTYPES_FORCEINLINE mat4 mat4::Inverse() const
+{
+	float s[6] =
+	{
+		m[0] * m[5] - m[1] * m[4],
+		m[0] * m[6] - m[2] * m[4],
+		m[0] * m[7] - m[3] * m[4],
+		m[1] * m[6] - m[2] * m[5],
+		m[1] * m[7] - m[3] * m[5],
+		m[2] * m[7] - m[3] * m[6]
+	};
+
+	float c[6] =
+	{
+		m[8] * m[13] - m[9] * m[12],
+		m[8] * m[14] - m[10] * m[12],
+		m[8] * m[15] - m[11] * m[12],
+		m[9] * m[14] - m[10] * m[13],
+		m[9] * m[15] - m[11] * m[13],
+		m[10] * m[15] - m[11] * m[14]
+	};
+
+	float det = (s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0]);
+	float r = 1.0f / det;
+	mat4 out;
+
+	out.m[0] = r * (m[5] * c[5] - m[6] * c[4] + m[7] * c[3]);
+	out.m[1] = r * (m[2] * c[4] - m[1] * c[5] - m[3] * c[3]);
+	out.m[2] = r * (m[13] * s[5] - m[14] * s[4] + m[15] * s[3]);
+	out.m[3] = r * (m[10] * s[4] - m[9] * s[5] - m[11] * s[3]);
+
+	out.m[4] = r * (m[6] * c[2] - m[4] * c[5] - m[7] * c[1]);
+	out.m[5] = r * (m[0] * c[5] - m[2] * c[2] + m[3] * c[1]);
+	out.m[6] = r * (m[14] * s[2] - m[12] * s[5] - m[15] * s[1]);
+	out.m[7] = r * (m[8] * s[5] - m[10] * s[2] + m[11] * s[1]);
+
+	out.m[8] = r * (m[4] * c[4] - m[5] * c[2] + m[7] * c[0]);
+	out.m[9] = r * (m[1] * c[2] - m[0] * c[4] - m[3] * c[0]);
+	out.m[10] = r * (m[12] * s[4] - m[13] * s[2] + m[15] * s[0]);
+	out.m[11] = r * (m[9] * s[2] - m[8] * s[4] - m[11] * s[0]);
+
+	out.m[12] = r * (m[5] * c[1] - m[4] * c[3] - m[6] * c[0]);
+	out.m[13] = r * (m[0] * c[3] - m[1] * c[1] + m[2] * c[0]);
+	out.m[14] = r * (m[13] * s[1] - m[12] * s[3] - m[14] * s[0]);
+	out.m[15] = r * (m[8] * s[3] - m[9] * s[1] + m[10] * s[0]);
+
+	return out;
+}
+
+// (x, y, z, w), w is the real part
+struct quat
+{
+	float q[4];
+
+	inline quat() {
+	}
+
+	inline quat(float x, float y, float z, float w) {
+		q[0] = x;
+		q[1] = y;
+		q[2] = z;
+		q[3] = w;
+	}
+
+	explicit inline quat(const float* p) {
+		q[0] = p[0];
+		q[1] = p[1];
+		q[2] = p[2];
+		q[3] = p[3];
+	}
+
+	inline operator float*() {
+		return q;
+	}
+
+	inline operator const float*() const {
+		return q;
+	}
+
+	static inline quat Identity() {
+		return quat(0, 0, 0, 1);
+	}
+
+	static inline quat RotationAxis(float x, float y, float z, float angle) {
+		float l = sqrtf(x * x + y * y + z * z);
+		float ha = angle * 0.5f;
+		float sa = sinf(ha);
+
+		return quat((x / l) * sa, (y / l) * sa, (z / l) * sa, cosf(ha));
+	}
+
+	inline quat Conjugate() const {
+		return quat(-q[0], -q[1], -q[2], q[3]);
+	}
+
+	inline quat Normalize() const {
+		float il = 1.0f / sqrtf(q[3] * q[3] + q[0] * q[0] + q[1] * q[1] + q[2] * q[2]);
+		return quat(q[0] * il, q[1] * il, q[2] * il, q[3] * il);
+	}
+
+	// like MatrixRotationQuaternion
+	inline mat4 ToMatrix() const {
+		mat4 out;
+
+		out.m[0] = 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]);
+		out.m[1] = 2.0f * (q[0] * q[1] + q[2] * q[3]);
+		out.m[2] = 2.0f * (q[0] * q[2] - q[1] * q[3]);
+
+		out.m[4] = 2.0f * (q[0] * q[1] - q[2] * q[3]);
+		out.m[5] = 1.0f - 2.0f * (q[0] * q[0] + q[2] * q[2]);
+		out.m[6] = 2.0f * (q[1] * q[2] + q[0] * q[3]);
+
+		out.m[8] = 2.0f * (q[0] * q[2] + q[1] * q[3]);
+		out.m[9] = 2.0f * (q[1] * q[2] - q[0] * q[3]);
+		out.m[10] = 1.0f - 2.0f * (q[0] * q[0] + q[1] * q[1]);
+
+		out.m[3] = out.m[7] = out.m[11] = 0;
+		out.m[12] = out.m[13] = out.m[14] = 0;
+		out.m[15] = 1;
+
+		return out;
+	}
+};
+
+inline quat operator *(const quat& a, const quat& b)
+{
+#ifdef MATHTYPES_USE_SSE
+	// see QuaternionMultiply in 3Dmath.cpp
+	const __m128 signw = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, (int)0x80000000));
+
+	// not loaded from memory, the quaternions are often built from scalars just before (like in Rotate)
+	__m128 qa = _mm_setr_ps(a.q[0], a.q[1], a.q[2], a.q[3]);
+	__m128 qb = _mm_setr_ps(b.q[0], b.q[1], b.q[2], b.q[3]);
+	__m128 tmp;
+	quat ret;
+
+	tmp = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(3, 3, 3, 3)), qb);
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(0, 2, 1, 0)), signw), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 3, 3, 3))));
+	tmp = _mm_add_ps(tmp, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(1, 0, 2, 1)), signw), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 1, 0, 2))));
+	tmp = _mm_sub_ps(tmp, _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(2, 1, 0, 2)), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 0, 2, 1))));
+
+	_mm_storeu_ps(ret.q, tmp);
+	return ret;
+#else
+	return quat(
+		a.q[3] * b.q[0] + a.q[0] * b.q[3] + a.q[1] * b.q[2] - a.q[2] * b.q[1],
+		a.q[3] * b.q[1] + a.q[1] * b.q[3] + a.q[2] * b.q[0] - a.q[0] * b.q[2],
+		a.q[3] * b.q[2] + a.q[2] * b.q[3] + a.q[0] * b.q[1] - a.q[1] * b.q[0],
+		a.q[3] * b.q[3] - a.q[0] * b.q[0] - a.q[1] * b.q[1] - a.q[2] * b.q[2]);
+#endif
+}
+
+// like Vec3Rotate
+inline vec3 Rotate(const vec3& v, const quat& q)
+{
+	quat p(v.v[0], v.v[1], v.v[2], 0);
+
+	p = q * (p * q.Conjugate());
+	return vec3(p.q[0], p.q[1], p.q[2]);
+}
+
+#endif
@@ -0,0 +1,767 @@
+
+#include "fft.h"
+#include "threadpool.h"
+#include <cstring>
+
+// same rules as in 3Dmath.cpp
+#if !defined(MATH_NO_SIMD) && (defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__))
+#	define FFT_USE_SSE
+#	include <emmintrin.h>
+#endif
+
+#define TRANSPOSE_BLOCK		32		// a 32x32 block of floats is 4 KB, the source and destination blocks of both planes fit into L1
+#define CHUNKS_PER_THREAD	4		// for load balancing
+
+static void Deinterleave(float* re, float* im, const float* data, size_t count)
+{
+	size_t i = 0;
+
+#ifdef FFT_USE_SSE
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128 lo = _mm_loadu_ps(data + i * 2);
+		__m128 hi = _mm_loadu_ps(data + i * 2 + 4);
+
+		_mm_storeu_ps(re + i, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(im + i, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+#endif
+
+	for( ; i < count; ++i )
+	{
+		re[i] = data[i * 2];
+		im[i] = data[i * 2 + 1];
+	}
+}
+
+static void Interleave(float* data, const float* re, const float* im, size_t count)
+{
+	size_t i = 0;
+
+#ifdef FFT_USE_SSE
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m128 r = _mm_loadu_ps(re + i);
+		__m128 m = _mm_loadu_ps(im + i);
+
+		_mm_storeu_ps(data + i * 2, _mm_unpacklo_ps(r, m));
+		_mm_storeu_ps(data + i * 2 + 4, _mm_unpackhi_ps(r, m));
+	}
+#endif
+
+	for( ; i < count; ++i )
+	{
+		data[i * 2] = re[i];
+		data[i * 2 + 1] = im[i];
+	}
+}
+
+// *****************************************************************************************************************************
+//
+// FFT impl
+//
+// *****************************************************************************************************************************
+
+// One Stockham pass splits the subsequences of length n into 4 (x -> y):
+//
+//   a = x[q + s * p], b = x[q + s * (p + n/4)], c = x[q + s * (p + n/2)], d = x[q + s * (p + 3n/4)]
+//
+//   y[q + s * (4p + 0)] = (a + c) + (b + d)
+//   y[q + s * (4p + 1)] = w^p * ((a - c) - i * (b - d))
+//   y[q + s * (4p + 2)] = w^2p * ((a + c) - (b + d))
+//   y[q + s * (4p + 3)] = w^3p * ((a - c) + i * (b - d))
+//
+// where w = exp(-2 * pi * i / n), then continues with n / 4 and s * 4. The output is in natural order,
+// there is no bit reversal.
+
+static void Radix4Scalar(float* yr, float* yi, const float* xr, const float* xi, const float* w, uint32_t n, uint32_t s)
+{
+	uint32_t n4 = n / 4;
+
+	for( uint32_t p = 0; p < n4; ++p )
+	{
+		float w1r = w[p];
+		float w1i = w[n4 + p];
+		float w2r = w[2 * n4 + p];
+		float w2i = w[3 * n4 + p];
+		float w3r = w[4 * n4 + p];
+		float w3i = w[5 * n4 + p];
+
+		size_t in = s * p;
+		size_t out = s * 4 * p;
+		size_t quarter = s * n4;
+
+		for( uint32_t q = 0; q < s; ++q )
+		{
+			size_t ia = in + q;
+			size_t ib = ia + quarter;
+			size_t ic = ib + quarter;
+			size_t id = ic + quarter;
+
+			float apcr = xr[ia] + xr[ic];
+			float apci = xi[ia] + xi[ic];
+			float amcr = xr[ia] - xr[ic];
+			float amci = xi[ia] - xi[ic];
+			float bpdr = xr[ib] + xr[id];
+			float bpdi = xi[ib] + xi[id];
+			float bmdr = xr[ib] - xr[id];
+			float bmdi = xi[ib] - xi[id];
+
+			float t1r = amcr + bmdi;
+			float t1i = amci - bmdr;
+			float t2r = apcr - bpdr;
+			float t2i = apci - bpdi;
+			float t3r = amcr - bmdi;
+			float t3i = amci + bmdr;
+
+			yr[out + q] = apcr + bpdr;
+			yi[out + q] = apci + bpdi;
+
+			yr[out + s + q] = t1r * w1r - t1i * w1i;
+			yi[out + s + q] = t1r * w1i + t1i * w1r;
+
+			yr[out + 2 * s + q] = t2r * w2r - t2i * w2i;
+			yi[out + 2 * s + q] = t2r * w2i + t2i * w2r;
+
+			yr[out + 3 * s + q] = t3r * w3r - t3i * w3i;
+			yi[out + 3 * s + q] = t3r * w3i + t3i * w3r;
+		}
+	}
+}
+
+#ifdef FFT_USE_SSE
+#define RADIX4_BUTTERFLY(w1r, w1i, w2r, w2i, w3r, w3i) \
+	__m128 apcr = _mm_add_ps(ar, cr); \
+	__m128 apci = _mm_add_ps(ai, ci); \
+	__m128 amcr = _mm_sub_ps(ar, cr); \
+	__m128 amci = _mm_sub_ps(ai, ci); \
+	__m128 bpdr = _mm_add_ps(br, dr); \
+	__m128 bpdi = _mm_add_ps(bi, di); \
+	__m128 bmdr = _mm_sub_ps(br, dr); \
+	__m128 bmdi = _mm_sub_ps(bi, di); \
+	__m128 t1r = _mm_add_ps(amcr, bmdi); \
+	__m128 t1i = _mm_sub_ps(amci, bmdr); \
+	__m128 t2r = _mm_sub_ps(apcr, bpdr); \
+	__m128 t2i = _mm_sub_ps(apci, bpdi); \
+	__m128 t3r = _mm_sub_ps(amcr, bmdi); \
+	__m128 t3i = _mm_add_ps(amci, bmdr); \
+	__m128 y0r = _mm_add_ps(apcr, bpdr); \
+	__m128 y0i = _mm_add_ps(apci, bpdi); \
+	__m128 y1r = _mm_sub_ps(_mm_mul_ps(t1r, w1r), _mm_mul_ps(t1i, w1i)); \
+	__m128 y1i = _mm_add_ps(_mm_mul_ps(t1r, w1i), _mm_mul_ps(t1i, w1r)); \
+	__m128 y2r = _mm_sub_ps(_mm_mul_ps(t2r, w2r), _mm_mul_ps(t2i, w2i)); \
+	__m128 y2i = _mm_add_ps(_mm_mul_ps(t2r, w2i), _mm_mul_ps(t2i, w2r)); \
+	__m128 y3r = _mm_sub_ps(_mm_mul_ps(t3r, w3r), _mm_mul_ps(t3i, w3i)); \
+	__m128 y3i = _mm_add_ps(_mm_mul_ps(t3r, w3i), _mm_mul_ps(t3i, w3r));
+// END
+
+// first pass (s == 1): four values of p at once, the results are transposed so that they can be stored together
+static void Radix4FirstSSE(float* yr, float* yi, const float* xr, const float* xi, const float* w, uint32_t n)
+{
+	uint32_t n4 = n / 4;
+
+	for( uint32_t p = 0; p < n4; p += 4 )
+	{
+		__m128 ar = _mm_loadu_ps(xr + p);
+		__m128 ai = _mm_loadu_ps(xi + p);
+		__m128 br = _mm_loadu_ps(xr + p + n4);
+		__m128 bi = _mm_loadu_ps(xi + p + n4);
+		__m128 cr = _mm_loadu_ps(xr + p + 2 * n4);
+		__m128 ci = _mm_loadu_ps(xi + p + 2 * n4);
+		__m128 dr = _mm_loadu_ps(xr + p + 3 * n4);
+		__m128 di = _mm_loadu_ps(xi + p + 3 * n4);
+
+		RADIX4_BUTTERFLY(
+			_mm_loadu_ps(w + p), _mm_loadu_ps(w + n4 + p),
+			_mm_loadu_ps(w + 2 * n4 + p), _mm_loadu_ps(w + 3 * n4 + p),
+			_mm_loadu_ps(w + 4 * n4 + p), _mm_loadu_ps(w + 5 * n4 + p));
+
+		_MM_TRANSPOSE4_PS(y0r, y1r, y2r, y3r);
+		_MM_TRANSPOSE4_PS(y0i, y1i, y2i, y3i);
+
+		_mm_storeu_ps(yr + 4 * p, y0r);
+		_mm_storeu_ps(yr + 4 * p + 4, y1r);
+		_mm_storeu_ps(yr + 4 * p + 8, y2r);
+		_mm_storeu_ps(yr + 4 * p + 12, y3r);
+
+		_mm_storeu_ps(yi + 4 * p, y0i);
+		_mm_storeu_ps(yi + 4 * p + 4, y1i);
+		_mm_storeu_ps(yi + 4 * p + 8, y2i);
+		_mm_storeu_ps(yi + 4 * p + 12, y3i);
+	}
+}
+
+// later passes (s >= 4): the twiddles are the same for every q
+static void Radix4SSE(float* yr, float* yi, const float* xr, const float* xi, const float* w, uint32_t n, uint32_t s)
+{
+	uint32_t n4 = n / 4;
+
+	for( uint32_t p = 0; p < n4; ++p )
+	{
+		__m128 w1r = _mm_set1_ps(w[p]);
+		__m128 w1i = _mm_set1_ps(w[n4 + p]);
+		__m128 w2r = _mm_set1_ps(w[2 * n4 + p]);
+		__m128 w2i = _mm_set1_ps(w[3 * n4 + p]);
+		__m128 w3r = _mm_set1_ps(w[4 * n4 + p]);
+		__m128 w3i = _mm_set1_ps(w[5 * n4 + p]);
+
+		size_t quarter = s * n4;
+		const float* sar = xr + s * p;
+		const float* sai = xi + s * p;
+		float* dr0 = yr + s * 4 * p;
+		float* di0 = yi + s * 4 * p;
+
+		for( uint32_t q = 0; q < s; q += 4 )
+		{
+			__m128 ar = _mm_loadu_ps(sar + q);
+			__m128 ai = _mm_loadu_ps(sai + q);
+			__m128 br = _mm_loadu_ps(sar + quarter + q);
+			__m128 bi = _mm_loadu_ps(sai + quarter + q);
+			__m128 cr = _mm_loadu_ps(sar + 2 * quarter + q);
+			__m128 ci = _mm_loadu_ps(sai + 2 * quarter + q);
+			__m128 dr = _mm_loadu_ps(sar + 3 * quarter + q);
+			__m128 di = _mm_loadu_ps(sai + 3 * quarter + q);
+
+			RADIX4_BUTTERFLY(w1r, w1i, w2r, w2i, w3r, w3i);
+
+			_mm_storeu_ps(dr0 + q, y0r);
+			_mm_storeu_ps(di0 + q, y0i);
+			_mm_storeu_ps(dr0 + s + q, y1r);
+			_mm_storeu_ps(di0 + s + q, y1i);
+			_mm_storeu_ps(dr0 + 2 * s + q, y2r);
+			_mm_storeu_ps(di0 + 2 * s + q, y2i);
+			_mm_storeu_ps(dr0 + 3 * s + q, y3r);
+			_mm_storeu_ps(di0 + 3 * s + q, y3i);
+		}
+	}
+}
+
+#undef RADIX4_BUTTERFLY
+#endif
+
+static void Radix4(float* yr, float* yi, const float* xr, const float* xi, const float* w, uint32_t n, uint32_t s)
+{
+#ifdef FFT_USE_SSE
+	if( s == 1 && n >= 16 )
+		Radix4FirstSSE(yr, yi, xr, xi, w, n);
+	else if( s >= 4 )
+		Radix4SSE(yr, yi, xr, xi, w, n, s);
+	else
+		Radix4Scalar(yr, yi, xr, xi, w, n, s);
+#else
+	Radix4Scalar(yr, yi, xr, xi, w, n, s);
+#endif
+}
+
+// last pass for odd powers of 2 (n == 2, the twiddle is 1)
+static void Radix2(float* yr, float* yi, const float* xr, const float* xi, uint32_t s)
+{
+	uint32_t q = 0;
+
+#ifdef FFT_USE_SSE
+	for( ; q + 4 <= s; q += 4 )
+	{
+		__m128 ar = _mm_loadu_ps(xr + q);
+		__m128 ai = _mm_loadu_ps(xi + q);
+		__m128 br = _mm_loadu_ps(xr + s + q);
+		__m128 bi = _mm_loadu_ps(xi + s + q);
+
+		_mm_storeu_ps(yr + q, _mm_add_ps(ar, br));
+		_mm_storeu_ps(yi + q, _mm_add_ps(ai, bi));
+		_mm_storeu_ps(yr + s + q, _mm_sub_ps(ar, br));
+		_mm_storeu_ps(yi + s + q, _mm_sub_ps(ai, bi));
+	}
+#endif
+
+	for( ; q < s; ++q )
+	{
+		float ar = xr[q], ai = xi[q];
+		float br = xr[s + q], bi = xi[s + q];
+
+		yr[q] = ar + br;
+		yi[q] = ai + bi;
+		yr[s + q] = ar - br;
+		yi[s + q] = ai - bi;
+	}
+}
+
+FFT::FFT()
+{
+	size = 0;
+}
+
+bool FFT::Initialize(uint32_t n)
+{
+	passes.clear();
+	twiddles.clear();
+	size = 0;
+
+	if( n == 0 || (n & (n - 1)) != 0 )
+		return false;
+
+	pass	current;
+	double	theta;
+
+	current.length = n;
+	current.stride = 1;
+
+	while( current.length > 1 )
+	{
+		uint32_t n4 = current.length / 4;
+
+		current.twiddles = twiddles.size();
+		passes.push_back(current);
+
+		if( current.length == 2 )
+			break;
+
+		// computed in double, so that the large sizes are accurate too
+		twiddles.resize(twiddles.size() + 6 * n4);
+
+		float* w = &twiddles[current.twiddles];
+
+		for( uint32_t p = 0; p < n4; ++p )
+		{
+			theta = (6.283185307179586 * p) / current.length;
+
+			w[p]			= (float)cos(theta);
+			w[n4 + p]		= (float)-sin(theta);
+			w[2 * n4 + p]	= (float)cos(2 * theta);
+			w[3 * n4 + p]	= (float)-sin(2 * theta);
+			w[4 * n4 + p]	= (float)cos(3 * theta);
+			w[5 * n4 + p]	= (float)-sin(3 * theta);
+		}
+
+		current.length = n4;
+		current.stride *= 4;
+	}
+
+	size = n;
+	return true;
+}
+
+void FFT::Transform(float* re, float* im, float* work) const
+{
+	float* xr = re;
+	float* xi = im;
+	float* yr = work;
+	float* yi = work + size;
+	float* tmp;
+
+	for( size_t i = 0; i < passes.size(); ++i )
+	{
+		const pass& current = passes[i];
+
+		if( current.length == 2 )
+			Radix2(yr, yi, xr, xi, current.stride);
+		else
+			Radix4(yr, yi, xr, xi, &twiddles[current.twiddles], current.length, current.stride);
+
+		tmp = xr; xr = yr; yr = tmp;
+		tmp = xi; xi = yi; yi = tmp;
+	}
+
+	// odd number of passes
+	if( xr != re )
+	{
+		memcpy(re, xr, size * sizeof(float));
+		memcpy(im, xi, size * sizeof(float));
+	}
+}
+
+void FFT::Forward(float* re, float* im, float* work) const
+{
+	Transform(re, im, work);
+}
+
+void FFT::Inverse(float* re, float* im, float* work) const
+{
+	// swapping the real and imaginary parts conjugates both the input and the output (up to a factor of i)
+	Transform(im, re, work);
+}
+
+void FFT::Forward(Complex* data, float* work) const
+{
+	Deinterleave(work, work + size, (const float*)data, size);
+	Transform(work, work + size, work + size * 2);
+	Interleave((float*)data, work, work + size, size);
+}
+
+void FFT::Inverse(Complex* data, float* work) const
+{
+	Deinterleave(work, work + size, (const float*)data, size);
+	Transform(work + size, work, work + size * 2);
+	Interleave((float*)data, work, work + size, size);
+}
+
+// *****************************************************************************************************************************
+//
+// RealFFT impl
+//
+// *****************************************************************************************************************************
+
+RealFFT::RealFFT()
+{
+	size = 0;
+}
+
+bool RealFFT::Initialize(uint32_t n)
+{
+	twiddles.clear();
+	size = 0;
+
+	if( n < 2 || (n & (n - 1)) != 0 )
+		return false;
+
+	if( !half.Initialize(n / 2) )
+		return false;
+
+	uint32_t h = n / 2;
+	double theta;
+
+	twiddles.resize(n);
+
+	for( uint32_t k = 0; k < h; ++k )
+	{
+		theta = (6.283185307179586 * k) / n;
+
+		twiddles[k] = (float)cos(theta);
+		twiddles[h + k] = (float)-sin(theta);
+	}
+
+	size = n;
+	return true;
+}
+
+void RealFFT::Forward(float* outre, float* outim, const float* in, float* work) const
+{
+	// z[k] = in[2k] + i * in[2k + 1]
+	uint32_t h = size / 2;
+	float* zr = work;
+	float* zi = work + h;
+	const float* wr = &twiddles[0];
+	const float* wi = &twiddles[h];
+
+	Deinterleave(zr, zi, in, h);
+	half.Forward(zr, zi, work + size);
+
+	outre[0] = zr[0] + zi[0];
+	outim[0] = 0;
+	outre[h] = zr[0] - zi[0];
+	outim[h] = 0;
+
+	// E = (Z[k] + conj(Z[h - k])) / 2 is the spectrum of the even samples, O = (Z[k] - conj(Z[h - k])) / 2i of the odd ones
+	for( uint32_t k = 1; k < h; ++k )
+	{
+		float ar = zr[k], ai = zi[k];
+		float br = zr[h - k], bi = -zi[h - k];
+
+		float er = 0.5f * (ar + br);
+		float ei = 0.5f * (ai + bi);
+		float odr = 0.5f * (ai - bi);
+		float odi = -0.5f * (ar - br);
+
+		outre[k] = er + (wr[k] * odr - wi[k] * odi);
+		outim[k] = ei + (wr[k] * odi + wi[k] * odr);
+	}
+}
+
+void RealFFT::Inverse(float* out, const float* inre, const float* inim, float* work) const
+{
+	uint32_t h = size / 2;
+	float* zr = work;
+	float* zi = work + h;
+	const float* wr = &twiddles[0];
+	const float* wi = &twiddles[h];
+
+	// the reverse of the above without the halving, so that the result is scaled by N like the complex one
+	for( uint32_t k = 0; k < h; ++k )
+	{
+		float ar = inre[k], ai = inim[k];
+		float br = inre[h - k], bi = -inim[h - k];
+
+		float er = ar + br;
+		float ei = ai + bi;
+		float dr = ar - br;
+		float di = ai - bi;
+
+		// O = D * conj(w^k)
+		float odr = dr * wr[k] + di * wi[k];
+		float odi = di * wr[k] - dr * wi[k];
+
+		zr[k] = er - odi;
+		zi[k] = ei + odr;
+	}
+
+	half.Inverse(zr, zi, work + size);
+	Interleave(out, zr, zi, h);
+}
+
+void RealFFT::Forward(Complex* out, const float* in, float* work) const
+{
+	uint32_t h = size / 2;
+	float* re = work + size * 2;
+
+	// the other overload only uses the first size * 2 floats
+	Forward(re, re + h + 1, in, work);
+	Interleave((float*)out, re, re + h + 1, h + 1);
+}
+
+void RealFFT::Inverse(float* out, const Complex* in, float* work) const
+{
+	uint32_t h = size / 2;
+	float* re = work + size * 2;
+
+	Deinterleave(re, re + h + 1, (const float*)in, h + 1);
+	Inverse(out, re, re + h + 1, work);
+}
+
+// *****************************************************************************************************************************
+//
+// FFT2D impl
+//
+// *****************************************************************************************************************************
+
+struct FFTRowJob
+{
+	const FFT*	plan;
+	float*		re;
+	float*		im;
+	float*		work;
+	size_t		worksize;		// per thread
+	uint32_t	numrows;
+	uint32_t	rowsperchunk;
+	bool		inverse;
+};
+
+struct FFTTransposeJob
+{
+	const float*	srcre;
+	const float*	srcim;
+	float*			dstre;
+	float*			dstim;
+	uint32_t		rows;		// of the source
+	uint32_t		columns;
+	uint32_t		block;
+};
+
+static void RowTask(void* arg, int chunk, int thread)
+{
+	FFTRowJob* job = (FFTRowJob*)arg;
+	size_t length = job->plan->Size();
+	uint32_t start = chunk * job->rowsperchunk;
+	uint32_t end = start + job->rowsperchunk;
+	float* work = job->work + thread * job->worksize;
+
+	if( end > job->numrows )
+		end = job->numrows;
+
+	for( uint32_t i = start; i < end; ++i )
+	{
+		if( job->inverse )
+			job->plan->Inverse(job->re + i * length, job->im + i * length, work);
+		else
+			job->plan->Forward(job->re + i * length, job->im + i * length, work);
+	}
+}
+
+static void TransposeBlock(float* dst, const float* src, uint32_t rows, uint32_t columns, uint32_t i0, uint32_t j0, uint32_t block)
+{
+	// dst[j * rows + i] = src[i * columns + j]
+#ifdef FFT_USE_SSE
+	if( block >= 4 )
+	{
+		for( uint32_t i = i0; i < i0 + block; i += 4 )
+		{
+			for( uint32_t j = j0; j < j0 + block; j += 4 )
+			{
+				const float* s = src + i * columns + j;
+				float* d = dst + j * rows + i;
+
+				__m128 r0 = _mm_loadu_ps(s);
+				__m128 r1 = _mm_loadu_ps(s + columns);
+				__m128 r2 = _mm_loadu_ps(s + 2 * columns);
+				__m128 r3 = _mm_loadu_ps(s + 3 * columns);
+
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+				_mm_storeu_ps(d, r0);
+				_mm_storeu_ps(d + rows, r1);
+				_mm_storeu_ps(d + 2 * rows, r2);
+				_mm_storeu_ps(d + 3 * rows, r3);
+			}
+		}
+
+		return;
+	}
+#endif
+
+	for( uint32_t i = i0; i < i0 + block; ++i )
+	{
+		for( uint32_t j = j0; j < j0 + block; ++j )
+			dst[j * rows + i] = src[i * columns + j];
+	}
+}
+
+static void TransposeTask(void* arg, int chunk, int)
+{
+	// one row of blocks
+	FFTTransposeJob* job = (FFTTransposeJob*)arg;
+	uint32_t i0 = chunk * job->block;
+
+	for( uint32_t j0 = 0; j0 < job->columns; j0 += job->block )
+	{
+		TransposeBlock(job->dstre, job->srcre, job->rows, job->columns, i0, j0, job->block);
+		TransposeBlock(job->dstim, job->srcim, job->rows, job->columns, i0, j0, job->block);
+	}
+}
+
+FFT2D::FFT2D()
+{
+	workers		= 0;
+	width		= 0;
+	height		= 0;
+	numthreads	= 0;
+}
+
+FFT2D::~FFT2D()
+{
+	Destroy();
+}
+
+bool FFT2D::Initialize(uint32_t w, uint32_t h, int threads)
+{
+	Destroy();
+
+	if( !rows.Initialize(w) || !columns.Initialize(h) )
+		return false;
+
+	width		= w;
+	height		= h;
+	numthreads	= (threads > 0 ? threads : threadpool::numcores());
+
+	size_t worksize = (rows.WorkSize() > columns.WorkSize() ? rows.WorkSize() : columns.WorkSize());
+
+	transposed.resize((size_t)w * h * 2);
+	work.resize(worksize * numthreads);
+
+	workers = new threadpool();
+	workers->create(numthreads - 1);
+
+	return true;
+}
+
+void FFT2D::Destroy()
+{
+	delete workers;
+
+	workers		= 0;
+	width		= 0;
+	height		= 0;
+	numthreads	= 0;
+
+	transposed.clear();
+	split.clear();
+	work.clear();
+}
+
+void FFT2D::Transform(float* re, float* im, bool inverse)
+{
+	FFTRowJob		rowjob;
+	FFTTransposeJob	transposejob;
+	size_t			count = (size_t)width * height;
+	uint32_t		block = TRANSPOSE_BLOCK;
+	int				numchunks;
+
+	float* tre = &transposed[0];
+	float* tim = tre + count;
+
+	// smaller than a block
+	if( block > width )
+		block = width;
+
+	if( block > height )
+		block = height;
+
+	rowjob.work		= &work[0];
+	rowjob.worksize	= work.size() / numthreads;
+	rowjob.inverse	= inverse;
+
+	transposejob.block = block;
+
+	// rows
+	rowjob.plan			= &rows;
+	rowjob.re			= re;
+	rowjob.im			= im;
+	rowjob.numrows		= height;
+	rowjob.rowsperchunk	= height / (numthreads * CHUNKS_PER_THREAD);
+
+	if( rowjob.rowsperchunk == 0 )
+		rowjob.rowsperchunk = 1;
+
+	numchunks = (int)((height + rowjob.rowsperchunk - 1) / rowjob.rowsperchunk);
+	workers->run(&RowTask, &rowjob, numchunks);
+
+	// columns
+	transposejob.srcre		= re;
+	transposejob.srcim		= im;
+	transposejob.dstre		= tre;
+	transposejob.dstim		= tim;
+	transposejob.rows		= height;
+	transposejob.columns	= width;
+
+	workers->run(&TransposeTask, &transposejob, (int)(height / block));
+
+	rowjob.plan			= &columns;
+	rowjob.re			= tre;
+	rowjob.im			= tim;
+	rowjob.numrows		= width;
+	rowjob.rowsperchunk	= width / (numthreads * CHUNKS_PER_THREAD);
+
+	if( rowjob.rowsperchunk == 0 )
+		rowjob.rowsperchunk = 1;
+
+	numchunks = (int)((width + rowjob.rowsperchunk - 1) / rowjob.rowsperchunk);
+	workers->run(&RowTask, &rowjob, numchunks);
+
+	transposejob.srcre		= tre;
+	transposejob.srcim		= tim;
+	transposejob.dstre		= re;
+	transposejob.dstim		= im;
+	transposejob.rows		= width;
+	transposejob.columns	= height;
+
+	workers->run(&TransposeTask, &transposejob, (int)(width / block));
+}
+
+void FFT2D::Forward(float* re, float* im)
+{
+	Transform(re, im, false);
+}
+
+void FFT2D::Inverse(float* re, float* im)
+{
+	Transform(re, im, true);
+}
+
+void FFT2D::Forward(Complex* data)
+{
+	size_t count = (size_t)width * height;
+
+	split.resize(count * 2);
+
+	Deinterleave(&split[0], &split[count], (const float*)data, count);
+	Transform(&split[0], &split[count], false);
+	Interleave((float*)data, &split[0], &split[count], count);
+}
+
+void FFT2D::Inverse(Complex* data)
+{
+	size_t count = (size_t)width * height;
+
+	split.resize(count * 2);
+
+	Deinterleave(&split[0], &split[count], (const float*)data, count);
+	Transform(&split[0], &split[count], true);
+	Interleave((float*)data, &split[0], &split[count], count);
+}
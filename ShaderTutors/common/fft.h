@@ -0,0 +1,139 @@
+
+#ifndef _FFT_H_
+#define _FFT_H_
+
+#include "3Dmath.h"
+
+class threadpool;
+
+/**
+ * \brief Complex FFT of a power of 2 size
+ *
+ * Stockham radix-4 passes (with one radix-2 pass for odd powers of 2) on split real and imaginary arrays,
+ * the twiddle factors are precomputed for every pass. The plan is constant after Initialize(), so it can
+ * be shared between threads, every thread has to give its own work buffer of WorkSize() floats.
+ *
+ * Forward uses exp(-2 * pi * i * k * n / N), Inverse is not scaled (the result is N times the input).
+ */
+class FFT
+{
+	struct pass
+	{
+		uint32_t	length;		// of the subsequences (n)
+		uint32_t	stride;		// between elements of a subsequence (s)
+		size_t		twiddles;	// offset of w1re, w1im, w2re, w2im, w3re, w3im (length / 4 each)
+	};
+
+private:
+	std::vector<pass>	passes;
+	std::vector<float>	twiddles;
+	uint32_t			size;
+
+	void Transform(float* re, float* im, float* work) const;
+
+public:
+	FFT();
+
+	bool Initialize(uint32_t n);
+
+	// work has WorkSize() floats
+	void Forward(float* re, float* im, float* work) const;
+	void Inverse(float* re, float* im, float* work) const;
+	void Forward(Complex* data, float* work) const;
+	void Inverse(Complex* data, float* work) const;
+
+	inline uint32_t Size() const {
+		return size;
+	}
+
+	inline size_t WorkSize() const {
+		return size * 4;
+	}
+};
+
+/**
+ * \brief FFT of N real values (N >= 2 is a power of 2)
+ *
+ * Runs a complex FFT of N / 2 on the even and odd samples and separates the two. The result is the
+ * first N / 2 + 1 elements of the spectrum, the rest are the conjugates of these.
+ */
+class RealFFT
+{
+private:
+	FFT					half;
+	std::vector<float>	twiddles;	// cos and -sin of 2 * pi * k / N, N / 2 each
+	uint32_t			size;
+
+public:
+	RealFFT();
+
+	bool Initialize(uint32_t n);
+
+	// outre and outim have Size() / 2 + 1 elements, work has WorkSize() floats
+	void Forward(float* outre, float* outim, const float* in, float* work) const;
+	void Inverse(float* out, const float* inre, const float* inim, float* work) const;
+	void Forward(Complex* out, const float* in, float* work) const;
+	void Inverse(float* out, const Complex* in, float* work) const;
+
+	inline uint32_t Size() const {
+		return size;
+	}
+
+	// the odd and even samples, the work buffer of the half size FFT and the split spectrum for Complex
+	inline size_t WorkSize() const {
+		return size * 3 + 2;
+	}
+};
+
+/**
+ * \brief 2D complex FFT of power of 2 sizes
+ *
+ * Transforms the rows, transposes the grid in cache sized blocks, transforms the rows again (the former
+ * columns) and transposes back. Every step is split between numthreads threads (the caller is one of them).
+ * The data is row major, width * height elements.
+ */
+class FFT2D
+{
+private:
+	FFT					rows;
+	FFT					columns;
+	threadpool*			workers;
+	std::vector<float>	transposed;	// re, then im
+	std::vector<float>	split;		// for Complex input
+	std::vector<float>	work;		// FFT work buffer for every thread
+	uint32_t			width;
+	uint32_t			height;
+	int					numthreads;
+
+	FFT2D(const FFT2D&);
+	FFT2D& operator =(const FFT2D&);
+
+	void Transform(float* re, float* im, bool inverse);
+
+public:
+	FFT2D();
+	~FFT2D();
+
+	// numthreads <= 0 uses every core
+	bool Initialize(uint32_t w, uint32_t h, int threads = 1);
+	void Destroy();
+
+	void Forward(float* re, float* im);
+	void Inverse(float* re, float* im);
+	void Forward(Complex* data);
+	void Inverse(Complex* data);
+
+	inline uint32_t Width() const {
+		return width;
+	}
+
+	inline uint32_t Height() const {
+		return height;
+	}
+
+	inline int NumThreads() const {
+		return numthreads;
+	}
+};
+
+#endif
@@ -6,6 +6,10 @@
 #include <utility>
 #include <functional>
 #include <algorithm>
+#include <type_traits>
+#include <string>
+#include <cstring>
+#include <cstdlib>
 
 #define myerror(r, e, x) { if( !(x) ) { std::cout << "* MYSTL ERROR: " << e << "\n"; return r; } }
 #define mynerror(r, e, x) { if( (x) ) { std::cout << "* MYSTL ERROR: " << e << "\n"; return r; } }
@@ -19,6 +23,33 @@ namespace mystl
 			return a < b;
 		}
 	};
+
+	// compares std::strings with each other or with C strings, without making temporaries
+	struct string_less
+	{
+		inline bool operator ()(const std::string& a, const std::string& b) const {
+			return (0 > strcmp(a.c_str(), b.c_str()));
+		}
+
+		inline bool operator ()(const std::string& a, const char* b) const {
+			return (0 > strcmp(a.c_str(), b));
+		}
+
+		inline bool operator ()(const char* a, const std::string& b) const {
+			return (0 > strcmp(a, b.c_str()));
+		}
+	};
+
+	// elements of such types can be moved around with memmove/realloc
+	template <typename T>
+	struct is_trivially_relocatable
+	{
+#if defined(_MSC_VER) && (_MSC_VER < 1700)
+		static const bool value = (std::has_trivial_copy<T>::value && std::has_trivial_destructor<T>::value);
+#else
+		static const bool value = std::is_trivially_copyable<T>::value;
+#endif
+	};
 }
 
 #endif
@@ -802,11 +802,6 @@ void OpenGLEffect::AddUniform(const char* name, GLuint location, GLuint count, G
 {
 	Uniform uni;
 
-	if( strlen(name) >= sizeof(uni.Name) )
-		throw 1;
-
-	strcpy(uni.Name, name);
-
 	if( type == GL_FLOAT_MAT4 )
 		count = 4;
 
@@ -857,7 +852,9 @@ void OpenGLEffect::AddUniform(const char* name, GLuint location, GLuint count, G
 		// not handled
 		throw 1;
 
-	uniforms.insert(uni);
+	// arrays of structs can show up more than once (the index is cut off)
+	if( uniforms.find(name) == UniformTable::npos )
+		uniforms.insert(name, uni);
 }
 
 void OpenGLEffect::AddUniformBlock(const char* name, GLint index, GLint binding, GLint blocksize)
@@ -868,8 +865,8 @@ void OpenGLEffect::AddUniformBlock(const char* name, GLint index, GLint binding,
 	block.Binding = binding;
 	block.BlockSize = blocksize;
 
-	strcpy(block.Name, name);
-	uniformblocks.insert(block);
+	if( uniformblocks.find(name) == UniformBlockTable::npos )
+		uniformblocks.insert(name, block);
 }
 
 void OpenGLEffect::BindAttributes()
@@ -1017,7 +1014,7 @@ void OpenGLEffect::CommitChanges()
 {
 	for( size_t i = 0; i < uniforms.size(); ++i )
 	{
-		const Uniform& uni = uniforms[i];
+		const Uniform& uni = uniforms.value(i);
 		float* floatdata = (floatvalues + uni.StartRegister * 4);
 		int* intdata = (intvalues + uni.StartRegister * 4);
 
@@ -1074,14 +1071,11 @@ void OpenGLEffect::SetMatrix(const char* name, const float* value)
 
 void OpenGLEffect::SetVector(const char* name, const float* value)
 {
-	Uniform test;
-	strcpy(test.Name, name);
-
-	size_t id = uniforms.find(test);
+	size_t id = uniforms.find(name);
 
 	if( id < uniforms.size() )
 	{
-		const Uniform& uni = uniforms[id];
+		const Uniform& uni = uniforms.value(id);
 		float* reg = (floatvalues + uni.StartRegister * 4);
 
 		memcpy(reg, value, uni.RegisterCount * 4 * sizeof(float));
@@ -1091,14 +1085,11 @@ void OpenGLEffect::SetVector(const char* name, const float* value)
 
 void OpenGLEffect::SetVectorArray(const char* name, const float* values, GLsizei count)
 {
-	Uniform test;
-	strcpy(test.Name, name);
-
-	size_t id = uniforms.find(test);
+	size_t id = uniforms.find(name);
 
 	if( id < uniforms.size() )
 	{
-		const Uniform& uni = uniforms[id];
+		const Uniform& uni = uniforms.value(id);
 		float* reg = (floatvalues + uni.StartRegister * 4);
 
 		if( count > uni.RegisterCount )
@@ -1111,14 +1102,11 @@ void OpenGLEffect::SetVectorArray(const char* name, const float* values, GLsizei
 
 void OpenGLEffect::SetFloat(const char* name, float value)
 {
-	Uniform test;
-	strcpy(test.Name, name);
-
-	size_t id = uniforms.find(test);
+	size_t id = uniforms.find(name);
 
 	if( id < uniforms.size() )
 	{
-		const Uniform& uni = uniforms[id];
+		const Uniform& uni = uniforms.value(id);
 		float* reg = (floatvalues + uni.StartRegister * 4);
 
 		reg[0] = value;
@@ -1128,14 +1116,11 @@ void OpenGLEffect::SetFloat(const char* name, float value)
 
 void OpenGLEffect::SetFloatArray(const char* name, const float* values, GLsizei count)
 {
-	Uniform test;
-	strcpy(test.Name, name);
-
-	size_t id = uniforms.find(test);
+	size_t id = uniforms.find(name);
 
 	if( id < uniforms.size() )
 	{
-		const Uniform& uni = uniforms[id];
+		const Uniform& uni = uniforms.value(id);
 		float* reg = (floatvalues + uni.StartRegister * 4);
 
 		if( count > uni.RegisterCount )
@@ -1148,14 +1133,11 @@ void OpenGLEffect::SetFloatArray(const char* name, const float* values, GLsizei
 
 void OpenGLEffect::SetInt(const char* name, int value)
 {
-	Uniform test;
-	strcpy(test.Name, name);
-
-	size_t id = uniforms.find(test);
+	size_t id = uniforms.find(name);
 
 	if( id < uniforms.size() )
 	{
-		const Uniform& uni = uniforms[id];
+		const Uniform& uni = uniforms.value(id);
 		int* reg = (intvalues + uni.StartRegister * 4);
 
 		reg[0] = value;
@@ -1165,13 +1147,10 @@ void OpenGLEffect::SetInt(const char* name, int value)
 
 void OpenGLEffect::SetUniformBlockBinding(const char* name, GLint binding)
 {
-	UniformBlock temp;
-	strcpy(temp.Name, name);
-
-	size_t pos = uniformblocks.find(temp);
+	size_t pos = uniformblocks.find(name);
 
 	if( pos != UniformBlockTable::npos ) {
-		const UniformBlock& block = uniformblocks[pos];
+		const UniformBlock& block = uniformblocks.value(pos);
 
 		block.Binding = binding;
 		glUniformBlockBinding(program, block.Index, binding);
@@ -7,7 +7,7 @@
 #include <map>
 
 #include "../extern/qglextensions.h"
-#include "orderedarray.hpp"
+#include "orderedmap.hpp"
 #include "3Dmath.h"
 
 #ifndef WCHAR
@@ -288,33 +288,24 @@ class OpenGLEffect
 
 	struct Uniform
 	{
-		char	Name[32];
 		GLint	StartRegister;
 		GLint	RegisterCount;
 		GLint	Location;
 		GLenum	Type;
 
 		mutable bool Changed;
-
-		inline bool operator <(const Uniform& other) const {
-			return (0 > strcmp(Name, other.Name));
-		}
 	};
 
 	struct UniformBlock
 	{
-		char			Name[32];
 		GLint			Index;
 		mutable GLint	Binding;
 		GLint			BlockSize;
-
-		inline bool operator <(const UniformBlock& other) const {
-			return (0 > strcmp(Name, other.Name));
-		}
 	};
 
-	typedef mystl::orderedarray<Uniform> UniformTable;
-	typedef mystl::orderedarray<UniformBlock> UniformBlockTable;
+	// names are kept apart from the data, lookups only touch the names
+	typedef mystl::orderedmap<std::string, Uniform, mystl::string_less> UniformTable;
+	typedef mystl::orderedmap<std::string, UniformBlock, mystl::string_less> UniformBlockTable;
 
 private:
 	UniformTable		uniforms;
@@ -2,6 +2,9 @@
 #ifndef _ORDEREDARRAY_HPP_
 #define _ORDEREDARRAY_HPP_
 
+#include <vector>
+#include <algorithm>
+
 #include "functional.hpp"
 
 namespace mystl
@@ -15,6 +18,9 @@ namespace mystl
 		size_t mysize;
 
 		size_t _find(const value_type& value) const;
+		size_t _prepare(const value_type& value);
+
+		void _makeroom(size_t index);
 
 	public:
 		typedef std::pair<size_t, bool> pairib;
@@ -25,9 +31,22 @@ namespace mystl
 
 		orderedarray();
 		orderedarray(const orderedarray& other);
+		orderedarray(orderedarray&& other);
+
+		template <typename input_iterator>
+		orderedarray(input_iterator first, input_iterator last);
+
 		~orderedarray();
 
 		pairib insert(const value_type& value);
+		pairib insert(value_type&& value);
+
+		template <typename arg_type>
+		pairib emplace(arg_type&& arg);
+
+		// sorts the range and merges it in one pass, duplicates are dropped
+		template <typename input_iterator>
+		size_t insert_range(input_iterator first, input_iterator last);
 
 		void erase(const value_type& value);
 		void erase_at(size_t index);
@@ -41,6 +60,7 @@ namespace mystl
 		size_t upper_bound(const value_type& value) const;
 
 		orderedarray& operator =(const orderedarray& other);
+		orderedarray& operator =(orderedarray&& other);
 	
 		inline const value_type& operator [](size_t index) const {
 			return data[index];
@@ -78,6 +98,29 @@ namespace mystl
 
 		this->operator =(other);
 	}
+
+	template <typename value_type, typename compare>
+	orderedarray<value_type, compare>::orderedarray(orderedarray&& other)
+	{
+		data = other.data;
+		mysize = other.mysize;
+		mycap = other.mycap;
+
+		other.data = 0;
+		other.mysize = 0;
+		other.mycap = 0;
+	}
+	
+	template <typename value_type, typename compare>
+	template <typename input_iterator>
+	orderedarray<value_type, compare>::orderedarray(input_iterator first, input_iterator last)
+	{
+		data = 0;
+		mysize = 0;
+		mycap = 0;
+
+		insert_range(first, last);
+	}
 	
 	template <typename value_type, typename compare>
 	orderedarray<value_type, compare>::~orderedarray()
@@ -108,52 +151,146 @@ namespace mystl
 	}
 	
 	template <typename value_type, typename compare>
-	typename orderedarray<value_type, compare>::pairib orderedarray<value_type, compare>::insert(const value_type& value)
+	void orderedarray<value_type, compare>::_makeroom(size_t index)
 	{
-		size_t i = 0;
+		// leaves an uninitialized slot at index
+		size_t count = (mysize - index);
 
-		reserve(mysize + 1);
+		if( is_trivially_relocatable<value_type>::value )
+		{
+			memmove((void*)(data + index + 1), (const void*)(data + index), count * sizeof(value_type));
+		}
+		else if( count > 0 )
+		{
+			new(data + mysize) value_type(std::move(data[mysize - 1]));
+
+			for( size_t j = count - 1; j > 0; --j )
+				data[index + j] = std::move(data[index + j - 1]);
+
+			(data + index)->~value_type();
+		}
+	}
+
+	template <typename value_type, typename compare>
+	size_t orderedarray<value_type, compare>::_prepare(const value_type& value)
+	{
+		size_t i = 0;
 
 		if( mysize > 0 )
 		{
 			i = _find(value);
 
 			if( i < mysize && !(comp(data[i], value) || comp(value, data[i])) )
-				return pairib(SIZE_MAX, false);
+				return npos;
+		}
 
-			size_t count = (mysize - i);
-			new(data + mysize) value_type;
+		if( mysize == mycap )
+			reserve(std::max<size_t>(mycap * 2, mysize + 1));
 
-			for( size_t j = count; j > 0; --j )
-				data[i + j] = data[i + j - 1];
-		}
-		else
-			new(data) value_type;
+		_makeroom(i);
+		return i;
+	}
 
-		data[i] = value;
+	template <typename value_type, typename compare>
+	typename orderedarray<value_type, compare>::pairib orderedarray<value_type, compare>::insert(const value_type& value)
+	{
+		size_t i = _prepare(value);
+
+		if( i == npos )
+			return pairib(SIZE_MAX, false);
+
+		new(data + i) value_type(value);
 		++mysize;
 
 		return pairib(i, true);
 	}
+
+	template <typename value_type, typename compare>
+	typename orderedarray<value_type, compare>::pairib orderedarray<value_type, compare>::insert(value_type&& value)
+	{
+		size_t i = _prepare(value);
+
+		if( i == npos )
+			return pairib(SIZE_MAX, false);
+
+		new(data + i) value_type(std::move(value));
+		++mysize;
+
+		return pairib(i, true);
+	}
+
+	template <typename value_type, typename compare>
+	template <typename arg_type>
+	typename orderedarray<value_type, compare>::pairib orderedarray<value_type, compare>::emplace(arg_type&& arg)
+	{
+		// the position depends on the value, so it has to be constructed first
+		value_type value(std::forward<arg_type>(arg));
+		return insert(std::move(value));
+	}
 	
 	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::erase(const value_type& value)
+	template <typename input_iterator>
+	size_t orderedarray<value_type, compare>::insert_range(input_iterator first, input_iterator last)
 	{
-		size_t i = find(value);
+		std::vector<value_type> batch(first, last);
 
-		if( i != npos )
-		{
-			size_t count = (mysize - i) - 1;
+		if( batch.empty() )
+			return 0;
 
-			for( size_t j = 0; j < count; ++j )
-				data[i + j] = data[i + j + 1];
+		// stable, so that the first of equal elements is kept (like with insert())
+		std::stable_sort(batch.begin(), batch.end(), comp);
 
-			(data + i + count)->~value_type();
-			--mysize;
+		size_t newcap = std::max<size_t>(mycap, mysize + batch.size());
+		value_type* newdata = (value_type*)malloc(newcap * sizeof(value_type));
+		value_type* out = newdata;
+		size_t i = 0;
+		size_t j = 0;
 
-			if( mysize == 0 )
-				clear();
+		// existing elements come first among equals
+		while( i < mysize || j < batch.size() )
+		{
+			if( j == batch.size() || (i < mysize && !comp(batch[j], data[i])) )
+			{
+				new(out) value_type(std::move(data[i]));
+
+				++out;
+				++i;
+			}
+			else
+			{
+				if( out == newdata || comp(*(out - 1), batch[j]) )
+				{
+					new(out) value_type(std::move(batch[j]));
+					++out;
+				}
+
+				++j;
+			}
 		}
+
+		size_t newsize = (size_t)(out - newdata);
+		size_t count = newsize - mysize;
+
+		for( size_t k = 0; k < mysize; ++k )
+			(data + k)->~value_type();
+
+		if( data )
+			free(data);
+
+		data = newdata;
+		mysize = newsize;
+		mycap = newcap;
+
+		return count;
+	}
+	
+	template <typename value_type, typename compare>
+	void orderedarray<value_type, compare>::erase(const value_type& value)
+	{
+		size_t i = find(value);
+
+		if( i != npos )
+			erase_at(i);
 	}
 	
 	template <typename value_type, typename compare>
@@ -163,10 +300,19 @@ namespace mystl
 		{
 			size_t count = (mysize - index) - 1;
 
-			for( size_t j = 0; j < count; ++j )
-				data[index + j] = data[index + j + 1];
+			if( is_trivially_relocatable<value_type>::value )
+			{
+				(data + index)->~value_type();
+				memmove((void*)(data + index), (const void*)(data + index + 1), count * sizeof(value_type));
+			}
+			else
+			{
+				for( size_t j = 0; j < count; ++j )
+					data[index + j] = std::move(data[index + j + 1]);
+
+				(data + index + count)->~value_type();
+			}
 
-			(data + index + count)->~value_type();
 			--mysize;
 
 			if( mysize == 0 )
@@ -182,18 +328,27 @@ namespace mystl
 			size_t diff = newcap - mycap;
 			diff = std::max<size_t>(diff, 10);
 
-			value_type* newdata = (value_type*)malloc((mycap + diff) * sizeof(value_type));
+			if( is_trivially_relocatable<value_type>::value )
+			{
+				// no need to touch the elements one by one
+				data = (value_type*)realloc((void*)data, (mycap + diff) * sizeof(value_type));
+			}
+			else
+			{
+				value_type* newdata = (value_type*)malloc((mycap + diff) * sizeof(value_type));
 
-			for( size_t i = 0; i < mysize; ++i )
-				new(newdata + i) value_type(data[i]);
+				for( size_t i = 0; i < mysize; ++i )
+					new(newdata + i) value_type(std::move(data[i]));
 
-			for( size_t i = 0; i < mysize; ++i )
-				(data + i)->~value_type();
+				for( size_t i = 0; i < mysize; ++i )
+					(data + i)->~value_type();
 
-			if( data )
-				free(data);
+				if( data )
+					free(data);
+
+				data = newdata;
+			}
 
-			data = newdata;
 			mycap = mycap + diff;
 		}
 	}
@@ -248,7 +403,7 @@ namespace mystl
 		{
 			size_t ind = _find(value);
 
-			if( !(comp(data[ind], value) || comp(value, data[ind])) )
+			if( ind < mysize && !(comp(data[ind], value) || comp(value, data[ind])) )
 				return ind;
 			else if( ind > 0 )
 				return ind - 1;
@@ -275,8 +430,28 @@ namespace mystl
 		reserve(other.mycap);
 		mysize = other.mysize;
 
-		for( size_t i = 0; i < mysize; ++i )
-			new(data + i) value_type(other.data[i]);
+		if( is_trivially_relocatable<value_type>::value )
+		{
+			if( mysize > 0 )
+				memcpy((void*)data, (const void*)other.data, mysize * sizeof(value_type));
+		}
+		else
+		{
+			for( size_t i = 0; i < mysize; ++i )
+				new(data + i) value_type(other.data[i]);
+		}
+
+		return *this;
+	}
+
+	template <typename value_type, typename compare>
+	orderedarray<value_type, compare>& orderedarray<value_type, compare>::operator =(orderedarray&& other)
+	{
+		if( &other != this )
+		{
+			destroy();
+			swap(other);
+		}
 
 		return *this;
 	}
@@ -0,0 +1,553 @@
+
+#ifndef _ORDEREDMAP_HPP_
+#define _ORDEREDMAP_HPP_
+
+#include <vector>
+#include <algorithm>
+
+#include "functional.hpp"
+
+namespace mystl
+{
+	// sorted multimap; keys and values are stored in separate arrays, so searches don't touch the values
+	template <typename key_type, typename value_type, typename compare = default_less<key_type> >
+	class orderedmap
+	{
+	private:
+		struct pair_compare
+		{
+			compare comp;
+
+			pair_compare(const compare& c)
+				: comp(c) {}
+
+			inline bool operator ()(const std::pair<key_type, value_type>& a, const std::pair<key_type, value_type>& b) const {
+				return comp(a.first, b.first);
+			}
+		};
+
+		key_type* keys;
+		value_type* values;
+		size_t mycap;
+		size_t mysize;
+
+		template <typename lookup_type>
+		size_t _lower(const lookup_type& key) const;
+
+		template <typename lookup_type>
+		size_t _upper(const lookup_type& key) const;
+
+		size_t _prepare(size_t index);
+
+		template <typename T>
+		static void _makeroom(T* data, size_t size, size_t index);
+
+		template <typename T>
+		static void _remove(T* data, size_t size, size_t first, size_t last);
+
+		template <typename T>
+		static T* _realloc(T* data, size_t size, size_t newcap);
+
+	public:
+		typedef std::pair<size_t, size_t> pairii;
+		static const size_t npos = 0xffffffff;
+
+		compare comp;
+
+		orderedmap();
+		orderedmap(const orderedmap& other);
+		orderedmap(orderedmap&& other);
+
+		// the range has to contain pairs (anything with first and second)
+		template <typename input_iterator>
+		orderedmap(input_iterator first, input_iterator last);
+
+		~orderedmap();
+
+		size_t insert(const key_type& key, const value_type& value);
+		size_t insert(key_type&& key, value_type&& value);
+
+		// sorts the range and merges it in one pass
+		template <typename input_iterator>
+		size_t insert_range(input_iterator first, input_iterator last);
+
+		template <typename lookup_type>
+		void erase(const lookup_type& key);
+
+		void erase_at(size_t index);
+		void reserve(size_t newcap);
+		void destroy();
+		void clear();
+		void swap(orderedmap& other);
+
+		// lookup_type can be anything that compare accepts on both sides
+		template <typename lookup_type>
+		pairii equal_range(const lookup_type& key) const;
+
+		template <typename lookup_type>
+		size_t find(const lookup_type& key) const;
+
+		template <typename lookup_type>
+		size_t lower_bound(const lookup_type& key) const;
+
+		template <typename lookup_type>
+		size_t upper_bound(const lookup_type& key) const;
+
+		orderedmap& operator =(const orderedmap& other);
+		orderedmap& operator =(orderedmap&& other);
+
+		inline const key_type& key(size_t index) const {
+			return keys[index];
+		}
+
+		// the order doesn't depend on the values, so they can be modified
+		inline value_type& value(size_t index) {
+			return values[index];
+		}
+
+		inline const value_type& value(size_t index) const {
+			return values[index];
+		}
+
+		inline size_t size() const {
+			return mysize;
+		}
+
+		inline size_t capacity() const {
+			return mycap;
+		}
+	};
+
+	template <typename key_type, typename value_type, typename compare>
+	orderedmap<key_type, value_type, compare>::orderedmap()
+	{
+		keys = 0;
+		values = 0;
+		mysize = 0;
+		mycap = 0;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	orderedmap<key_type, value_type, compare>::orderedmap(const orderedmap& other)
+	{
+		keys = 0;
+		values = 0;
+		mysize = 0;
+		mycap = 0;
+
+		this->operator =(other);
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	orderedmap<key_type, value_type, compare>::orderedmap(orderedmap&& other)
+	{
+		keys = other.keys;
+		values = other.values;
+		mysize = other.mysize;
+		mycap = other.mycap;
+		comp = other.comp;
+
+		other.keys = 0;
+		other.values = 0;
+		other.mysize = 0;
+		other.mycap = 0;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename input_iterator>
+	orderedmap<key_type, value_type, compare>::orderedmap(input_iterator first, input_iterator last)
+	{
+		keys = 0;
+		values = 0;
+		mysize = 0;
+		mycap = 0;
+
+		insert_range(first, last);
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	orderedmap<key_type, value_type, compare>::~orderedmap()
+	{
+		destroy();
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename lookup_type>
+	size_t orderedmap<key_type, value_type, compare>::_lower(const lookup_type& key) const
+	{
+		// first that is not less
+		size_t low = 0;
+		size_t high = mysize;
+		size_t mid;
+
+		while( low < high )
+		{
+			mid = (low + high) / 2;
+
+			if( comp(keys[mid], key) )
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		return low;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename lookup_type>
+	size_t orderedmap<key_type, value_type, compare>::_upper(const lookup_type& key) const
+	{
+		// first that is greater
+		size_t low = 0;
+		size_t high = mysize;
+		size_t mid;
+
+		while( low < high )
+		{
+			mid = (low + high) / 2;
+
+			if( comp(key, keys[mid]) )
+				high = mid;
+			else
+				low = mid + 1;
+		}
+
+		return low;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename T>
+	void orderedmap<key_type, value_type, compare>::_makeroom(T* data, size_t size, size_t index)
+	{
+		// leaves an uninitialized slot at index
+		size_t count = (size - index);
+
+		if( is_trivially_relocatable<T>::value )
+		{
+			memmove((void*)(data + index + 1), (const void*)(data + index), count * sizeof(T));
+		}
+		else if( count > 0 )
+		{
+			new(data + size) T(std::move(data[size - 1]));
+
+			for( size_t j = count - 1; j > 0; --j )
+				data[index + j] = std::move(data[index + j - 1]);
+
+			(data + index)->~T();
+		}
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename T>
+	void orderedmap<key_type, value_type, compare>::_remove(T* data, size_t size, size_t first, size_t last)
+	{
+		size_t count = (size - last);
+
+		if( is_trivially_relocatable<T>::value )
+		{
+			for( size_t i = first; i < last; ++i )
+				(data + i)->~T();
+
+			memmove((void*)(data + first), (const void*)(data + last), count * sizeof(T));
+		}
+		else
+		{
+			for( size_t j = 0; j < count; ++j )
+				data[first + j] = std::move(data[last + j]);
+
+			for( size_t i = first + count; i < size; ++i )
+				(data + i)->~T();
+		}
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename T>
+	T* orderedmap<key_type, value_type, compare>::_realloc(T* data, size_t size, size_t newcap)
+	{
+		if( is_trivially_relocatable<T>::value )
+			return (T*)realloc((void*)data, newcap * sizeof(T));
+
+		T* newdata = (T*)malloc(newcap * sizeof(T));
+
+		for( size_t i = 0; i < size; ++i )
+			new(newdata + i) T(std::move(data[i]));
+
+		for( size_t i = 0; i < size; ++i )
+			(data + i)->~T();
+
+		if( data )
+			free(data);
+
+		return newdata;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	size_t orderedmap<key_type, value_type, compare>::_prepare(size_t index)
+	{
+		if( mysize == mycap )
+			reserve(std::max<size_t>(mycap * 2, mysize + 1));
+
+		_makeroom(keys, mysize, index);
+		_makeroom(values, mysize, index);
+
+		return index;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	size_t orderedmap<key_type, value_type, compare>::insert(const key_type& key, const value_type& value)
+	{
+		// after the equal ones, so that they keep their order of insertion
+		size_t i = _prepare(_upper(key));
+
+		new(keys + i) key_type(key);
+		new(values + i) value_type(value);
+
+		++mysize;
+		return i;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	size_t orderedmap<key_type, value_type, compare>::insert(key_type&& key, value_type&& value)
+	{
+		size_t i = _prepare(_upper(key));
+
+		new(keys + i) key_type(std::move(key));
+		new(values + i) value_type(std::move(value));
+
+		++mysize;
+		return i;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename input_iterator>
+	size_t orderedmap<key_type, value_type, compare>::insert_range(input_iterator first, input_iterator last)
+	{
+		std::vector<std::pair<key_type, value_type> > batch;
+
+		for( ; first != last; ++first )
+			batch.push_back(std::pair<key_type, value_type>(first->first, first->second));
+
+		if( batch.empty() )
+			return 0;
+
+		// stable, so that equal keys keep their order of insertion
+		std::stable_sort(batch.begin(), batch.end(), pair_compare(comp));
+
+		size_t newcap = std::max<size_t>(mycap, mysize + batch.size());
+		key_type* newkeys = (key_type*)malloc(newcap * sizeof(key_type));
+		value_type* newvalues = (value_type*)malloc(newcap * sizeof(value_type));
+		size_t out = 0;
+		size_t i = 0;
+		size_t j = 0;
+
+		// existing elements come first among equals
+		while( i < mysize || j < batch.size() )
+		{
+			if( j == batch.size() || (i < mysize && !comp(batch[j].first, keys[i])) )
+			{
+				new(newkeys + out) key_type(std::move(keys[i]));
+				new(newvalues + out) value_type(std::move(values[i]));
+
+				++i;
+			}
+			else
+			{
+				new(newkeys + out) key_type(std::move(batch[j].first));
+				new(newvalues + out) value_type(std::move(batch[j].second));
+
+				++j;
+			}
+
+			++out;
+		}
+
+		size_t count = out - mysize;
+
+		for( size_t k = 0; k < mysize; ++k )
+		{
+			(keys + k)->~key_type();
+			(values + k)->~value_type();
+		}
+
+		if( keys )
+			free(keys);
+
+		if( values )
+			free(values);
+
+		keys = newkeys;
+		values = newvalues;
+		mysize = out;
+		mycap = newcap;
+
+		return count;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename lookup_type>
+	void orderedmap<key_type, value_type, compare>::erase(const lookup_type& key)
+	{
+		pairii p = equal_range(key);
+
+		if( p.first != npos )
+		{
+			_remove(keys, mysize, p.first, p.second);
+			_remove(values, mysize, p.first, p.second);
+
+			mysize -= (p.second - p.first);
+		}
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	void orderedmap<key_type, value_type, compare>::erase_at(size_t index)
+	{
+		if( index < mysize )
+		{
+			_remove(keys, mysize, index, index + 1);
+			_remove(values, mysize, index, index + 1);
+
+			--mysize;
+		}
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	void orderedmap<key_type, value_type, compare>::reserve(size_t newcap)
+	{
+		if( mycap < newcap )
+		{
+			size_t diff = newcap - mycap;
+			diff = std::max<size_t>(diff, 10);
+
+			keys = _realloc(keys, mysize, mycap + diff);
+			values = _realloc(values, mysize, mycap + diff);
+
+			mycap = mycap + diff;
+		}
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	void orderedmap<key_type, value_type, compare>::destroy()
+	{
+		clear();
+
+		if( keys )
+			free(keys);
+
+		if( values )
+			free(values);
+
+		keys = 0;
+		values = 0;
+		mysize = 0;
+		mycap = 0;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	void orderedmap<key_type, value_type, compare>::clear()
+	{
+		for( size_t i = 0; i < mysize; ++i )
+		{
+			(keys + i)->~key_type();
+			(values + i)->~value_type();
+		}
+
+		mysize = 0;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	void orderedmap<key_type, value_type, compare>::swap(orderedmap& other)
+	{
+		if( &other == this )
+			return;
+
+		std::swap(mycap, other.mycap);
+		std::swap(mysize, other.mysize);
+		std::swap(keys, other.keys);
+		std::swap(values, other.values);
+		std::swap(comp, other.comp);
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename lookup_type>
+	typename orderedmap<key_type, value_type, compare>::pairii
+	orderedmap<key_type, value_type, compare>::equal_range(const lookup_type& key) const
+	{
+		pairii range;
+
+		range.first = _lower(key);
+		range.second = npos;
+
+		if( range.first < mysize && !comp(key, keys[range.first]) )
+			range.second = _upper(key);
+		else
+			range.first = npos;
+
+		return range;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename lookup_type>
+	size_t orderedmap<key_type, value_type, compare>::find(const lookup_type& key) const
+	{
+		// returns the first of the equal ones
+		size_t ind = _lower(key);
+
+		if( ind < mysize && !comp(key, keys[ind]) )
+			return ind;
+
+		return npos;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename lookup_type>
+	size_t orderedmap<key_type, value_type, compare>::lower_bound(const lookup_type& key) const
+	{
+		// returns the first that is greater or equal
+		size_t ind = _lower(key);
+		return (ind < mysize ? ind : npos);
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	template <typename lookup_type>
+	size_t orderedmap<key_type, value_type, compare>::upper_bound(const lookup_type& key) const
+	{
+		// returns the first that is greater
+		size_t ind = _upper(key);
+		return (ind < mysize ? ind : npos);
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	orderedmap<key_type, value_type, compare>& orderedmap<key_type, value_type, compare>::operator =(const orderedmap& other)
+	{
+		if( &other == this )
+			return *this;
+
+		clear();
+
+		reserve(other.mycap);
+		mysize = other.mysize;
+		comp = other.comp;
+
+		for( size_t i = 0; i < mysize; ++i )
+		{
+			new(keys + i) key_type(other.keys[i]);
+			new(values + i) value_type(other.values[i]);
+		}
+
+		return *this;
+	}
+
+	template <typename key_type, typename value_type, typename compare>
+	orderedmap<key_type, value_type, compare>& orderedmap<key_type, value_type, compare>::operator =(orderedmap&& other)
+	{
+		if( &other != this )
+		{
+			destroy();
+			swap(other);
+		}
+
+		return *this;
+	}
+}
+
+#endif
@@ -0,0 +1,215 @@
+
+#include "threadpool.h"
+
+#ifndef _WIN32
+#	include <unistd.h>
+#endif
+
+threadpool::threadpool()
+{
+	task		= 0;
+	taskarg		= 0;
+	numchunks	= 0;
+	nextchunk	= 0;
+	pending		= 0;
+	quit		= false;
+
+#ifdef _WIN32
+	InitializeCriticalSection(&guard);
+	InitializeConditionVariable(&workready);
+	InitializeConditionVariable(&workdone);
+#else
+	pthread_mutex_init(&guard, NULL);
+	pthread_cond_init(&workready, NULL);
+	pthread_cond_init(&workdone, NULL);
+#endif
+}
+
+threadpool::~threadpool()
+{
+	destroy();
+
+#ifdef _WIN32
+	DeleteCriticalSection(&guard);
+#else
+	pthread_cond_destroy(&workdone);
+	pthread_cond_destroy(&workready);
+	pthread_mutex_destroy(&guard);
+#endif
+}
+
+void threadpool::lock()
+{
+#ifdef _WIN32
+	EnterCriticalSection(&guard);
+#else
+	pthread_mutex_lock(&guard);
+#endif
+}
+
+void threadpool::unlock()
+{
+#ifdef _WIN32
+	LeaveCriticalSection(&guard);
+#else
+	pthread_mutex_unlock(&guard);
+#endif
+}
+
+void threadpool::wait(bool done)
+{
+#ifdef _WIN32
+	SleepConditionVariableCS((done ? &workdone : &workready), &guard, INFINITE);
+#else
+	pthread_cond_wait((done ? &workdone : &workready), &guard);
+#endif
+}
+
+void threadpool::wake(bool done)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable(done ? &workdone : &workready);
+#else
+	pthread_cond_broadcast(done ? &workdone : &workready);
+#endif
+}
+
+#ifdef _WIN32
+unsigned long __stdcall threadpool::Run(void* param)
+#else
+void* threadpool::Run(void* param)
+#endif
+{
+	worker* w = reinterpret_cast<worker*>(param);
+	w->pool->process(w->index);
+
+	return 0;
+}
+
+void threadpool::process(int thread)
+{
+	int chunk;
+
+	lock();
+
+	while( !quit )
+	{
+		if( nextchunk >= numchunks )
+		{
+			wait(false);
+			continue;
+		}
+
+		chunk = nextchunk++;
+		unlock();
+
+		task(taskarg, chunk, thread);
+
+		lock();
+
+		if( --pending == 0 )
+			wake(true);
+	}
+
+	unlock();
+}
+
+void threadpool::create(int numthreads)
+{
+	destroy();
+
+	if( numthreads <= 0 )
+		return;
+
+	quit = false;
+
+	threads.resize(numthreads);
+	workers.resize(numthreads);
+
+	for( int i = 0; i < numthreads; ++i )
+	{
+		workers[i].pool = this;
+		workers[i].index = i;
+
+#ifdef _WIN32
+		threads[i] = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)&threadpool::Run, &workers[i], 0, NULL);
+#else
+		pthread_create(&threads[i], NULL, &threadpool::Run, &workers[i]);
+#endif
+	}
+}
+
+void threadpool::destroy()
+{
+	if( threads.empty() )
+		return;
+
+	lock();
+	{
+		quit = true;
+		wake(false);
+	}
+	unlock();
+
+	for( size_t i = 0; i < threads.size(); ++i )
+	{
+#ifdef _WIN32
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i], NULL);
+#endif
+	}
+
+	threads.clear();
+	workers.clear();
+}
+
+void threadpool::run(task_func func, void* arg, int chunks)
+{
+	int chunk;
+	int self = size();
+
+	lock();
+	{
+		task		= func;
+		taskarg		= arg;
+		numchunks	= chunks;
+		nextchunk	= 0;
+		pending		= chunks;
+
+		wake(false);
+
+		// do some work too
+		while( nextchunk < numchunks )
+		{
+			chunk = nextchunk++;
+			unlock();
+
+			task(taskarg, chunk, self);
+
+			lock();
+			--pending;
+		}
+
+		while( pending > 0 )
+			wait(true);
+
+		numchunks = 0;
+		nextchunk = 0;
+	}
+	unlock();
+}
+
+int threadpool::numcores()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count > 0 ? (int)count : 1);
+#endif
+}
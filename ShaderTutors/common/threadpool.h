@@ -0,0 +1,84 @@
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <Windows.h>
+#else
+#	include <pthread.h>
+#endif
+
+#include <vector>
+
+class threadpool
+{
+public:
+	// process one chunk of the work on the given thread (0 <= thread <= size())
+	typedef void (*task_func)(void* arg, int chunk, int thread);
+
+private:
+	struct worker
+	{
+		threadpool* pool;
+		int index;
+	};
+
+#ifdef _WIN32
+	typedef HANDLE thread_handle;
+
+	CRITICAL_SECTION	guard;
+	CONDITION_VARIABLE	workready;
+	CONDITION_VARIABLE	workdone;
+
+	static unsigned long __stdcall Run(void* param);
+#else
+	typedef pthread_t thread_handle;
+
+	pthread_mutex_t		guard;
+	pthread_cond_t		workready;
+	pthread_cond_t		workdone;
+
+	static void* Run(void* param);
+#endif
+
+	std::vector<thread_handle>	threads;
+	std::vector<worker>			workers;
+
+	task_func	task;
+	void*		taskarg;
+	int			numchunks;
+	int			nextchunk;
+	int			pending;
+	bool		quit;
+
+	void lock();
+	void unlock();
+	void wait(bool done);
+	void wake(bool done);
+
+	void process(int thread);
+
+public:
+	threadpool();
+	~threadpool();
+
+	void create(int numthreads);
+	void destroy();
+
+	// blocks until all chunks are processed; the calling thread helps
+	void run(task_func func, void* arg, int chunks);
+
+	inline int size() const {
+		return (int)threads.size();
+	}
+
+	static int numcores();
+};
+
+#endif
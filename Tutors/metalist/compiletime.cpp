@@ -0,0 +1,143 @@
+//=============================================================================================================
+// Compile time benchmark for the metalist; measure the build time of this file:
+//
+//   cl /c /O2 compiletime.cpp                        (or g++ -c -O2 compiletime.cpp)
+//   cl /c /O2 /DLINEAR_LOOKUP compiletime.cpp        (uses the old recursive type_at and index_of)
+//
+// NUM_TYPES can be any power of two from 8 to 256.
+//=============================================================================================================
+
+#include <iostream>
+
+#include "mtlist.hpp"
+
+#ifndef NUM_TYPES
+#	define NUM_TYPES	128
+#endif
+
+template <int n>
+struct item
+{
+	int value;
+};
+
+// build the list from blocks of 8 types (no deep recursion here)
+template <int n, typename tail>
+struct block8
+{
+	typedef
+		typelist<item<n>, typelist<item<n + 1>, typelist<item<n + 2>, typelist<item<n + 3>,
+		typelist<item<n + 4>, typelist<item<n + 5>, typelist<item<n + 6>, typelist<item<n + 7>, tail> > > > > > > >
+		value;
+};
+
+template <int n, int count, typename tail = void>
+struct block
+{
+	typedef typename block<n + count / 2, count / 2, tail>::value second;
+	typedef typename block<n, count / 2, second>::value value;
+};
+
+template <int n, typename tail>
+struct block<n, 8, tail>
+{
+	typedef typename block8<n, tail>::value value;
+};
+
+typedef block<0, NUM_TYPES>::value biglist;
+
+/**
+ * \brief The original recursive versions, for comparison
+ */
+template <typename ml, int index>
+struct linear_type_at
+{
+	typedef typename linear_type_at<typename ml::tail, index - 1>::value value;
+};
+
+template <typename ml>
+struct linear_type_at<ml, 0>
+{
+	typedef typename ml::head value;
+};
+
+template <typename ml, typename type>
+struct linear_index_of
+{
+	enum { value = linear_index_of<typename ml::tail, type>::value + 1 };
+};
+
+template <typename type, typename _tail>
+struct linear_index_of<typelist<type, _tail>, type>
+{
+	enum { value = 0 };
+};
+
+#ifdef LINEAR_LOOKUP
+#	define TYPE_AT	linear_type_at
+#	define INDEX_OF	linear_index_of
+#else
+#	define TYPE_AT	type_at
+#	define INDEX_OF	index_of
+#endif
+
+/**
+ * \brief Looks up every type of the list, and finds it again by index_of
+ */
+template <typename ml, int index>
+struct check_all
+{
+	typedef typename TYPE_AT<ml, index>::value value_type;
+
+	static_assert(INDEX_OF<ml, value_type>::value == index, "check_all: index_of is wrong");
+
+	static void push(mtlist<ml>& list) {
+		check_all<ml, index - 1>::push(list);
+
+		value_type v = { index };
+		list.push_back(v);
+	}
+};
+
+template <typename ml>
+struct check_all<ml, -1>
+{
+	static void push(mtlist<ml>&) {}
+};
+
+struct Sum
+{
+	int sum;
+
+	Sum()
+		: sum(0) {}
+
+	template <int n>
+	void add(typename mtlist<biglist>::iterator& it) {
+		if( item<n>* p = it.template get_ptr<item<n> >() )
+			sum += p->value;
+	}
+};
+
+int main()
+{
+	mtlist<biglist> list;
+
+	check_all<biglist, length<biglist>::value - 1>::push(list);
+
+	Sum s;
+	int count = 0;
+
+	for( mtlist<biglist>::iterator it = list.begin(); it != list.end(); ++it )
+	{
+		s.add<0>(it);
+		s.add<NUM_TYPES - 1>(it);
+
+		++count;
+	}
+
+	std::cout << length<biglist>::value << " types, " << count << " elements, sum = " << s.sum << "\n";
+	return 0;
+}
+
+//=============================================================================================================
@@ -1,17 +1,49 @@
 
 #include <iostream>
 #include <string>
+#include <ctime>
+#include <typeinfo>
 
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
 
 #include "mtlist.hpp"
+#include "mtarray.hpp"
+
+#define NUM_MIXED_ELEMENTS	3000000
 
 struct Apple
 {
 	std::string name;
 };
 
+struct PrintVisitor
+{
+	void operator ()(int i)				{ std::cout << i << "\n"; }
+	void operator ()(float f)			{ std::cout << f << "\n"; }
+	void operator ()(const Apple& a)	{ std::cout << a.name << "\n"; }
+};
+
+struct CountVisitor
+{
+	template <typename value_type>
+	void operator ()(const std::vector<value_type>& arr) {
+		std::cout << typeid(value_type).name() << ": " << arr.size() << " elements\n";
+	}
+};
+
+struct SumVisitor
+{
+	double sum;
+
+	SumVisitor()
+		: sum(0) {}
+
+	void operator ()(int i)				{ sum += i; }
+	void operator ()(float f)			{ sum += f; }
+	void operator ()(const Apple& a)	{ sum += a.name.size(); }
+};
+
 int main()
 {
 	{
@@ -42,6 +74,80 @@ int main()
 		}
 	}
 
+	{
+		typedef mtarray<TL3(int, float, Apple), true> meta3_ifA;
+		meta3_ifA a1;
+
+		Apple a;
+		a.name = "apple";
+
+		a1.push_back(a);
+		a1.push_back(5);
+		a1.push_back(3.5f);
+		a1.push_back(2);
+		a1.push_back(0.1f);
+
+		PrintVisitor printer;
+		CountVisitor counter;
+
+		std::cout << "\nby type:\n";
+		a1.for_each(printer);
+
+		std::cout << "\nin order:\n";
+		a1.for_each_ordered(printer);
+
+		std::cout << "\n";
+		a1.for_each_type(counter);
+
+		std::cout << "floats: " << a1.get<float>().size() << "\n";
+	}
+
+	{
+		// iterating a lot of mixed elements
+		typedef mtlist<TL3(int, float, Apple)> mixedlist;
+		typedef mtarray<TL3(int, float, Apple)> mixedarray;
+
+		mixedlist l1;
+		mixedarray a1;
+		Apple a;
+		clock_t start, end;
+
+		a.name = "apple";
+
+		for( int i = 0; i < NUM_MIXED_ELEMENTS; ++i )
+		{
+			switch( i % 3 )
+			{
+			case 0:	l1.push_back(i); a1.push_back(i); break;
+			case 1:	l1.push_back((float)i); a1.push_back((float)i); break;
+			case 2:	l1.push_back(a); a1.push_back(a); break;
+			}
+		}
+
+		SumVisitor listsum, arraysum;
+
+		start = clock();
+
+		for( mixedlist::iterator it = l1.begin(); it != l1.end(); ++it )
+		{
+			if( int* ip = it.get_ptr<int>() )
+				listsum(*ip);
+			else if( float* fp = it.get_ptr<float>() )
+				listsum(*fp);
+			else
+				listsum(it.get<Apple>());
+		}
+
+		end = clock();
+		std::cout << "\nmtlist: " << (end - start) * 1000 / CLOCKS_PER_SEC << " ms (sum = " << listsum.sum << ")\n";
+
+		start = clock();
+		a1.for_each(arraysum);
+
+		end = clock();
+		std::cout << "mtarray: " << (end - start) * 1000 / CLOCKS_PER_SEC << " ms (sum = " << arraysum.sum << ")\n";
+	}
+
 	_CrtDumpMemoryLeaks();
 
 	system("pause");
@@ -0,0 +1,226 @@
+//=============================================================================================================
+#ifndef _MTARRAY_HPP_
+#define _MTARRAY_HPP_
+
+#include <vector>
+#include "typelist.hpp"
+
+/**
+ * \brief Recursive multi-type array (internal)
+ */
+template <typename type_list, int index, bool ordered>
+class _mtarray : public _mtarray<type_list, index - 1, ordered>
+{
+	typedef _mtarray<type_list, index - 1, ordered> base;
+	typedef typename type_at<type_list, index>::value value_type;
+
+protected:
+	std::vector<value_type> items;
+
+	template <typename visitor>
+	void _visit(visitor& v);
+
+	template <typename visitor>
+	void _visit_at(int type, size_t pos, visitor& v);
+
+	size_t _size() const;
+	void _clear();
+
+public:
+	using base::push_back;
+
+	void push_back(const value_type& value);
+};
+
+template <typename type_list, int index, bool ordered>
+template <typename visitor>
+void _mtarray<type_list, index, ordered>::_visit(visitor& v)
+{
+	base::_visit(v);
+	v(items);
+}
+
+template <typename type_list, int index, bool ordered>
+template <typename visitor>
+void _mtarray<type_list, index, ordered>::_visit_at(int type, size_t pos, visitor& v)
+{
+	// unrolled at compile time into a chain of comparisons
+	if( type == index )
+		v(items[pos]);
+	else
+		base::_visit_at(type, pos, v);
+}
+
+template <typename type_list, int index, bool ordered>
+size_t _mtarray<type_list, index, ordered>::_size() const
+{
+	return base::_size() + items.size();
+}
+
+template <typename type_list, int index, bool ordered>
+void _mtarray<type_list, index, ordered>::_clear()
+{
+	base::_clear();
+	items.clear();
+}
+
+template <typename type_list, int index, bool ordered>
+void _mtarray<type_list, index, ordered>::push_back(const value_type& value)
+{
+	if( ordered )
+	{
+		typename base::entry e = { index, items.size() };
+		this->order.push_back(e);
+	}
+
+	items.push_back(value);
+}
+
+/**
+ * \brief Specialized array for the first type (internal)
+ */
+template <typename type_list, bool ordered>
+class _mtarray<type_list, 0, ordered>
+{
+	typedef typename type_at<type_list, 0>::value value_type;
+
+protected:
+	struct entry
+	{
+		int		type;
+		size_t	pos;
+	};
+
+	std::vector<value_type> items;
+	std::vector<entry> order;		// only filled if ordered
+
+	template <typename visitor>
+	void _visit(visitor& v);
+
+	template <typename visitor>
+	void _visit_at(int type, size_t pos, visitor& v);
+
+	size_t _size() const;
+	void _clear();
+
+public:
+	void push_back(const value_type& value);
+};
+
+template <typename type_list, bool ordered>
+template <typename visitor>
+void _mtarray<type_list, 0, ordered>::_visit(visitor& v)
+{
+	v(items);
+}
+
+template <typename type_list, bool ordered>
+template <typename visitor>
+void _mtarray<type_list, 0, ordered>::_visit_at(int, size_t pos, visitor& v)
+{
+	v(items[pos]);
+}
+
+template <typename type_list, bool ordered>
+size_t _mtarray<type_list, 0, ordered>::_size() const
+{
+	return items.size();
+}
+
+template <typename type_list, bool ordered>
+void _mtarray<type_list, 0, ordered>::_clear()
+{
+	items.clear();
+	order.clear();
+}
+
+template <typename type_list, bool ordered>
+void _mtarray<type_list, 0, ordered>::push_back(const value_type& value)
+{
+	if( ordered )
+	{
+		entry e = { 0, items.size() };
+		order.push_back(e);
+	}
+
+	items.push_back(value);
+}
+
+/**
+ * \brief Multi-type container, that stores each type in its own array
+ *
+ * Elements of the same type are next to each other, and visiting
+ * them needs no virtual calls. If ordered is true, the order of
+ * insertion is recorded too.
+ */
+template <typename type_list, bool ordered = false>
+class mtarray : public _mtarray<type_list, length<type_list>::value - 1, ordered>
+{
+	template <typename visitor>
+	struct element_visitor
+	{
+		visitor& v;
+
+		element_visitor(visitor& _v)
+			: v(_v) {}
+
+		template <typename value_type>
+		void operator ()(std::vector<value_type>& arr) {
+			for( size_t i = 0; i < arr.size(); ++i )
+				v(arr[i]);
+		}
+	};
+
+public:
+	//! The array of the given type
+	template <typename value_type>
+	std::vector<value_type>& get() {
+		enum { index = index_of<type_list, value_type>::value };
+		static_assert(index >= 0, "mtarray::get(): type is not in the list");
+
+		// don't instantiate _mtarray<..., -1>, it would recurse until the compiler gives up
+		return _mtarray<type_list, (index < 0 ? 0 : index), ordered>::items;
+	}
+
+	template <typename value_type>
+	const std::vector<value_type>& get() const {
+		enum { index = index_of<type_list, value_type>::value };
+		static_assert(index >= 0, "mtarray::get(): type is not in the list");
+
+		// don't instantiate _mtarray<..., -1>, it would recurse until the compiler gives up
+		return _mtarray<type_list, (index < 0 ? 0 : index), ordered>::items;
+	}
+
+	//! Calls v(std::vector<T>&) for every type
+	template <typename visitor>
+	void for_each_type(visitor& v) {
+		this->_visit(v);
+	}
+
+	//! Calls v(T&) for every element, type by type
+	template <typename visitor>
+	void for_each(visitor& v) {
+		element_visitor<visitor> ev(v);
+		this->_visit(ev);
+	}
+
+	//! Calls v(T&) for every element, in the order of insertion
+	template <typename visitor>
+	void for_each_ordered(visitor& v) {
+		static_assert(ordered, "mtarray::for_each_ordered(): order of insertion is not recorded");
+
+		for( size_t i = 0; i < this->order.size(); ++i )
+			this->_visit_at(this->order[i].type, this->order[i].pos, v);
+	}
+
+	inline size_t size() const {
+		return this->_size();
+	}
+
+	inline void clear() {
+		this->_clear();
+	}
+};
+
+#endif
+//=============================================================================================================
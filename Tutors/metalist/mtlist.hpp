@@ -5,40 +5,14 @@
 #include "typelist.hpp"
 
 /**
- * \brief Recursive multi-type list (internal)
- */
-template <typename type_list, int index>
-class _mtlist : public _mtlist<type_list, index - 1>
-{
-	typedef typename type_at<type_list, index>::value value_type;
-
-public:
-	using _mtlist<type_list, index - 1>::push_back;
-
-	void push_back(const value_type& value);
-};
-
-template <typename type_list, int index>
-void _mtlist<type_list, index>::push_back(const value_type& value)
-{
-	metalink<value_type>* ml = new metalink<value_type>();
-
-	ml->value = value;
-	ml->next = head;
-	ml->prev = head->prev;
-
-	head->prev->next = ml;
-	head->prev = ml;
-}
-
-/**
- * \brief Specialized list for the first type (internal)
+ * \brief Effective multi-type list
+ *
+ * A single class for any number of types; push_back() only accepts
+ * the exact types of the list (use push_back<T>() to convert).
  */
 template <typename type_list>
-class _mtlist<type_list, 0>
+class mtlist
 {
-	typedef typename type_at<type_list, 0>::value value_type;
-
 protected:
 	struct metalink_base
 	{
@@ -57,14 +31,25 @@ protected:
 	metalink_base* head;
 
 public:
-	_mtlist();
-	virtual ~_mtlist();
+	class iterator;
 
+	mtlist();
+	virtual ~mtlist();
+
+	template <typename value_type>
 	void push_back(const value_type& value);
+
+	iterator begin() {
+		return iterator(this, head->next);
+	}
+
+	iterator end() {
+		return iterator(this, head);
+	}
 };
 
 template <typename type_list>
-_mtlist<type_list, 0>::_mtlist()
+mtlist<type_list>::mtlist()
 {
 	head = new metalink_base();
 	head->next = head;
@@ -72,7 +57,7 @@ _mtlist<type_list, 0>::_mtlist()
 }
 
 template <typename type_list>
-_mtlist<type_list, 0>::~_mtlist()
+mtlist<type_list>::~mtlist()
 {
 	metalink_base* p = head->next;
 	metalink_base* q;
@@ -90,8 +75,11 @@ _mtlist<type_list, 0>::~_mtlist()
 }
 
 template <typename type_list>
-void _mtlist<type_list, 0>::push_back(const value_type& value)
+template <typename value_type>
+void mtlist<type_list>::push_back(const value_type& value)
 {
+	static_assert(index_of<type_list, value_type>::value != -1, "mtlist::push_back(): type is not in the list");
+
 	metalink<value_type>* ml = new metalink<value_type>();
 
 	ml->value = value;
@@ -102,24 +90,6 @@ void _mtlist<type_list, 0>::push_back(const value_type& value)
 	head->prev = ml;
 }
 
-/**
- * \brief Effective multi-type list
- */
-template <typename type_list>
-class mtlist : public _mtlist<type_list, length<type_list>::value - 1>
-{
-public:
-	class iterator;
-
-	iterator begin() {
-		return iterator(this, head->next);
-	}
-
-	iterator end() {
-		return iterator(this, head);
-	}
-};
-
 /**
  * \brief Multilist iterator
  */
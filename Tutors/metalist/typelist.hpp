@@ -20,39 +20,87 @@ struct typelist<_head, void>
 }; 
 
 /**
- * \brief Gets a type from the metalist
+ * \brief Gets the length of the metalist
  */
-template <typename ml, int index>
-struct type_at
+template <typename ml>
+struct length
 {
-	typedef typename type_at<typename ml::tail, index - 1>::value value;
+	enum { value = length<typename ml::tail>::value + 1 };
 };
 
-template <typename ml>
-struct type_at<ml, 0>
+template <>
+struct length<void>
 {
-	typedef typename ml::head value;
+	enum { value = 0 };
 };
 
 /**
- * \brief Gets the length of the metalist
+ * \brief Tags a type with its position (internal)
  */
-template <typename ml>
-struct length
+template <typename type, int index>
+struct _indexed
 {
-	enum { value = length<typename ml::tail>::value + 1 };
+	typedef type value;
 };
 
-template <>
-struct length<void>
+/**
+ * \brief Derives from _indexed<T, i> for every type of the metalist (internal)
+ *
+ * Instantiated once for each list; lookups are done by overload
+ * resolution on its base classes, so they don't recurse.
+ */
+template <typename ml, int index = 0>
+struct _indexed_list :
+	public _indexed<typename ml::head, index>,
+	public _indexed_list<typename ml::tail, index + 1>
 {
-	enum { value = 0 };
+};
+
+template <int index>
+struct _indexed_list<void, index>
+{
+};
+
+// never defined, only used in decltype and sizeof
+template <int index, typename type>
+_indexed<type, index> _type_probe(const _indexed<type, index>*);
+
+template <typename type, int index>
+char (&_index_probe(const _indexed<type, index>*))[index + 2];
+
+template <typename type>
+char (&_index_probe(...))[1];
+
+/**
+ * \brief Gets a type from the metalist
+ */
+template <typename ml, int index>
+struct type_at
+{
+	typedef decltype(_type_probe<index>((_indexed_list<ml>*)0)) tag;
+	typedef typename tag::value value;
+};
+
+/**
+ * \brief Gets the index of a type in the metalist (-1 if not found)
+ *
+ * The types of the list have to be different.
+ */
+template <typename ml, typename type>
+struct index_of
+{
+	enum { value = (int)sizeof(_index_probe<type>((_indexed_list<ml>*)0)) - 2 };
 };
 
 // typedefs
 #define TL1(a)        typelist<a, void>
 #define TL2(a, b)     typelist<a, typelist<b, void> >
 #define TL3(a, b, c)  typelist<a, typelist<b, typelist<c, void> > >
+#define TL4(a, b, c, d)                typelist<a, TL3(b, c, d) >
+#define TL5(a, b, c, d, e)             typelist<a, TL4(b, c, d, e) >
+#define TL6(a, b, c, d, e, f)          typelist<a, TL5(b, c, d, e, f) >
+#define TL7(a, b, c, d, e, f, g)       typelist<a, TL6(b, c, d, e, f, g) >
+#define TL8(a, b, c, d, e, f, g, h)    typelist<a, TL7(b, c, d, e, f, g, h) >
 
 #endif
 //=============================================================================================================
@@ -425,10 +425,338 @@ expression_desc* Interpreter::Unary_Expr(expression_desc* expr, unary_expr type)
 	return expr;
 }
 
+expression_desc* Interpreter::Subscript_Expr(symbol_desc* var, expression_desc* index)
+{
+	assert(0, "Interpreter::Subscript_Expr(): NULL == index", index);
+	assert(0, "Subscripted value '" << var->name << "' is not an array", var->length > 0);
+
+	expression_desc* elem = interpreter->Allocate<expression_desc>();
+
+	elem->type = var->type;
+	elem->constexpr = false;
+
+	if( index->constexpr )
+	{
+		// element address is known at compile time
+		int i = atoi(index->value.c_str());
+
+		nassert(0, "Array index " << i << " is out of bounds for '" << var->name << "'", i < 0 || i >= var->length);
+
+		elem->address = var->address + i * Sizeof(var->type);
+		interpreter->Deallocate(index);
+	}
+	else
+	{
+		// code is generated by Load_Element() or Store_Element()
+		elem->address = var->address;
+		elem->index = index;
+		elem->length = var->length;
+	}
+
+	return elem;
+}
+
+void Interpreter::Load_Element(expression_desc* elem)
+{
+	expression_desc* index = elem->index;
+
+	elem->bytecode << index->bytecode;
+
+	if( index->address == UNKNOWN_ADDR )
+	{
+		// subscript in EAX
+		elem->bytecode << OP(OP_MOV_RR) << REG(ECX) << REG(EAX);
+		elem->bytecode << OP(OP_BOUND_RS) << REG(ECX) << elem->length;
+	}
+	else
+	{
+		// subscript on the stack (can be eliminated later)
+		elem->bytecode << OP(OP_BOUND_MS) << index->address << elem->length;
+		elem->bytecode << OP(OP_MOV_RM) << REG(ECX) << index->address;
+	}
+
+	elem->bytecode << OP(OP_MOV_RX) << REG(EAX) << elem->address;
+
+	elem->address = UNKNOWN_ADDR;
+	elem->index = 0;
+
+	interpreter->Deallocate(index);
+}
+
+void Interpreter::Store_Element(expression_desc* elem, expression_desc* value)
+{
+	expression_desc* index = elem->index;
+
+	// value goes into EAX first
+	if( value->constexpr )
+	{
+		int a = atoi(value->value.c_str());
+		elem->bytecode << OP(OP_MOV_RS) << REG(EAX) << a << value->bytecode;
+	}
+	else if( value->address == UNKNOWN_ADDR )
+	{
+		elem->bytecode << value->bytecode;
+	}
+	else
+	{
+		elem->bytecode << value->bytecode;
+		elem->bytecode << OP(OP_MOV_RM) << REG(EAX) << value->address;
+	}
+
+	if( index->address != UNKNOWN_ADDR && index->bytecode.size() == 0 )
+	{
+		// subscript is a variable
+		elem->bytecode << OP(OP_BOUND_MS) << index->address << elem->length;
+		elem->bytecode << OP(OP_MOV_RM) << REG(ECX) << index->address;
+	}
+	else
+	{
+		elem->bytecode << OP(OP_PUSH) << REG(EAX) << NIL;
+		elem->bytecode << index->bytecode;
+
+		if( index->address != UNKNOWN_ADDR )
+			elem->bytecode << OP(OP_MOV_RM) << REG(EAX) << index->address;
+
+		elem->bytecode << OP(OP_MOV_RR) << REG(ECX) << REG(EAX);
+		elem->bytecode << OP(OP_POP) << REG(EAX) << NIL;
+		elem->bytecode << OP(OP_BOUND_RS) << REG(ECX) << elem->length;
+	}
+
+	elem->bytecode << OP(OP_MOV_XR) << elem->address << REG(EAX);
+
+	// "returns with" the stored value
+	elem->address = UNKNOWN_ADDR;
+	elem->index = 0;
+
+	interpreter->Deallocate(index);
+}
+
+static bool Jump_Offset(char* ptr, int& offset)
+{
+	unsigned char opcode = *((unsigned char*)ptr);
+
+	switch( opcode )
+	{
+	case OP_JZ:
+	case OP_JNZ:
+		offset = ARG2_INT(ptr);
+		return true;
+
+	case OP_JMP:
+		// unresolved function calls are left alone
+		offset = ARG1_INT(ptr);
+		return (offset != UNKNOWN_ADDR);
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
+void Interpreter::Eliminate_BoundsChecks(bytestream& code)
+{
+	// Removes 'bound [EBP+i], n' checks from loops of the form:
+	//
+	//     i = c;  (c >= 0)
+	//     while( i < k ) { ... a[i] ... ++i; ... }
+	//
+	// where k <= n, and the check precedes every write to 'i' in the body.
+	// In that case 0 <= i < k holds at the check, because 'i' only grows.
+
+	int count = (int)(code.size() / ENTRY_SIZE);
+	int offset;
+	bool found = false;
+
+	char* bytecode = code.data();
+	std::vector<int> refs(count + 1, 0);
+	std::vector<bool> removed(count, false);
+
+	#define ENTRY(i)		(bytecode + (i) * ENTRY_SIZE)
+	#define OPCODE(i)		*((unsigned char*)ENTRY(i))
+
+	// count jumps to every entry
+	for( int i = 0; i < count; ++i )
+	{
+		if( Jump_Offset(ENTRY(i), offset) )
+		{
+			int dest = i + 1 + offset / (int)ENTRY_SIZE;
+
+			if( dest >= 0 && dest <= count )
+				++refs[dest];
+		}
+	}
+
+	for( int j = 0; j < count; ++j )
+	{
+		// loops end with a backward jump to the condition
+		if( OPCODE(j) != OP_JMP || !Jump_Offset(ENTRY(j), offset) || offset >= 0 )
+			continue;
+
+		int t = j + 1 + offset / (int)ENTRY_SIZE;
+
+		if( t < 2 || t + 3 > j || refs[t] != 1 )
+			continue;
+
+		// condition must be 'mov EAX, [EBP+i]; setl EAX, k; jz EAX, exit'
+		char* cond = ENTRY(t);
+		char* test = ENTRY(t + 1);
+		char* jump = ENTRY(t + 2);
+
+		if( OPCODE(t) != OP_MOV_RM || ARG1_INT(cond) != EAX )
+			continue;
+
+		if( OPCODE(t + 2) != OP_JZ || ARG1_INT(jump) != EAX || t + 3 + ARG2_INT(jump) / (int)ENTRY_SIZE != j + 1 )
+			continue;
+
+		int var = ARG2_INT(cond);
+		int limit;
+
+		if( OPCODE(t + 1) == OP_SETL_RS && ARG1_INT(test) == EAX )
+			limit = ARG2_INT(test);
+		else if( OPCODE(t + 1) == OP_SETLE_RS && ARG1_INT(test) == EAX && ARG2_INT(test) < INT_MAX )
+			limit = ARG2_INT(test) + 1;
+		else
+			continue;
+
+		// find the last write to 'i' before the loop in straight code
+		int w = t - 1;
+
+		for( ; w > 0; --w )
+		{
+			if( (w + 1 < t && refs[w + 1] > 0) || Jump_Offset(ENTRY(w), offset) || OPCODE(w) == OP_JMP )
+			{
+				w = 0;
+				break;
+			}
+
+			if( (OPCODE(w) == OP_MOV_MR || OPCODE(w) == OP_MOV_MM) && ARG1_INT(ENTRY(w)) == var )
+				break;
+		}
+
+		if( w == 0 || OPCODE(w) != OP_MOV_MR || ARG2_INT(ENTRY(w)) != EAX || refs[w] > 0 )
+			continue;
+
+		if( OPCODE(w - 1) != OP_MOV_RS || ARG1_INT(ENTRY(w - 1)) != EAX || ARG2_INT(ENTRY(w - 1)) < 0 )
+			continue;
+
+		// every write in the body must be an increment, outside of inner loops
+		int first = j;
+		bool valid = true;
+
+		for( int b = t + 3; b < j && valid; ++b )
+		{
+			if( OPCODE(b) == OP_MOV_MM && ARG1_INT(ENTRY(b)) == var )
+				valid = false;
+
+			if( OPCODE(b) != OP_MOV_MR || ARG1_INT(ENTRY(b)) != var )
+				continue;
+
+			valid = (
+				ARG2_INT(ENTRY(b)) == EAX && refs[b] == 0 && refs[b - 1] == 0 &&
+				OPCODE(b - 1) == OP_ADD_RS && ARG1_INT(ENTRY(b - 1)) == EAX && ARG2_INT(ENTRY(b - 1)) == 1 &&
+				OPCODE(b - 2) == OP_MOV_RM && ARG1_INT(ENTRY(b - 2)) == EAX && ARG2_INT(ENTRY(b - 2)) == var);
+
+			for( int q = b + 1; q < j && valid; ++q )
+			{
+				if( OPCODE(q) == OP_JMP && Jump_Offset(ENTRY(q), offset) && offset < 0 )
+					valid = (q + 1 + offset / (int)ENTRY_SIZE > b);
+			}
+
+			first = std::min(first, b);
+		}
+
+		if( !valid )
+			continue;
+
+		// checks before the first increment are redundant
+		for( int p = t + 3; p < first; ++p )
+		{
+			char* check = ENTRY(p);
+
+			if( OPCODE(p) != OP_BOUND_MS || ARG1_INT(check) != var || ARG2_INT(check) < limit )
+				continue;
+
+			// unless an inner loop brings the increment before it
+			bool inner = false;
+
+			for( int q = first; q < j && !inner; ++q )
+			{
+				if( OPCODE(q) == OP_JMP && Jump_Offset(ENTRY(q), offset) && offset < 0 )
+					inner = (q + 1 + offset / (int)ENTRY_SIZE <= p);
+			}
+
+			if( !inner )
+			{
+				removed[p] = true;
+				found = true;
+			}
+		}
+	}
+
+	if( found )
+	{
+		// rebuild code and relocate jumps
+		std::vector<int> newindex(count + 1, 0);
+		bytestream result;
+
+		for( int i = 0; i < count; ++i )
+			newindex[i + 1] = newindex[i] + (removed[i] ? 0 : 1);
+
+		for( int i = 0; i < count; ++i )
+		{
+			if( removed[i] )
+				continue;
+
+			char* ptr = ENTRY(i);
+			int arg1 = ARG1_INT(ptr);
+			int arg2 = ARG2_INT(ptr);
+
+			if( Jump_Offset(ptr, offset) )
+			{
+				int dest = i + 1 + offset / (int)ENTRY_SIZE;
+				offset = (newindex[dest] - newindex[i] - 1) * (int)ENTRY_SIZE;
+
+				if( OPCODE(i) == OP_JMP )
+					arg1 = offset;
+				else
+					arg2 = offset;
+			}
+
+			result << OP(OPCODE(i)) << arg1 << arg2;
+		}
+
+		code = result;
+	}
+
+	#undef OPCODE
+	#undef ENTRY
+}
+
 int yylex()
 {
+	// keywords that share the identifier rule of the scanner
+	static const struct {
+		const char* name;
+		int token;
+	} keywords[] =
+	{
+		{ "parallel", PARALLEL },
+		{ "for", FOR },
+		{ "reduce", REDUCE }
+	};
+
 	int ret = yyflex();
 
+	if( ret == IDENTIFIER )
+	{
+		for( size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); ++i )
+		{
+			if( strcmp(yytext, keywords[i].name) == 0 )
+				return keywords[i].token;
+		}
+	}
+
 	switch( ret )
 	{
 	case NUMBER:
@@ -21,6 +21,13 @@ Interpreter::Interpreter()
 
 Interpreter::~Interpreter()
 {
+	pool.destroy();
+
+	for( size_t i = 0; i < workers.size(); ++i )
+		free(workers[i].stack);
+
+	workers.clear();
+
 	if( stack )
 	{
 		free(stack);
@@ -145,21 +152,35 @@ bool Interpreter::Run()
 	if( program.size() == 0 )
 		return false;
 
+	context ctx;
+
+	memset(ctx.registers, 0, sizeof(ctx.registers));
+
+	ctx.registers[EBP] = STACK_SIZE;
+	ctx.registers[ESP] = STACK_SIZE;
+	ctx.registers[EIP] = entry;
+
+	ctx.stack = stack;
+	ctx.stackdepth = 0;
+	ctx.worker = false;
+
+	std::cout << "Executing program '" << progname << "'...\n";
+
+	return Execute(ctx);
+}
+
+bool Interpreter::Execute(context& ctx)
+{
 	stm_ptr stm;
 	unsigned char opcode;
 	char* ptr;
 
-	memset(registers, 0, sizeof(registers));
-
-	registers[EBP] = STACK_SIZE;
-	registers[ESP] = STACK_SIZE;
-	registers[EIP] = entry;
+	int* registers = ctx.registers;
+	char* stack = ctx.stack;
+	size_t& stackdepth = ctx.stackdepth;
 
 	char* bytecode = program.data();
 	size_t bytesize = program.size();
-	size_t stackdepth = 0;
-
-	std::cout << "Executing program '" << progname << "'...\n";
 
 	while( (size_t)registers[EIP] < bytesize )
 	{
@@ -172,7 +193,7 @@ bool Interpreter::Run()
 		if( opcode < 0x20 )
 		{
 			stm = op_special[opcode];
-			(*stm)(ARG1_PTR(ptr), ARG2_PTR(ptr));
+			(*stm)(registers, ARG1_PTR(ptr), ARG2_PTR(ptr));
 		}
 		else
 		{
@@ -233,6 +254,28 @@ bool Interpreter::Run()
 				STACK_INT(registers[EBP] + ARG1_INT(ptr)) = STACK_INT(registers[EBP] + ARG2_INT(ptr));
 				break;
 
+			case OP_MOV_RX:
+				registers[ARG1_INT(ptr)] = STACK_INT(registers[EBP] + ARG2_INT(ptr) + registers[ECX] * 4);
+				break;
+
+			case OP_MOV_XR:
+				STACK_INT(registers[EBP] + ARG1_INT(ptr) + registers[ECX] * 4) = registers[ARG2_INT(ptr)];
+				break;
+
+			case OP_BOUND_RS: {
+				int index = registers[ARG1_INT(ptr)];
+
+				if( index < 0 || index >= ARG2_INT(ptr) )
+					nassert(false, "EXCEPTION: Array index out of bounds", true);
+				} break;
+
+			case OP_BOUND_MS: {
+				int index = STACK_INT(registers[EBP] + ARG1_INT(ptr));
+
+				if( index < 0 || index >= ARG2_INT(ptr) )
+					nassert(false, "EXCEPTION: Array index out of bounds", true);
+				} break;
+
 			case OP_AND_RS:
 				registers[ARG1_INT(ptr)] = (registers[ARG1_INT(ptr)] && ARG2_INT(ptr));
 				break;
@@ -366,6 +409,16 @@ bool Interpreter::Run()
 			case OP_JMP:
 				registers[EIP] += ARG1_INT(ptr);
 				break;
+
+			case OP_PARALLEL:
+				if( !Parallel_For(ctx, ptr) )
+					return false;
+
+				break;
+
+			case OP_ENDPAR:
+				// one iteration done
+				return true;
 			
 			default:
 				break;
@@ -376,6 +429,160 @@ bool Interpreter::Run()
 	return true;
 }
 
+bool Interpreter::Parallel_For(context& ctx, char* ptr)
+{
+	parallel_desc* desc = reinterpret_cast<parallel_desc*>(ARG2_PTR(ptr));
+
+	int* registers = ctx.registers;
+	char* stack = ctx.stack;
+
+	int counter = registers[EBP] + desc->counter;
+	int first = STACK_INT(counter);
+	int last = registers[ARG1_INT(ptr)];
+
+	// EIP points to the jump over the body
+	int resume = registers[EIP];
+	int body = resume + (int)ENTRY_SIZE;
+
+	if( first >= last )
+		return true;
+
+	if( !ctx.worker && pool.size() == 0 )
+		pool.create(threadpool::numcores() - 1);
+
+	if( ctx.worker || pool.size() == 0 )
+	{
+		// nested loops (and single core machines) run sequentially
+		for( int i = first; i < last; ++i )
+		{
+			STACK_INT(counter) = i;
+			registers[EIP] = body;
+
+			if( !Execute(ctx) )
+				return false;
+		}
+
+		STACK_INT(counter) = last;
+		registers[EIP] = resume;
+
+		return true;
+	}
+
+	// every thread gets its own registers and a copy of the stack
+	size_t numworkers = (size_t)pool.size() + 1;
+	int esp = registers[ESP];
+
+	while( workers.size() < numworkers )
+	{
+		context worker;
+
+		worker.stack = (char*)malloc(STACK_SIZE);
+		worker.stackdepth = 0;
+		worker.worker = true;
+
+		assert(false, "Interpreter::Parallel_For(): Could not create stack", worker.stack);
+		workers.push_back(worker);
+	}
+
+	for( size_t i = 0; i < numworkers; ++i )
+	{
+		context& worker = workers[i];
+
+		memcpy(worker.registers, registers, sizeof(worker.registers));
+		memcpy(worker.stack + esp, stack + esp, STACK_SIZE - esp);
+
+		worker.stackdepth = ctx.stackdepth;
+
+		for( size_t j = 0; j < desc->reductions.size(); ++j )
+		{
+			const reduction_desc& red = desc->reductions[j];
+			int* value = (int*)(worker.stack + registers[EBP] + red.address);
+
+			*value = (red.type == Reduce_Max ? INT_MIN : 0);
+		}
+	}
+
+	parallel_job job;
+
+	job.ip = this;
+	job.desc = desc;
+	job.first = first;
+	job.last = last;
+	job.body = body;
+	job.numchunks = (int)std::min<size_t>((size_t)(last - first), numworkers * 4);
+	job.failed = false;
+
+	pool.run(&Interpreter::Parallel_Chunk, &job, job.numchunks);
+
+	if( job.failed )
+		return false;
+
+	// merge results: reductions are combined, other changes are copied back
+	for( size_t j = 0; j < desc->reductions.size(); ++j )
+	{
+		const reduction_desc& red = desc->reductions[j];
+		int& result = STACK_INT(registers[EBP] + red.address);
+
+		for( size_t i = 0; i < numworkers; ++i )
+		{
+			int value = *((int*)(workers[i].stack + registers[EBP] + red.address));
+
+			if( red.type == Reduce_Max )
+				result = std::max(result, value);
+			else
+				result += value;
+		}
+	}
+
+	for( int addr = esp; addr + 4 <= STACK_SIZE; addr += 4 )
+	{
+		bool reduced = (addr == counter);
+
+		for( size_t j = 0; j < desc->reductions.size() && !reduced; ++j )
+			reduced = (addr == registers[EBP] + desc->reductions[j].address);
+
+		if( reduced )
+			continue;
+
+		for( size_t i = 0; i < numworkers; ++i )
+		{
+			int value = *((int*)(workers[i].stack + addr));
+
+			if( value != STACK_INT(addr) )
+			{
+				STACK_INT(addr) = value;
+				break;
+			}
+		}
+	}
+
+	STACK_INT(counter) = last;
+	registers[EIP] = resume;
+
+	return true;
+}
+
+void Interpreter::Parallel_Chunk(void* arg, int chunk, int thread)
+{
+	parallel_job* job = reinterpret_cast<parallel_job*>(arg);
+	context& ctx = job->ip->workers[thread];
+
+	long long count = job->last - job->first;
+	int begin = job->first + (int)((count * chunk) / job->numchunks);
+	int end = job->first + (int)((count * (chunk + 1)) / job->numchunks);
+
+	int* counter = (int*)(ctx.stack + ctx.registers[EBP] + job->desc->counter);
+
+	for( int i = begin; i < end && !job->failed; ++i )
+	{
+		*counter = i;
+		ctx.registers[EIP] = job->body;
+
+		if( !job->ip->Execute(ctx) )
+			job->failed = true;
+	}
+}
+
 void Interpreter::Disassemble()
 {
 	size_t off = 0;
@@ -462,6 +669,31 @@ void Interpreter::Disassemble()
 				std::cout << "], [EBP+" << arg2 << "]\n";
 			break;
 
+		case OP_MOV_RX:
+			if( arg2 < 0 )
+				std::cout << buff << "mov " << reg[arg1] << ", [EBP" << arg2 << "+4*ECX]\n";
+			else
+				std::cout << buff << "mov " << reg[arg1] << ", [EBP+" << arg2 << "+4*ECX]\n";
+			break;
+
+		case OP_MOV_XR:
+			if( arg1 < 0 )
+				std::cout << buff << "mov [EBP" << arg1 << "+4*ECX], " << reg[arg2] << "\n";
+			else
+				std::cout << buff << "mov [EBP+" << arg1 << "+4*ECX], " << reg[arg2] << "\n";
+			break;
+
+		case OP_BOUND_RS:
+			std::cout << buff << "bound " << reg[arg1] << ", " << arg2 << "\n";
+			break;
+
+		case OP_BOUND_MS:
+			if( arg1 < 0 )
+				std::cout << buff << "bound [EBP" << arg1 << "], " << arg2 << "\n";
+			else
+				std::cout << buff << "bound [EBP+" << arg1 << "], " << arg2 << "\n";
+			break;
+
 		case OP_AND_RS:
 			std::cout << buff << "and " << reg[arg1] << ", " << arg2 << "\n";
 			break;
@@ -594,6 +826,14 @@ void Interpreter::Disassemble()
 			std::cout << buff << "print <addr>\n";
 			break;
 
+		case OP_PARALLEL:
+			std::cout << buff << "parallel " << reg[arg1] << "\n";
+			break;
+
+		case OP_ENDPAR:
+			std::cout << buff << "endpar\n";
+			break;
+
 		default:
 			std::cout << "nop\n";
 		}
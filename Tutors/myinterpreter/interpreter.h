@@ -10,6 +10,7 @@
 #include <map>
 
 #include "bytestream.h"
+#include "threadpool.h"
 #include "types.h"
 #include "variadic_pointer_set.hpp"
 
@@ -55,6 +56,12 @@
 #define OP_MOV_RM		 0x27  // mov reg[arg1], [EBP - arg2]
 #define OP_MOV_MR		 0x28  // mov [EBP - arg1], reg[arg2]
 #define OP_MOV_MM		 0x29  // mov [EBP - arg1], [EBP - arg2]
+#define OP_MOV_RX		 0x2a  // mov reg[arg1], [EBP - arg2 + 4 * ECX]
+#define OP_MOV_XR		 0x2b  // mov [EBP - arg1 + 4 * ECX], reg[arg2]
+
+// bounds checks for array indexing
+#define OP_BOUND_RS	   0x2c  // if( reg[arg1] < 0 || reg[arg1] >= arg2 ) throw
+#define OP_BOUND_MS	   0x2d  // if( [EBP - arg1] < 0 || [EBP - arg1] >= arg2 ) throw
 
 #define OP_AND_RS		 0x30  // and reg[arg1], arg2
 #define OP_AND_RR		 0x31  // and reg[arg1], reg[arg2]
@@ -92,6 +99,10 @@
 #define OP_JNZ			0x51  // if( reg[arg1] != 0 ) jmp arg2
 #define OP_JMP			0x52  // jmp arg1
 
+// parallel loops
+#define OP_PARALLEL	   0x60  // for( ; [EBP - arg2->counter] < reg[arg1]; ) on the thread pool
+#define OP_ENDPAR		 0x61  // end of parallel loop body
+
 // registers
 #define EBP			   0	// stack base
 #define ESP			   1	// stack top
@@ -106,12 +117,34 @@ class Interpreter
 	friend int yyparse();
 	friend int yylex();
 
-	typedef void (*stm_ptr)(void*, void*);
+	typedef void (*stm_ptr)(int*, void*, void*);
 	static stm_ptr op_special[NUM_SPECIAL];
 
 	// special statements
-	static void Print_Reg(void* arg1, void* arg2);
-	static void Print_Memory(void* arg1, void* arg2);
+	static void Print_Reg(int* registers, void* arg1, void* arg2);
+	static void Print_Memory(int* registers, void* arg1, void* arg2);
+
+	// execution state of a thread
+	struct context
+	{
+		int			registers[10];
+		char*		  stack;
+		size_t		 stackdepth;
+		bool		   worker;
+	};
+
+	struct parallel_job
+	{
+		Interpreter*   ip;
+		parallel_desc* desc;
+		int			first;
+		int			last;
+		int			body;
+		int			numchunks;
+		volatile bool  failed;
+	};
+
+	static void Parallel_Chunk(void* arg, int chunk, int thread);
 
 private:
 	variadic_pointer_set garbage;
@@ -120,15 +153,20 @@ private:
 	bytestream	 program;
 	std::string	progname;
 	int			entry;
-	int			registers[10];
 	char*		  stack;
 
+	threadpool			pool;
+	std::vector<context>  workers;
+
 	symbol_desc*   current_func;
 	size_t		 current_scope;
 	int			alloc_addr;
 
 	void Cleanup();
 
+	bool Execute(context& ctx);
+	bool Parallel_For(context& ctx, char* ptr);
+
 	void Const_Add(expression_desc* expr1, expression_desc* expr2, int type);
 	void Const_Sub(expression_desc* expr1, expression_desc* expr2, int type);
 	void Const_Mul(expression_desc* expr1, expression_desc* expr2, int type);
@@ -138,6 +176,11 @@ private:
 	int Sizeof(int t);
 	expression_desc* Arithmetic_Expr(expression_desc* expr1, expression_desc* expr2, unsigned char op);
 	expression_desc* Unary_Expr(expression_desc* expr, unary_expr type);
+	expression_desc* Subscript_Expr(symbol_desc* var, expression_desc* index);
+
+	void Load_Element(expression_desc* elem);
+	void Store_Element(expression_desc* elem, expression_desc* value);
+	void Eliminate_BoundsChecks(bytestream& code);
 
 	template <typename value_type>
 	value_type* Allocate() {
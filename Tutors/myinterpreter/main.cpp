@@ -15,6 +15,8 @@ int main()
 		//ip.Compile("programs/helloworld.p");
 		//ip.Compile("programs/factorial.p");
 		//ip.Compile("programs/lnko.p");
+		//ip.Compile("programs/arrays.p");
+		//ip.Compile("programs/parallel.p");
 		ip.Compile("../myinterpreter/programs/bigtest.p");
 		ip.Link();
 
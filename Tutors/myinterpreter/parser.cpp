@@ -164,9 +164,12 @@ extern std::string& replace(
      ELSE = 293,
      WHILE = 294,
      RETURN = 295,
-     NUMBER = 296,
-     IDENTIFIER = 297,
-     STRING = 298
+     PARALLEL = 296,
+     FOR = 297,
+     REDUCE = 298,
+     NUMBER = 299,
+     IDENTIFIER = 300,
+     STRING = 301
    };
 #endif
 
@@ -188,12 +191,14 @@ typedef union YYSTYPE
     decllist*         decllist_t;
     expression_desc*  expr_t;
     exprlist*         exprlist_t;
+    reduction_desc*   reduction_t;
+    reductionlist*    reductionlist_t;
     symbol_type       type_t;
 
 
 
 /* Line 214 of yacc.c  */
-#line 197 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
+#line 202 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
 } YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define yystype YYSTYPE /* obsolescent; will be withdrawn */
@@ -218,7 +223,7 @@ typedef struct YYLTYPE
 
 
 /* Line 264 of yacc.c  */
-#line 222 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
+#line 227 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
 
 #ifdef short
 # undef short
@@ -435,20 +440,20 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  8
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   132
+#define YYLAST   172
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  44
+#define YYNTOKENS  47
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  35
+#define YYNNTS  39
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  74
+#define YYNRULES  85
 /* YYNRULES -- Number of states.  */
-#define YYNSTATES  125
+#define YYNSTATES  163
 
 /* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
 #define YYUNDEFTOK  2
-#define YYMAXUTOK   298
+#define YYMAXUTOK   301
 
 #define YYTRANSLATE(YYX)						\
   ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
@@ -485,64 +490,72 @@ static const yytype_uint8 yytranslate[] =
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46
 };
 
 #if YYDEBUG
 /* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
    YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+static const yytype_uint16 yyprhs[] =
 {
        0,     0,     3,     5,     7,    10,    13,    18,    24,    26,
       30,    33,    34,    38,    41,    43,    45,    47,    49,    52,
-      54,    56,    62,    70,    76,    80,    82,    85,    88,    91,
-      93,    97,    99,   103,   105,   107,   111,   113,   117,   119,
-     123,   125,   129,   133,   135,   139,   143,   147,   151,   153,
-     157,   161,   163,   167,   171,   175,   177,   180,   183,   186,
-     189,   192,   194,   198,   200,   202,   204,   209,   213,   215,
-     219,   221,   223,   225,   227
+      54,    56,    58,    64,    72,    78,    95,    96,   101,   103,
+     107,   110,   113,   117,   119,   122,   125,   128,   130,   134,
+     136,   140,   145,   147,   149,   153,   155,   159,   161,   165,
+     167,   171,   175,   177,   181,   185,   189,   193,   195,   199,
+     203,   205,   209,   213,   217,   219,   222,   225,   228,   231,
+     234,   236,   241,   245,   247,   249,   254,   256,   261,   265,
+     267,   271,   273,   275,   277,   279
 };
 
 /* YYRHS -- A `-1'-separated list of the rules' RHS.  */
 static const yytype_int8 yyrhs[] =
 {
-      45,     0,    -1,    46,    -1,    47,    -1,    46,    47,    -1,
-      48,    56,    -1,    77,    42,     4,     5,    -1,    77,    42,
-       4,    49,     5,    -1,    50,    -1,    49,    11,    50,    -1,
-      77,    42,    -1,    -1,    51,    52,    10,    -1,    51,    53,
-      -1,    58,    -1,    59,    -1,    62,    -1,    40,    -1,    40,
-      62,    -1,    54,    -1,    55,    -1,    37,     4,    62,     5,
-      56,    -1,    37,     4,    62,     5,    56,    38,    56,    -1,
-      39,     4,    62,     5,    56,    -1,    57,    51,     7,    -1,
-       6,    -1,    36,    78,    -1,    36,    62,    -1,    77,    60,
-      -1,    61,    -1,    60,    11,    61,    -1,    42,    -1,    42,
-      12,    62,    -1,    63,    -1,    64,    -1,    71,    12,    63,
-      -1,    65,    -1,    64,    18,    65,    -1,    66,    -1,    65,
-      19,    66,    -1,    67,    -1,    66,    21,    67,    -1,    66,
-      22,    67,    -1,    68,    -1,    67,    23,    68,    -1,    67,
-      24,    68,    -1,    67,    25,    68,    -1,    67,    26,    68,
-      -1,    69,    -1,    68,    27,    69,    -1,    68,    28,    69,
-      -1,    70,    -1,    69,    29,    70,    -1,    69,    30,    70,
-      -1,    69,    31,    70,    -1,    72,    -1,    32,    72,    -1,
-      33,    72,    -1,    27,    72,    -1,    28,    72,    -1,    20,
-      72,    -1,    76,    -1,     4,    62,     5,    -1,    75,    -1,
-      76,    -1,    73,    -1,    42,     4,    74,     5,    -1,    42,
-       4,     5,    -1,    62,    -1,    74,    11,    62,    -1,    41,
-      -1,    42,    -1,    34,    -1,    35,    -1,     3,    43,     3,
-      -1
+      48,     0,    -1,    49,    -1,    50,    -1,    49,    50,    -1,
+      51,    63,    -1,    84,    45,     4,     5,    -1,    84,    45,
+       4,    52,     5,    -1,    53,    -1,    52,    11,    53,    -1,
+      84,    45,    -1,    -1,    54,    55,    10,    -1,    54,    56,
+      -1,    65,    -1,    66,    -1,    69,    -1,    40,    -1,    40,
+      69,    -1,    57,    -1,    58,    -1,    59,    -1,    37,     4,
+      69,     5,    63,    -1,    37,     4,    69,     5,    63,    38,
+      63,    -1,    39,     4,    69,     5,    63,    -1,    41,    42,
+       4,    83,    12,    69,    10,    83,    23,    69,    10,    32,
+      83,     5,    60,    63,    -1,    -1,    43,     4,    61,     5,
+      -1,    62,    -1,    61,    11,    62,    -1,    27,    83,    -1,
+      45,    83,    -1,    64,    54,     7,    -1,     6,    -1,    36,
+      85,    -1,    36,    69,    -1,    84,    67,    -1,    68,    -1,
+      67,    11,    68,    -1,    45,    -1,    45,    12,    69,    -1,
+      45,     8,    69,     9,    -1,    70,    -1,    71,    -1,    78,
+      12,    70,    -1,    72,    -1,    71,    18,    72,    -1,    73,
+      -1,    72,    19,    73,    -1,    74,    -1,    73,    21,    74,
+      -1,    73,    22,    74,    -1,    75,    -1,    74,    23,    75,
+      -1,    74,    24,    75,    -1,    74,    25,    75,    -1,    74,
+      26,    75,    -1,    76,    -1,    75,    27,    76,    -1,    75,
+      28,    76,    -1,    77,    -1,    76,    29,    77,    -1,    76,
+      30,    77,    -1,    76,    31,    77,    -1,    79,    -1,    32,
+      79,    -1,    33,    79,    -1,    27,    79,    -1,    28,    79,
+      -1,    20,    79,    -1,    83,    -1,    83,     8,    69,     9,
+      -1,     4,    69,     5,    -1,    82,    -1,    83,    -1,    83,
+       8,    69,     9,    -1,    80,    -1,    45,     4,    81,     5,
+      -1,    45,     4,     5,    -1,    69,    -1,    81,    11,    69,
+      -1,    44,    -1,    45,    -1,    34,    -1,    35,    -1,     3,
+      46,     3,    -1
 };
 
 /* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
 static const yytype_uint16 yyrline[] =
 {
-       0,   118,   118,   137,   142,   149,   208,   235,   285,   290,
-     297,   310,   314,   321,   330,   335,   340,   350,   368,   405,
-     409,   415,   467,   555,   599,   630,   636,   643,   665,   739,
-     746,   755,   764,   776,   783,   787,   818,   822,   828,   832,
-     838,   842,   846,   852,   856,   860,   864,   868,   874,   878,
-     882,   888,   892,   896,   900,   906,   910,   917,   924,   928,
-     935,   944,   953,   958,   963,   972,  1027,  1043,  1061,  1066,
-    1073,  1087,  1114,  1119,  1126
+       0,   127,   127,   146,   151,   158,   218,   245,   295,   300,
+     307,   320,   324,   331,   340,   345,   350,   360,   378,   415,
+     419,   423,   429,   481,   569,   613,   714,   717,   723,   728,
+     735,   743,   756,   787,   793,   800,   822,   901,   908,   917,
+     926,   936,   953,   960,   964,  1000,  1004,  1010,  1014,  1020,
+    1024,  1028,  1034,  1038,  1042,  1046,  1050,  1056,  1060,  1064,
+    1070,  1074,  1078,  1082,  1088,  1092,  1099,  1106,  1110,  1117,
+    1126,  1134,  1143,  1148,  1153,  1164,  1176,  1231,  1247,  1265,
+    1270,  1277,  1291,  1318,  1323,  1330
 };
 #endif
 
@@ -555,15 +568,17 @@ static const char *const yytname[] =
   "RSB", "SEMICOLON", "COMMA", "EQ", "PEQ", "MEQ", "SEQ", "DEQ", "OEQ",
   "OR", "AND", "NOT", "ISEQU", "NOTEQU", "LT", "LE", "GT", "GE", "PLUS",
   "MINUS", "STAR", "DIV", "MOD", "INC", "DEC", "INT", "VOID", "PRINT",
-  "IF", "ELSE", "WHILE", "RETURN", "NUMBER", "IDENTIFIER", "STRING",
-  "$accept", "program", "function_list", "function", "function_header",
-  "argument_list", "argument", "statement_block", "statement",
-  "control_block", "conditional", "while_loop", "scope", "scope_start",
-  "print", "declaration", "init_declarator_list", "init_declarator",
-  "expr", "assignment", "or_level_expr", "and_level_expr", "compare_expr",
-  "relative_expr", "additive_expr", "multiplicative_expr", "unary_expr",
-  "lvalue", "term", "func_call", "expression_list", "literal", "variable",
-  "typename", "string", 0
+  "IF", "ELSE", "WHILE", "RETURN", "PARALLEL", "FOR", "REDUCE", "NUMBER",
+  "IDENTIFIER", "STRING", "$accept", "program", "function_list",
+  "function", "function_header", "argument_list", "argument",
+  "statement_block", "statement", "control_block", "conditional",
+  "while_loop", "parallel_loop", "reduction_clause", "reduction_list",
+  "reduction", "scope", "scope_start", "print", "declaration",
+  "init_declarator_list", "init_declarator", "expr", "assignment",
+  "or_level_expr", "and_level_expr", "compare_expr", "relative_expr",
+  "additive_expr", "multiplicative_expr", "unary_expr", "lvalue", "term",
+  "func_call", "expression_list", "literal", "variable", "typename",
+  "string", 0
 };
 #endif
 
@@ -576,21 +591,22 @@ static const yytype_uint16 yytoknum[] =
      265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
      275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
      285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298
+     295,   296,   297,   298,   299,   300,   301
 };
 # endif
 
 /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
 static const yytype_uint8 yyr1[] =
 {
-       0,    44,    45,    46,    46,    47,    48,    48,    49,    49,
-      50,    51,    51,    51,    52,    52,    52,    52,    52,    53,
-      53,    54,    54,    55,    56,    57,    58,    58,    59,    60,
-      60,    61,    61,    62,    63,    63,    64,    64,    65,    65,
-      66,    66,    66,    67,    67,    67,    67,    67,    68,    68,
-      68,    69,    69,    69,    69,    70,    70,    70,    70,    70,
-      70,    71,    72,    72,    72,    72,    73,    73,    74,    74,
-      75,    76,    77,    77,    78
+       0,    47,    48,    49,    49,    50,    51,    51,    52,    52,
+      53,    54,    54,    54,    55,    55,    55,    55,    55,    56,
+      56,    56,    57,    57,    58,    59,    60,    60,    61,    61,
+      62,    62,    63,    64,    65,    65,    66,    67,    67,    68,
+      68,    68,    69,    70,    70,    71,    71,    72,    72,    73,
+      73,    73,    74,    74,    74,    74,    74,    75,    75,    75,
+      76,    76,    76,    76,    77,    77,    77,    77,    77,    77,
+      78,    78,    79,    79,    79,    79,    79,    80,    80,    81,
+      81,    82,    83,    84,    84,    85
 };
 
 /* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
@@ -598,12 +614,13 @@ static const yytype_uint8 yyr2[] =
 {
        0,     2,     1,     1,     2,     2,     4,     5,     1,     3,
        2,     0,     3,     2,     1,     1,     1,     1,     2,     1,
-       1,     5,     7,     5,     3,     1,     2,     2,     2,     1,
-       3,     1,     3,     1,     1,     3,     1,     3,     1,     3,
-       1,     3,     3,     1,     3,     3,     3,     3,     1,     3,
-       3,     1,     3,     3,     3,     1,     2,     2,     2,     2,
-       2,     1,     3,     1,     1,     1,     4,     3,     1,     3,
-       1,     1,     1,     1,     3
+       1,     1,     5,     7,     5,    16,     0,     4,     1,     3,
+       2,     2,     3,     1,     2,     2,     2,     1,     3,     1,
+       3,     4,     1,     1,     3,     1,     3,     1,     3,     1,
+       3,     3,     1,     3,     3,     3,     3,     1,     3,     3,
+       1,     3,     3,     3,     1,     2,     2,     2,     2,     2,
+       1,     4,     3,     1,     1,     4,     1,     4,     3,     1,
+       3,     1,     1,     1,     1,     3
 };
 
 /* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
@@ -611,117 +628,137 @@ static const yytype_uint8 yyr2[] =
    means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       0,    72,    73,     0,     2,     3,     0,     0,     1,     4,
-      25,     5,    11,     0,     0,     0,     0,    24,     0,     0,
-       0,     0,     0,     0,     0,     0,    17,    70,    71,     0,
-      13,    19,    20,    14,    15,    16,    33,    34,    36,    38,
-      40,    43,    48,    51,     0,    55,    65,    63,    64,     0,
-       6,     0,     8,     0,     0,    60,    64,    58,    59,    56,
-      57,     0,    27,    26,     0,     0,    18,     0,    12,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    31,    28,    29,     7,     0,    10,    62,
-       0,     0,     0,    67,    68,     0,    37,    39,    41,    42,
-      44,    45,    46,    47,    49,    50,    52,    53,    54,    35,
-       0,     0,     9,    74,     0,     0,    66,     0,    32,    30,
-      21,    23,    69,     0,    22
+       0,    83,    84,     0,     2,     3,     0,     0,     1,     4,
+      33,     5,    11,     0,     0,     0,     0,    32,     0,     0,
+       0,     0,     0,     0,     0,     0,    17,     0,    81,    82,
+       0,    13,    19,    20,    21,    14,    15,    16,    42,    43,
+      45,    47,    49,    52,    57,    60,     0,    64,    76,    73,
+      74,     0,     6,     0,     8,     0,     0,    69,    74,    67,
+      68,    65,    66,     0,    35,    34,     0,     0,    18,     0,
+       0,    12,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    39,    36,    37,
+       7,     0,    10,    72,     0,     0,     0,     0,     0,    78,
+      79,     0,    46,    48,    50,    51,    53,    54,    55,    56,
+      58,    59,    61,    62,    63,    44,     0,     0,     0,     0,
+       9,     0,    85,     0,     0,    82,     0,    77,     0,    75,
+       0,    40,    38,    75,    22,    24,     0,    80,    41,     0,
+       0,    23,     0,     0,     0,     0,     0,     0,     0,    26,
+       0,     0,     0,    25,     0,     0,     0,    28,    30,    31,
+      27,     0,    29
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
+static const yytype_int16 yydefgoto[] =
 {
-      -1,     3,     4,     5,     6,    51,    52,    14,    29,    30,
-      31,    32,    11,    12,    33,    34,    84,    85,    35,    36,
-      37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
-      95,    47,    56,     7,    63
+      -1,     3,     4,     5,     6,    53,    54,    14,    30,    31,
+      32,    33,    34,   151,   156,   157,    11,    12,    35,    36,
+      88,    89,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,   101,    49,    58,     7,    65
 };
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -101
-static const yytype_int8 yypact[] =
+#define YYPACT_NINF -39
+static const yytype_int16 yypact[] =
 {
-     -17,  -101,  -101,    20,   -17,  -101,    -5,   -20,  -101,  -101,
-    -101,  -101,  -101,    26,    45,    24,    84,  -101,     1,     1,
-       1,     1,     1,     4,    31,    52,    84,  -101,    79,    34,
-    -101,  -101,  -101,  -101,  -101,  -101,  -101,    10,    74,    19,
-      66,    39,    40,  -101,    89,  -101,  -101,  -101,    90,    63,
-    -101,    14,  -101,    64,   103,  -101,  -101,  -101,  -101,  -101,
-    -101,    67,  -101,  -101,    84,    84,  -101,     6,  -101,    84,
-      84,    84,    84,    84,    84,    84,    84,    84,    84,    84,
-      84,    84,    84,    97,   102,  -101,  -101,   -17,  -101,  -101,
-     111,   110,   113,  -101,  -101,    16,    74,    19,    66,    66,
-      39,    39,    39,    39,    40,    40,  -101,  -101,  -101,  -101,
-      84,    63,  -101,  -101,    -5,    -5,  -101,    84,  -101,  -101,
-      85,  -101,  -101,    -5,  -101
+      56,   -39,   -39,     3,    56,   -39,    -1,   -32,   -39,   -39,
+     -39,   -39,   -39,    11,   111,    -4,    65,   -39,    19,    19,
+      19,    19,    19,    15,    13,    21,    65,   -13,   -39,    47,
+      36,   -39,   -39,   -39,   -39,   -39,   -39,   -39,   -39,    39,
+      51,    86,    42,    85,    58,   -39,    61,   -39,   -39,   -39,
+      12,    41,   -39,     5,   -39,    49,    76,   -39,    91,   -39,
+     -39,   -39,   -39,    71,   -39,   -39,    65,    65,   -39,   117,
+      17,   -39,    65,    65,    65,    65,    65,    65,    65,    65,
+      65,    65,    65,    65,    65,    65,    65,    24,   114,   -39,
+     -39,    56,   -39,   -39,    65,   126,   129,   130,    92,   -39,
+     -39,    22,    51,    86,    42,    42,    85,    85,    85,    85,
+      58,    58,   -39,   -39,   -39,   -39,   127,    65,    65,    41,
+     -39,   133,   -39,    -1,    -1,   -39,   137,   -39,    65,   141,
+     145,   -39,   -39,   -39,   119,   -39,    65,   -39,   -39,    -1,
+     148,   -39,    92,   136,    65,   150,   131,    92,   156,   121,
+     158,    -1,   -19,   -39,    92,    92,    23,   -39,   -39,   -39,
+     -39,   -19,   -39
 };
 
 /* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int16 yypgoto[] =
 {
-    -101,  -101,  -101,   120,  -101,  -101,    41,  -101,  -101,  -101,
-    -101,  -101,  -100,  -101,  -101,  -101,  -101,    21,   -10,    47,
-    -101,    58,    60,     3,    46,    17,    18,  -101,    42,  -101,
-    -101,  -101,   -14,   -11,  -101
+     -39,   -39,   -39,   161,   -39,   -39,    75,   -39,   -39,   -39,
+     -39,   -39,   -39,   -39,   -39,     6,   -28,   -39,   -39,   -39,
+     -39,    50,   -12,    83,   -39,    98,    99,    45,   -38,    46,
+      18,   -39,    57,   -39,   -39,   -39,   -14,    -8,   -39
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
    positive, shift that token.  If negative, reduce the rule which
    number is the opposite.  If zero, do what YYDEFACT says.
    If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -62
-static const yytype_int8 yytable[] =
+#define YYTABLE_NINF -72
+static const yytype_int16 yytable[] =
 {
-      48,    10,    48,    49,    53,    16,    54,    61,    16,    48,
-      16,    93,    48,    62,   120,   121,    66,     1,     2,    86,
-       8,   116,    13,   124,    18,    87,    18,   117,    69,    50,
-      15,    19,    20,    19,    20,    64,    21,    22,    21,    22,
-      71,    72,    27,    28,    68,    27,    28,    27,    28,    16,
-      48,    48,    17,    48,    91,    92,    65,    94,     1,     2,
-      55,    57,    58,    59,    60,    18,    77,    78,    48,    79,
-      80,    81,    19,    20,    98,    99,    53,    21,    22,     1,
-       2,    23,    24,    67,    25,    26,    27,    28,    16,    73,
-      74,    75,    76,    70,   104,   105,    48,   106,   107,   108,
-     118,    82,   -61,    48,    18,    83,    88,   122,    89,   110,
-      90,    19,    20,   111,   113,   114,    21,    22,   115,   100,
-     101,   102,   103,   123,     9,    27,    28,    96,   112,   109,
-      97,     0,   119
+      50,    52,    50,     8,    56,    10,    51,    55,   154,    50,
+      90,    64,    50,    13,    68,    15,    91,    66,    63,    16,
+      86,    16,    99,    16,   -70,    67,   155,   127,   160,    69,
+       1,     2,   117,   128,   161,    18,   118,    18,   106,   107,
+     108,   109,    19,    20,    19,    20,    71,    21,    22,    21,
+      22,    70,    50,    50,    96,    97,    50,    72,   100,    28,
+      29,    28,    29,    28,    29,    76,    77,    78,    79,    16,
+      73,    50,    50,    85,   116,    57,    59,    60,    61,    62,
+      50,    93,   121,    55,   126,    18,    87,    82,    83,    84,
+       1,     2,    19,    20,    92,   134,   135,    21,    22,    94,
+     112,   113,   114,    50,    50,   130,   131,    74,    75,    28,
+      29,   141,    80,    81,    50,    16,   137,    95,    17,   104,
+     105,    98,    50,   153,   140,   119,   110,   111,   143,   122,
+      50,    18,   145,   148,   123,   124,   129,   125,    19,    20,
+     158,   159,   133,    21,    22,     1,     2,    23,    24,   136,
+      25,    26,    27,   -71,   138,    28,    29,   139,   142,   144,
+     146,   149,   152,   147,   150,     9,   120,   162,   115,   132,
+     102,     0,   103
 };
 
-static const yytype_int8 yycheck[] =
+static const yytype_int16 yycheck[] =
 {
-      14,     6,    16,    14,    15,     4,    16,     3,     4,    23,
-       4,     5,    26,    23,   114,   115,    26,    34,    35,     5,
-       0,     5,    42,   123,    20,    11,    20,    11,    18,     5,
-       4,    27,    28,    27,    28,     4,    32,    33,    32,    33,
-      21,    22,    41,    42,    10,    41,    42,    41,    42,     4,
-      64,    65,     7,    67,    64,    65,     4,    67,    34,    35,
-      18,    19,    20,    21,    22,    20,    27,    28,    82,    29,
-      30,    31,    27,    28,    71,    72,    87,    32,    33,    34,
-      35,    36,    37,     4,    39,    40,    41,    42,     4,    23,
-      24,    25,    26,    19,    77,    78,   110,    79,    80,    81,
-     110,    12,    12,   117,    20,    42,    42,   117,     5,    12,
-      43,    27,    28,    11,     3,     5,    32,    33,     5,    73,
-      74,    75,    76,    38,     4,    41,    42,    69,    87,    82,
-      70,    -1,   111
+      14,     5,    16,     0,    16,     6,    14,    15,    27,    23,
+       5,    23,    26,    45,    26,     4,    11,     4,     3,     4,
+       8,     4,     5,     4,    12,     4,    45,     5,     5,    42,
+      34,    35,     8,    11,    11,    20,    12,    20,    76,    77,
+      78,    79,    27,    28,    27,    28,    10,    32,    33,    32,
+      33,     4,    66,    67,    66,    67,    70,    18,    70,    44,
+      45,    44,    45,    44,    45,    23,    24,    25,    26,     4,
+      19,    85,    86,    12,    86,    18,    19,    20,    21,    22,
+      94,     5,    94,    91,    98,    20,    45,    29,    30,    31,
+      34,    35,    27,    28,    45,   123,   124,    32,    33,     8,
+      82,    83,    84,   117,   118,   117,   118,    21,    22,    44,
+      45,   139,    27,    28,   128,     4,   128,    46,     7,    74,
+      75,     4,   136,   151,   136,    11,    80,    81,   142,     3,
+     144,    20,   144,   147,     5,     5,     9,    45,    27,    28,
+     154,   155,     9,    32,    33,    34,    35,    36,    37,    12,
+      39,    40,    41,    12,     9,    44,    45,    38,    10,    23,
+      10,     5,     4,    32,    43,     4,    91,   161,    85,   119,
+      72,    -1,    73
 };
 
 /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
    symbol of state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
-       0,    34,    35,    45,    46,    47,    48,    77,     0,    47,
-       6,    56,    57,    42,    51,     4,     4,     7,    20,    27,
-      28,    32,    33,    36,    37,    39,    40,    41,    42,    52,
-      53,    54,    55,    58,    59,    62,    63,    64,    65,    66,
-      67,    68,    69,    70,    71,    72,    73,    75,    76,    77,
-       5,    49,    50,    77,    62,    72,    76,    72,    72,    72,
-      72,     3,    62,    78,     4,     4,    62,     4,    10,    18,
-      19,    21,    22,    23,    24,    25,    26,    27,    28,    29,
-      30,    31,    12,    42,    60,    61,     5,    11,    42,     5,
-      43,    62,    62,     5,    62,    74,    65,    66,    67,    67,
-      68,    68,    68,    68,    69,    69,    70,    70,    70,    63,
-      12,    11,    50,     3,     5,     5,     5,    11,    62,    61,
-      56,    56,    62,    38,    56
+       0,    34,    35,    48,    49,    50,    51,    84,     0,    50,
+       6,    63,    64,    45,    54,     4,     4,     7,    20,    27,
+      28,    32,    33,    36,    37,    39,    40,    41,    44,    45,
+      55,    56,    57,    58,    59,    65,    66,    69,    70,    71,
+      72,    73,    74,    75,    76,    77,    78,    79,    80,    82,
+      83,    84,     5,    52,    53,    84,    69,    79,    83,    79,
+      79,    79,    79,     3,    69,    85,     4,     4,    69,    42,
+       4,    10,    18,    19,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,    31,    12,     8,    45,    67,    68,
+       5,    11,    45,     5,     8,    46,    69,    69,     4,     5,
+      69,    81,    72,    73,    74,    74,    75,    75,    75,    75,
+      76,    76,    77,    77,    77,    70,    69,     8,    12,    11,
+      53,    69,     3,     5,     5,    45,    83,     5,    11,     9,
+      69,    69,    68,     9,    63,    63,    12,    69,     9,    38,
+      69,    63,    10,    83,    23,    69,    10,    32,    83,     5,
+      43,    60,     4,    63,    27,    45,    61,    62,    83,    83,
+       5,    11,    62
 };
 
 #define yyerrok		(yyerrstatus = 0)
@@ -1570,7 +1607,7 @@ yyreduce:
         case 2:
 
 /* Line 1455 of yacc.c  */
-#line 119 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 128 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
              parser_out("program -> function_list");
              interpreter->entry = -1;
@@ -1592,7 +1629,7 @@ yyreduce:
   case 3:
 
 /* Line 1455 of yacc.c  */
-#line 138 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 147 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.symbollist_t) = interpreter->Allocate<symbollist>();
                    (yyval.symbollist_t)->push_back((yyvsp[(1) - (1)].symbol_t));
@@ -1602,7 +1639,7 @@ yyreduce:
   case 4:
 
 /* Line 1455 of yacc.c  */
-#line 143 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 152 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.symbollist_t) = (yyvsp[(1) - (2)].symbollist_t);
                    (yyval.symbollist_t)->push_back((yyvsp[(2) - (2)].symbol_t));
@@ -1612,7 +1649,7 @@ yyreduce:
   case 5:
 
 /* Line 1455 of yacc.c  */
-#line 150 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 159 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
               parser_out("function -> function_header scope");
 
@@ -1664,6 +1701,7 @@ yyreduce:
                   (yyval.symbol_t)->bytecode << OP(OP_POP) << REG(EIP) << NIL;
               }
               
+              interpreter->Eliminate_BoundsChecks((yyval.symbol_t)->bytecode);
               interpreter->Deallocate((yyvsp[(2) - (2)].statlist_t));
               interpreter->current_func = 0;
               
@@ -1674,7 +1712,7 @@ yyreduce:
   case 6:
 
 /* Line 1455 of yacc.c  */
-#line 209 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 219 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      parser_out("function_header -> typename IDENTIFIER LRB RRB");
                      
@@ -1706,7 +1744,7 @@ yyreduce:
   case 7:
 
 /* Line 1455 of yacc.c  */
-#line 236 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 246 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      parser_out("function_header -> typename IDENTIFIER LRB argument_list RRB");
                      
@@ -1759,7 +1797,7 @@ yyreduce:
   case 8:
 
 /* Line 1455 of yacc.c  */
-#line 286 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 296 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.symbollist_t) = interpreter->Allocate<symbollist>();
                    (yyval.symbollist_t)->push_back((yyvsp[(1) - (1)].symbol_t));
@@ -1769,7 +1807,7 @@ yyreduce:
   case 9:
 
 /* Line 1455 of yacc.c  */
-#line 291 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 301 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.symbollist_t) = (yyvsp[(1) - (3)].symbollist_t);
                    (yyval.symbollist_t)->push_back((yyvsp[(3) - (3)].symbol_t));
@@ -1779,7 +1817,7 @@ yyreduce:
   case 10:
 
 /* Line 1455 of yacc.c  */
-#line 298 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 308 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
               (yyval.symbol_t) = interpreter->Allocate<symbol_desc>();
               
@@ -1794,7 +1832,7 @@ yyreduce:
   case 11:
 
 /* Line 1455 of yacc.c  */
-#line 310 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 320 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      parser_out("statement_block -> epsilon");
                      (yyval.statlist_t) = interpreter->Allocate<statlist>();
@@ -1804,7 +1842,7 @@ yyreduce:
   case 12:
 
 /* Line 1455 of yacc.c  */
-#line 315 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 325 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      parser_out("statement_block -> statement_block statement SEMICOLON");
                      
@@ -1816,7 +1854,7 @@ yyreduce:
   case 13:
 
 /* Line 1455 of yacc.c  */
-#line 322 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 332 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      parser_out("statement_block -> statement_block control_block");
                      
@@ -1828,7 +1866,7 @@ yyreduce:
   case 14:
 
 /* Line 1455 of yacc.c  */
-#line 331 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 341 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                parser_out("statement -> print");
                (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
@@ -1838,7 +1876,7 @@ yyreduce:
   case 15:
 
 /* Line 1455 of yacc.c  */
-#line 336 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 346 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                parser_out("statement -> declaration");
                (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
@@ -1848,7 +1886,7 @@ yyreduce:
   case 16:
 
 /* Line 1455 of yacc.c  */
-#line 341 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 351 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                // even if it has no sense, like (5 + 3);
                parser_out("statement -> expr");
@@ -1863,7 +1901,7 @@ yyreduce:
   case 17:
 
 /* Line 1455 of yacc.c  */
-#line 351 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 361 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                parser_out("statement -> RETURN");
                symbol_desc* func = interpreter->current_func;
@@ -1886,7 +1924,7 @@ yyreduce:
   case 18:
 
 /* Line 1455 of yacc.c  */
-#line 369 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 379 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                parser_out("statement -> RETURN expr");
                symbol_desc* func = interpreter->current_func;
@@ -1926,7 +1964,7 @@ yyreduce:
   case 19:
 
 /* Line 1455 of yacc.c  */
-#line 406 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 416 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
                ;}
@@ -1935,7 +1973,7 @@ yyreduce:
   case 20:
 
 /* Line 1455 of yacc.c  */
-#line 410 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 420 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
                ;}
@@ -1944,7 +1982,16 @@ yyreduce:
   case 21:
 
 /* Line 1455 of yacc.c  */
-#line 416 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 424 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+                   (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
+               ;}
+    break;
+
+  case 22:
+
+/* Line 1455 of yacc.c  */
+#line 430 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                  (yyval.stat_t) = interpreter->Allocate<statement_desc>();
                  
@@ -1998,10 +2045,10 @@ yyreduce:
              ;}
     break;
 
-  case 22:
+  case 23:
 
 /* Line 1455 of yacc.c  */
-#line 468 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 482 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                  (yyval.stat_t) = interpreter->Allocate<statement_desc>();
                  
@@ -2089,10 +2136,10 @@ yyreduce:
              ;}
     break;
 
-  case 23:
+  case 24:
 
 /* Line 1455 of yacc.c  */
-#line 556 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 570 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.stat_t) = interpreter->Allocate<statement_desc>();
                 (yyval.stat_t)->bytecode << (yyvsp[(3) - (5)].expr_t)->bytecode;
@@ -2136,10 +2183,180 @@ yyreduce:
             ;}
     break;
 
-  case 24:
+  case 25:
+
+/* Line 1455 of yacc.c  */
+#line 614 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+                   parser_out("parallel_loop -> PARALLEL FOR LRB ... RRB reduction_clause scope");
+                   
+                   nassert(0, "Parallel loop must use the same counter in every clause", (yyvsp[(4) - (16)].symbol_t) != (yyvsp[(8) - (16)].symbol_t) || (yyvsp[(4) - (16)].symbol_t) != (yyvsp[(13) - (16)].symbol_t));
+                   nassert(0, "Counter of parallel loop must be a scalar", (yyvsp[(4) - (16)].symbol_t)->length > 0);
+                   
+                   parallel_desc* desc = interpreter->Allocate<parallel_desc>();
+                   desc->counter = (yyvsp[(4) - (16)].symbol_t)->address;
+                   
+                   if( (yyvsp[(15) - (16)].reductionlist_t) )
+                   {
+                       for( reductionlist::iterator it = (yyvsp[(15) - (16)].reductionlist_t)->begin(); it != (yyvsp[(15) - (16)].reductionlist_t)->end(); ++it )
+                       {
+                           nassert(0, "Counter of parallel loop cannot be reduced", (*it)->address == desc->counter);
+                           
+                           desc->reductions.push_back(**it);
+                           interpreter->Deallocate(*it);
+                       }
+                       
+                       interpreter->Deallocate((yyvsp[(15) - (16)].reductionlist_t));
+                   }
+                   
+                   (yyval.stat_t) = interpreter->Allocate<statement_desc>();
+                   
+                   // counter = first
+                   if( (yyvsp[(6) - (16)].expr_t)->constexpr )
+                   {
+                       int a = atoi((yyvsp[(6) - (16)].expr_t)->value.c_str());
+                       (yyval.stat_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
+                   }
+                   else if( (yyvsp[(6) - (16)].expr_t)->address == UNKNOWN_ADDR )
+                   {
+                       (yyval.stat_t)->bytecode << (yyvsp[(6) - (16)].expr_t)->bytecode;
+                   }
+                   else
+                   {
+                       (yyval.stat_t)->bytecode << (yyvsp[(6) - (16)].expr_t)->bytecode;
+                       (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[(6) - (16)].expr_t)->address;
+                   }
+                   
+                   (yyval.stat_t)->bytecode << OP(OP_MOV_MR) << desc->counter << REG(EAX);
+                   
+                   // last goes into EAX
+                   if( (yyvsp[(10) - (16)].expr_t)->constexpr )
+                   {
+                       int a = atoi((yyvsp[(10) - (16)].expr_t)->value.c_str());
+                       (yyval.stat_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
+                   }
+                   else if( (yyvsp[(10) - (16)].expr_t)->address == UNKNOWN_ADDR )
+                   {
+                       (yyval.stat_t)->bytecode << (yyvsp[(10) - (16)].expr_t)->bytecode;
+                   }
+                   else
+                   {
+                       (yyval.stat_t)->bytecode << (yyvsp[(10) - (16)].expr_t)->bytecode;
+                       (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[(10) - (16)].expr_t)->address;
+                   }
+                   
+                   // calculate offset (the body ends with endpar)
+                   int off = ENTRY_SIZE;
+                   
+                   for( statlist::iterator it = (yyvsp[(16) - (16)].statlist_t)->begin(); it != (yyvsp[(16) - (16)].statlist_t)->end(); ++it )
+                   {
+                       if( *it )
+                       {
+                           bytestream& code = (*it)->bytecode;
+                           
+                           // iterations can't leave the loop
+                           for( size_t i = 0; i < code.size(); i += ENTRY_SIZE )
+                           {
+                               char* ptr = code.seek_set(i);
+                               nassert(0, "Return statement in parallel loop", *((unsigned char*)ptr) == OP_POP && ARG1_INT(ptr) == EIP);
+                           }
+                           
+                           off += (int)code.size();
+                       }
+                   }
+                   
+                   // the calling thread jumps over the body when done
+                   (yyval.stat_t)->bytecode << OP(OP_PARALLEL) << REG(EAX) << ADDR(desc);
+                   (yyval.stat_t)->bytecode << OP(OP_JMP) << off << NIL;
+                   
+                   for( statlist::iterator it = (yyvsp[(16) - (16)].statlist_t)->begin(); it != (yyvsp[(16) - (16)].statlist_t)->end(); ++it )
+                   {
+                       if( *it )
+                       {
+                           (yyval.stat_t)->bytecode << (*it)->bytecode;
+                           interpreter->Deallocate(*it);
+                       }
+                   }
+                   
+                   (yyval.stat_t)->bytecode << OP(OP_ENDPAR) << NIL << NIL;
+                   
+                   interpreter->Deallocate((yyvsp[(6) - (16)].expr_t));
+                   interpreter->Deallocate((yyvsp[(10) - (16)].expr_t));
+                   interpreter->Deallocate((yyvsp[(16) - (16)].statlist_t));
+               ;}
+    break;
+
+  case 26:
+
+/* Line 1455 of yacc.c  */
+#line 714 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+                      (yyval.reductionlist_t) = 0;
+                  ;}
+    break;
+
+  case 27:
+
+/* Line 1455 of yacc.c  */
+#line 718 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+                      (yyval.reductionlist_t) = (yyvsp[(3) - (4)].reductionlist_t);
+                  ;}
+    break;
+
+  case 28:
+
+/* Line 1455 of yacc.c  */
+#line 724 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+                    (yyval.reductionlist_t) = interpreter->Allocate<reductionlist>();
+                    (yyval.reductionlist_t)->push_back((yyvsp[(1) - (1)].reduction_t));
+                ;}
+    break;
+
+  case 29:
+
+/* Line 1455 of yacc.c  */
+#line 729 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+                    (yyval.reductionlist_t) = (yyvsp[(1) - (3)].reductionlist_t);
+                    (yyval.reductionlist_t)->push_back((yyvsp[(3) - (3)].reduction_t));
+                ;}
+    break;
+
+  case 30:
 
 /* Line 1455 of yacc.c  */
-#line 600 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 736 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+               nassert(0, "Array '" << (yyvsp[(2) - (2)].symbol_t)->name << "' cannot be reduced", (yyvsp[(2) - (2)].symbol_t)->length > 0);
+               
+               (yyval.reduction_t) = interpreter->Allocate<reduction_desc>();
+               (yyval.reduction_t)->address = (yyvsp[(2) - (2)].symbol_t)->address;
+               (yyval.reduction_t)->type = Reduce_Add;
+           ;}
+    break;
+
+  case 31:
+
+/* Line 1455 of yacc.c  */
+#line 744 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+               nassert(0, "Unknown reduction '" << *(yyvsp[(1) - (2)].text_t) << "'", *(yyvsp[(1) - (2)].text_t) != "max");
+               nassert(0, "Array '" << (yyvsp[(2) - (2)].symbol_t)->name << "' cannot be reduced", (yyvsp[(2) - (2)].symbol_t)->length > 0);
+               
+               (yyval.reduction_t) = interpreter->Allocate<reduction_desc>();
+               (yyval.reduction_t)->address = (yyvsp[(2) - (2)].symbol_t)->address;
+               (yyval.reduction_t)->type = Reduce_Max;
+               
+               interpreter->Deallocate((yyvsp[(1) - (2)].text_t));
+           ;}
+    break;
+
+  case 32:
+
+/* Line 1455 of yacc.c  */
+#line 757 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
            (yyval.statlist_t) = (yyvsp[(2) - (3)].statlist_t);
            
@@ -2151,7 +2368,7 @@ yyreduce:
            
            for( symboltable::iterator it = table.begin(); it != table.end(); ++it )
            {
-               size += interpreter->Sizeof(it->second->type);
+               size += interpreter->Sizeof(it->second->type) * std::max(it->second->length, 1);
                interpreter->Deallocate(it->second);
            }
            
@@ -2170,19 +2387,19 @@ yyreduce:
        ;}
     break;
 
-  case 25:
+  case 33:
 
 /* Line 1455 of yacc.c  */
-#line 631 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 788 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                  ++interpreter->current_scope;
              ;}
     break;
 
-  case 26:
+  case 34:
 
 /* Line 1455 of yacc.c  */
-#line 637 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 794 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
            parser_out("print -> PRINT string");
            
@@ -2191,10 +2408,10 @@ yyreduce:
        ;}
     break;
 
-  case 27:
+  case 35:
 
 /* Line 1455 of yacc.c  */
-#line 644 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 801 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
            parser_out("print -> PRINT expr");
            (yyval.stat_t) = interpreter->Allocate<statement_desc>();
@@ -2216,10 +2433,10 @@ yyreduce:
        ;}
     break;
 
-  case 28:
+  case 36:
 
 /* Line 1455 of yacc.c  */
-#line 666 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 823 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                  parser_out("declaration -> typename init_declarator_list");
                  
@@ -2230,6 +2447,7 @@ yyreduce:
                  symboltable::iterator sym;
                  symbol_desc* var;
                  expression_desc* expr;
+                 int varsize;
                  
                  (yyval.stat_t) = interpreter->Allocate<statement_desc>();
                  
@@ -2241,16 +2459,20 @@ yyreduce:
                      
                      // save this variable
                      var = interpreter->Allocate<symbol_desc>();
+                     var->name = (*it)->name;
                      var->type = (yyvsp[(1) - (2)].type_t);
+                     var->length = (*it)->length;
                      
                      table[(*it)->name] = var;
                      
-                     // update address
-                     interpreter->alloc_addr += interpreter->Sizeof((yyvsp[(1) - (2)].type_t));
+                     // update address (arrays start at the lowest address)
+                     varsize = interpreter->Sizeof((yyvsp[(1) - (2)].type_t)) * std::max(var->length, 1);
+                     
+                     interpreter->alloc_addr += varsize;
                      var->address = -interpreter->alloc_addr;
                      
                      // extend size
-                     size += interpreter->Sizeof((yyvsp[(1) - (2)].type_t));
+                     size += varsize;
                  }
                  
                  (yyval.stat_t)->bytecode << OP(OP_SUB_RS) << REG(ESP) << size;
@@ -2293,10 +2515,10 @@ yyreduce:
              ;}
     break;
 
-  case 29:
+  case 37:
 
 /* Line 1455 of yacc.c  */
-#line 740 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 902 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                           parser_out("init_declarator_list -> init_declarator");
                           
@@ -2305,10 +2527,10 @@ yyreduce:
                       ;}
     break;
 
-  case 30:
+  case 38:
 
 /* Line 1455 of yacc.c  */
-#line 747 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 909 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                           parser_out("init_declarator_list -> init_declarator_list COMMA init_declarator");
                           
@@ -2317,10 +2539,10 @@ yyreduce:
                       ;}
     break;
 
-  case 31:
+  case 39:
 
 /* Line 1455 of yacc.c  */
-#line 756 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 918 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      parser_out("init_declarator -> IDENTIFIER");
                      
@@ -2331,10 +2553,10 @@ yyreduce:
                  ;}
     break;
 
-  case 32:
+  case 40:
 
 /* Line 1455 of yacc.c  */
-#line 765 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 927 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      parser_out("init_declarator -> IDENTIFIER EQ expr");
                      
@@ -2346,29 +2568,49 @@ yyreduce:
                  ;}
     break;
 
-  case 33:
+  case 41:
+
+/* Line 1455 of yacc.c  */
+#line 937 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+                     parser_out("init_declarator -> IDENTIFIER LSB expr RSB");
+                     
+                     assert(0, "Size of array '" << *(yyvsp[(1) - (4)].text_t) << "' is not a constant expression", (yyvsp[(3) - (4)].expr_t)->constexpr);
+                     
+                     (yyval.decl_t) = interpreter->Allocate<declaration_desc>();
+                     (yyval.decl_t)->name = *(yyvsp[(1) - (4)].text_t);
+                     (yyval.decl_t)->length = atoi((yyvsp[(3) - (4)].expr_t)->value.c_str());
+                     
+                     nassert(0, "Size of array '" << *(yyvsp[(1) - (4)].text_t) << "' must be positive", (yyval.decl_t)->length <= 0);
+
+                     interpreter->Deallocate((yyvsp[(1) - (4)].text_t));
+                     interpreter->Deallocate((yyvsp[(3) - (4)].expr_t));
+                 ;}
+    break;
+
+  case 42:
 
 /* Line 1455 of yacc.c  */
-#line 777 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 954 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
           parser_out("expr -> assignment");
           (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
       ;}
     break;
 
-  case 34:
+  case 43:
 
 /* Line 1455 of yacc.c  */
-#line 784 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 961 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
             ;}
     break;
 
-  case 35:
+  case 44:
 
 /* Line 1455 of yacc.c  */
-#line 788 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 965 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 parser_out("assignment -> lvalue = assignment");
 
@@ -2377,7 +2619,12 @@ yyreduce:
 
                 (yyval.expr_t) = (yyvsp[(1) - (3)].expr_t);
 
-                if( (yyvsp[(3) - (3)].expr_t)->constexpr )
+                if( (yyvsp[(1) - (3)].expr_t)->index )
+                {
+                    // array element with runtime subscript
+                    interpreter->Store_Element((yyval.expr_t), (yyvsp[(3) - (3)].expr_t));
+                }
+                else if( (yyvsp[(3) - (3)].expr_t)->constexpr )
                 {
                     int a = atoi((yyvsp[(3) - (3)].expr_t)->value.c_str());
 
@@ -2399,190 +2646,190 @@ yyreduce:
             ;}
     break;
 
-  case 36:
+  case 45:
 
 /* Line 1455 of yacc.c  */
-#line 819 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1001 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
                ;}
     break;
 
-  case 37:
+  case 46:
 
 /* Line 1455 of yacc.c  */
-#line 823 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1005 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_OR_RR);
                ;}
     break;
 
-  case 38:
+  case 47:
 
 /* Line 1455 of yacc.c  */
-#line 829 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1011 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                     (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
                 ;}
     break;
 
-  case 39:
+  case 48:
 
 /* Line 1455 of yacc.c  */
-#line 833 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1015 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                     (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_AND_RR);
                 ;}
     break;
 
-  case 40:
+  case 49:
 
 /* Line 1455 of yacc.c  */
-#line 839 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1021 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                   (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
               ;}
     break;
 
-  case 41:
+  case 50:
 
 /* Line 1455 of yacc.c  */
-#line 843 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1025 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETE_RR);
               ;}
     break;
 
-  case 42:
+  case 51:
 
 /* Line 1455 of yacc.c  */
-#line 847 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1029 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETNE_RR);
               ;}
     break;
 
-  case 43:
+  case 52:
 
 /* Line 1455 of yacc.c  */
-#line 853 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1035 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
                ;}
     break;
 
-  case 44:
+  case 53:
 
 /* Line 1455 of yacc.c  */
-#line 857 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1039 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETL_RR);
                ;}
     break;
 
-  case 45:
+  case 54:
 
 /* Line 1455 of yacc.c  */
-#line 861 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1043 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETLE_RR);
                ;}
     break;
 
-  case 46:
+  case 55:
 
 /* Line 1455 of yacc.c  */
-#line 865 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1047 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETG_RR);
                ;}
     break;
 
-  case 47:
+  case 56:
 
 /* Line 1455 of yacc.c  */
-#line 869 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1051 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETGE_RR);
                ;}
     break;
 
-  case 48:
+  case 57:
 
 /* Line 1455 of yacc.c  */
-#line 875 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1057 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
                ;}
     break;
 
-  case 49:
+  case 58:
 
 /* Line 1455 of yacc.c  */
-#line 879 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1061 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_ADD_RR);
                ;}
     break;
 
-  case 50:
+  case 59:
 
 /* Line 1455 of yacc.c  */
-#line 883 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1065 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SUB_RR);
                ;}
     break;
 
-  case 51:
+  case 60:
 
 /* Line 1455 of yacc.c  */
-#line 889 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1071 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                          (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
                      ;}
     break;
 
-  case 52:
+  case 61:
 
 /* Line 1455 of yacc.c  */
-#line 893 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1075 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                          (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_MUL_RR);
                      ;}
     break;
 
-  case 53:
+  case 62:
 
 /* Line 1455 of yacc.c  */
-#line 897 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1079 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                          (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_DIV_RR);
                      ;}
     break;
 
-  case 54:
+  case 63:
 
 /* Line 1455 of yacc.c  */
-#line 901 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1083 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                          (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_MOD_RR);
                      ;}
     break;
 
-  case 55:
+  case 64:
 
 /* Line 1455 of yacc.c  */
-#line 907 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1089 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
             ;}
     break;
 
-  case 56:
+  case 65:
 
 /* Line 1455 of yacc.c  */
-#line 911 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1093 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Inc);
                 
@@ -2591,10 +2838,10 @@ yyreduce:
             ;}
     break;
 
-  case 57:
+  case 66:
 
 /* Line 1455 of yacc.c  */
-#line 918 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1100 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Dec);
                 
@@ -2603,19 +2850,19 @@ yyreduce:
             ;}
     break;
 
-  case 58:
+  case 67:
 
 /* Line 1455 of yacc.c  */
-#line 925 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1107 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.expr_t) = (yyvsp[(2) - (2)].expr_t);
             ;}
     break;
 
-  case 59:
+  case 68:
 
 /* Line 1455 of yacc.c  */
-#line 929 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1111 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Neg);
                 
@@ -2624,10 +2871,10 @@ yyreduce:
             ;}
     break;
 
-  case 60:
+  case 69:
 
 /* Line 1455 of yacc.c  */
-#line 936 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1118 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                 (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Not);
                 
@@ -2636,11 +2883,12 @@ yyreduce:
             ;}
     break;
 
-  case 61:
+  case 70:
 
 /* Line 1455 of yacc.c  */
-#line 945 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1127 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
+            nassert(0, "Array '" << (yyvsp[(1) - (1)].symbol_t)->name << "' is not assignable", (yyvsp[(1) - (1)].symbol_t)->length > 0);
             (yyval.expr_t) = interpreter->Allocate<expression_desc>();
 
             (yyval.expr_t)->address = (yyvsp[(1) - (1)].symbol_t)->address;
@@ -2648,32 +2896,46 @@ yyreduce:
         ;}
     break;
 
-  case 62:
+  case 71:
 
 /* Line 1455 of yacc.c  */
-#line 954 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1135 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+            (yyval.expr_t) = interpreter->Subscript_Expr((yyvsp[(1) - (4)].symbol_t), (yyvsp[(3) - (4)].expr_t));
+            
+            if( !(yyval.expr_t) )
+                return 0;
+        ;}
+    break;
+
+  case 72:
+
+/* Line 1455 of yacc.c  */
+#line 1144 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
           parser_out("term -> (expr)");
           (yyval.expr_t) = (yyvsp[(2) - (3)].expr_t);
       ;}
     break;
 
-  case 63:
+  case 73:
 
 /* Line 1455 of yacc.c  */
-#line 959 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1149 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
           parser_out("term -> literal");
           (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
       ;}
     break;
 
-  case 64:
+  case 74:
 
 /* Line 1455 of yacc.c  */
-#line 964 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1154 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
           parser_out("term -> variable");
+          nassert(0, "Array '" << (yyvsp[(1) - (1)].symbol_t)->name << "' used without subscript", (yyvsp[(1) - (1)].symbol_t)->length > 0);
+          
           (yyval.expr_t) = interpreter->Allocate<expression_desc>();
 
           (yyval.expr_t)->address = (yyvsp[(1) - (1)].symbol_t)->address;
@@ -2682,10 +2944,27 @@ yyreduce:
       ;}
     break;
 
-  case 65:
+  case 75:
 
 /* Line 1455 of yacc.c  */
-#line 973 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1165 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+    {
+          parser_out("term -> variable[expr]");
+          (yyval.expr_t) = interpreter->Subscript_Expr((yyvsp[(1) - (4)].symbol_t), (yyvsp[(3) - (4)].expr_t));
+          
+          if( !(yyval.expr_t) )
+              return 0;
+          
+          // load it into EAX
+          if( (yyval.expr_t)->index )
+              interpreter->Load_Element((yyval.expr_t));
+      ;}
+    break;
+
+  case 76:
+
+/* Line 1455 of yacc.c  */
+#line 1177 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
           parser_out("term -> func_call");
           (yyval.expr_t) = interpreter->Allocate<expression_desc>();
@@ -2740,10 +3019,10 @@ yyreduce:
       ;}
     break;
 
-  case 66:
+  case 77:
 
 /* Line 1455 of yacc.c  */
-#line 1028 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1232 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                // look for this function in the global scope
                symboltable::iterator sym;
@@ -2761,10 +3040,10 @@ yyreduce:
            ;}
     break;
 
-  case 67:
+  case 78:
 
 /* Line 1455 of yacc.c  */
-#line 1044 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1248 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                // look for this function in the global scope
                symboltable::iterator sym;
@@ -2782,30 +3061,30 @@ yyreduce:
            ;}
     break;
 
-  case 68:
+  case 79:
 
 /* Line 1455 of yacc.c  */
-#line 1062 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1266 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      (yyval.exprlist_t) = interpreter->Allocate<exprlist>();
                      (yyval.exprlist_t)->push_back((yyvsp[(1) - (1)].expr_t));
                  ;}
     break;
 
-  case 69:
+  case 80:
 
 /* Line 1455 of yacc.c  */
-#line 1067 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1271 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
                      (yyval.exprlist_t) = (yyvsp[(1) - (3)].exprlist_t);
                      (yyval.exprlist_t)->push_back((yyvsp[(3) - (3)].expr_t));
                  ;}
     break;
 
-  case 70:
+  case 81:
 
 /* Line 1455 of yacc.c  */
-#line 1074 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1278 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
              parser_out("literal -> NUMBER");
              (yyval.expr_t) = interpreter->Allocate<expression_desc>();
@@ -2819,10 +3098,10 @@ yyreduce:
          ;}
     break;
 
-  case 71:
+  case 82:
 
 /* Line 1455 of yacc.c  */
-#line 1088 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1292 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
               parser_out("variable -> IDENTIFIER");
               
@@ -2849,30 +3128,30 @@ yyreduce:
           ;}
     break;
 
-  case 72:
+  case 83:
 
 /* Line 1455 of yacc.c  */
-#line 1115 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1319 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
               parser_out("typename -> INT");
               (yyval.type_t) = Type_Integer;
           ;}
     break;
 
-  case 73:
+  case 84:
 
 /* Line 1455 of yacc.c  */
-#line 1120 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1324 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
               parser_out("typename -> VOID");
               (yyval.type_t) = Type_Unknown;
           ;}
     break;
 
-  case 74:
+  case 85:
 
 /* Line 1455 of yacc.c  */
-#line 1127 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1331 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
     {
             parser_out("string -> QUOTE STRING QUOTE");
             (yyval.text_t) = (yyvsp[(2) - (3)].text_t);
@@ -2882,7 +3161,7 @@ yyreduce:
 
 
 /* Line 1455 of yacc.c  */
-#line 2886 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
+#line 3165 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
       default: break;
     }
   YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
@@ -3101,7 +3380,7 @@ yyreturn:
 
 
 /* Line 1675 of yacc.c  */
-#line 1133 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1337 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
 
 
 #ifdef _MSC_VER
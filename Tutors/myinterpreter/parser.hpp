@@ -77,9 +77,12 @@
      ELSE = 293,
      WHILE = 294,
      RETURN = 295,
-     NUMBER = 296,
-     IDENTIFIER = 297,
-     STRING = 298
+     PARALLEL = 296,
+     FOR = 297,
+     REDUCE = 298,
+     NUMBER = 299,
+     IDENTIFIER = 300,
+     STRING = 301
    };
 #endif
 
@@ -101,12 +104,14 @@ typedef union YYSTYPE
     decllist*         decllist_t;
     expression_desc*  expr_t;
     exprlist*         exprlist_t;
+    reduction_desc*   reduction_t;
+    reductionlist*    reductionlist_t;
     symbol_type       type_t;
 
 
 
 /* Line 1676 of yacc.c  */
-#line 110 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.hpp"
+#line 115 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.hpp"
 } YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define yystype YYSTYPE /* obsolescent; will be withdrawn */
@@ -40,6 +40,8 @@ extern std::string& replace(
     decllist*         decllist_t;
     expression_desc*  expr_t;
     exprlist*         exprlist_t;
+    reduction_desc*   reduction_t;
+    reductionlist*    reductionlist_t;
     symbol_type       type_t;
 }
 
@@ -70,6 +72,9 @@ extern std::string& replace(
 %token               ELSE
 %token               WHILE
 %token               RETURN
+%token               PARALLEL
+%token               FOR
+%token               REDUCE
 
 // literals
 %token<text_t>       NUMBER
@@ -92,11 +97,15 @@ extern std::string& replace(
 %type<statlist_t>    statement_block
 %type<statlist_t>    scope
 %type<exprlist_t>    expression_list
+%type<reduction_t>   reduction
+%type<reductionlist_t> reduction_list
+%type<reductionlist_t> reduction_clause
 
 %type<stat_t>        print
 %type<stat_t>        declaration
 %type<stat_t>        conditional
 %type<stat_t>        while_loop
+%type<stat_t>        parallel_loop
 %type<stat_t>        control_block
 %type<stat_t>        statement
 
@@ -198,6 +207,7 @@ function: function_header scope
                   $$->bytecode << OP(OP_POP) << REG(EIP) << NIL;
               }
               
+              interpreter->Eliminate_BoundsChecks($$->bytecode);
               interpreter->Deallocate($2);
               interpreter->current_func = 0;
               
@@ -410,6 +420,10 @@ control_block: conditional
                {
                    $$ = $1;
                }
+             | parallel_loop
+               {
+                   $$ = $1;
+               }
 ;
 
 conditional: IF LRB expr RRB scope
@@ -596,6 +610,149 @@ while_loop: WHILE LRB expr RRB scope
             }
 ;
 
+parallel_loop: PARALLEL FOR LRB variable EQ expr SEMICOLON variable LT expr SEMICOLON INC variable RRB reduction_clause scope
+               {
+                   parser_out("parallel_loop -> PARALLEL FOR LRB ... RRB reduction_clause scope");
+                   
+                   nassert(0, "Parallel loop must use the same counter in every clause", $4 != $8 || $4 != $13);
+                   nassert(0, "Counter of parallel loop must be a scalar", $4->length > 0);
+                   
+                   parallel_desc* desc = interpreter->Allocate<parallel_desc>();
+                   desc->counter = $4->address;
+                   
+                   if( $15 )
+                   {
+                       for( reductionlist::iterator it = $15->begin(); it != $15->end(); ++it )
+                       {
+                           nassert(0, "Counter of parallel loop cannot be reduced", (*it)->address == desc->counter);
+                           
+                           desc->reductions.push_back(**it);
+                           interpreter->Deallocate(*it);
+                       }
+                       
+                       interpreter->Deallocate($15);
+                   }
+                   
+                   $$ = interpreter->Allocate<statement_desc>();
+                   
+                   // counter = first
+                   if( $6->constexpr )
+                   {
+                       int a = atoi($6->value.c_str());
+                       $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
+                   }
+                   else if( $6->address == UNKNOWN_ADDR )
+                   {
+                       $$->bytecode << $6->bytecode;
+                   }
+                   else
+                   {
+                       $$->bytecode << $6->bytecode;
+                       $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << $6->address;
+                   }
+                   
+                   $$->bytecode << OP(OP_MOV_MR) << desc->counter << REG(EAX);
+                   
+                   // last goes into EAX
+                   if( $10->constexpr )
+                   {
+                       int a = atoi($10->value.c_str());
+                       $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
+                   }
+                   else if( $10->address == UNKNOWN_ADDR )
+                   {
+                       $$->bytecode << $10->bytecode;
+                   }
+                   else
+                   {
+                       $$->bytecode << $10->bytecode;
+                       $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << $10->address;
+                   }
+                   
+                   // calculate offset (the body ends with endpar)
+                   int off = ENTRY_SIZE;
+                   
+                   for( statlist::iterator it = $16->begin(); it != $16->end(); ++it )
+                   {
+                       if( *it )
+                       {
+                           bytestream& code = (*it)->bytecode;
+                           
+                           // iterations can't leave the loop
+                           for( size_t i = 0; i < code.size(); i += ENTRY_SIZE )
+                           {
+                               char* ptr = code.seek_set(i);
+                               nassert(0, "Return statement in parallel loop", *((unsigned char*)ptr) == OP_POP && ARG1_INT(ptr) == EIP);
+                           }
+                           
+                           off += (int)code.size();
+                       }
+                   }
+                   
+                   // the calling thread jumps over the body when done
+                   $$->bytecode << OP(OP_PARALLEL) << REG(EAX) << ADDR(desc);
+                   $$->bytecode << OP(OP_JMP) << off << NIL;
+                   
+                   for( statlist::iterator it = $16->begin(); it != $16->end(); ++it )
+                   {
+                       if( *it )
+                       {
+                           $$->bytecode << (*it)->bytecode;
+                           interpreter->Deallocate(*it);
+                       }
+                   }
+                   
+                   $$->bytecode << OP(OP_ENDPAR) << NIL << NIL;
+                   
+                   interpreter->Deallocate($6);
+                   interpreter->Deallocate($10);
+                   interpreter->Deallocate($16);
+               }
+;
+
+reduction_clause: /* empty */
+                  {
+                      $$ = 0;
+                  }
+                | REDUCE LRB reduction_list RRB
+                  {
+                      $$ = $3;
+                  }
+;
+
+reduction_list: reduction
+                {
+                    $$ = interpreter->Allocate<reductionlist>();
+                    $$->push_back($1);
+                }
+              | reduction_list COMMA reduction
+                {
+                    $$ = $1;
+                    $$->push_back($3);
+                }
+;
+
+reduction: PLUS variable
+           {
+               nassert(0, "Array '" << $2->name << "' cannot be reduced", $2->length > 0);
+               
+               $$ = interpreter->Allocate<reduction_desc>();
+               $$->address = $2->address;
+               $$->type = Reduce_Add;
+           }
+         | IDENTIFIER variable
+           {
+               nassert(0, "Unknown reduction '" << *$1 << "'", *$1 != "max");
+               nassert(0, "Array '" << $2->name << "' cannot be reduced", $2->length > 0);
+               
+               $$ = interpreter->Allocate<reduction_desc>();
+               $$->address = $2->address;
+               $$->type = Reduce_Max;
+               
+               interpreter->Deallocate($1);
+           }
+;
+
 scope: scope_start statement_block RB
        {
            $$ = $2;
@@ -608,7 +765,7 @@ scope: scope_start statement_block RB
            
            for( symboltable::iterator it = table.begin(); it != table.end(); ++it )
            {
-               size += interpreter->Sizeof(it->second->type);
+               size += interpreter->Sizeof(it->second->type) * std::max(it->second->length, 1);
                interpreter->Deallocate(it->second);
            }
            
@@ -673,6 +830,7 @@ declaration: typename init_declarator_list
                  symboltable::iterator sym;
                  symbol_desc* var;
                  expression_desc* expr;
+                 int varsize;
                  
                  $$ = interpreter->Allocate<statement_desc>();
                  
@@ -684,16 +842,20 @@ declaration: typename init_declarator_list
                      
                      // save this variable
                      var = interpreter->Allocate<symbol_desc>();
+                     var->name = (*it)->name;
                      var->type = $1;
+                     var->length = (*it)->length;
                      
                      table[(*it)->name] = var;
                      
-                     // update address
-                     interpreter->alloc_addr += interpreter->Sizeof($1);
+                     // update address (arrays start at the lowest address)
+                     varsize = interpreter->Sizeof($1) * std::max(var->length, 1);
+                     
+                     interpreter->alloc_addr += varsize;
                      var->address = -interpreter->alloc_addr;
                      
                      // extend size
-                     size += interpreter->Sizeof($1);
+                     size += varsize;
                  }
                  
                  $$->bytecode << OP(OP_SUB_RS) << REG(ESP) << size;
@@ -771,6 +933,21 @@ init_declarator: IDENTIFIER
 
                      interpreter->Deallocate($1);
                  }
+               | IDENTIFIER LSB expr RSB
+                 {
+                     parser_out("init_declarator -> IDENTIFIER LSB expr RSB");
+                     
+                     assert(0, "Size of array '" << *$1 << "' is not a constant expression", $3->constexpr);
+                     
+                     $$ = interpreter->Allocate<declaration_desc>();
+                     $$->name = *$1;
+                     $$->length = atoi($3->value.c_str());
+                     
+                     nassert(0, "Size of array '" << *$1 << "' must be positive", $$->length <= 0);
+
+                     interpreter->Deallocate($1);
+                     interpreter->Deallocate($3);
+                 }
 ;
 
 expr: assignment
@@ -793,7 +970,12 @@ assignment: or_level_expr
 
                 $$ = $1;
 
-                if( $3->constexpr )
+                if( $1->index )
+                {
+                    // array element with runtime subscript
+                    interpreter->Store_Element($$, $3);
+                }
+                else if( $3->constexpr )
                 {
                     int a = atoi($3->value.c_str());
 
@@ -943,11 +1125,19 @@ unary_expr: term
           
 lvalue: variable
         {
+            nassert(0, "Array '" << $1->name << "' is not assignable", $1->length > 0);
             $$ = interpreter->Allocate<expression_desc>();
 
             $$->address = $1->address;
             $$->constexpr = false;
         }
+      | variable LSB expr RSB
+        {
+            $$ = interpreter->Subscript_Expr($1, $3);
+            
+            if( !$$ )
+                return 0;
+        }
 ;
 
 term: LRB expr RRB
@@ -963,12 +1153,26 @@ term: LRB expr RRB
     | variable
       {
           parser_out("term -> variable");
+          nassert(0, "Array '" << $1->name << "' used without subscript", $1->length > 0);
+          
           $$ = interpreter->Allocate<expression_desc>();
 
           $$->address = $1->address;
           $$->constexpr = false;
           $$->type = $1->type;
       }
+    | variable LSB expr RSB
+      {
+          parser_out("term -> variable[expr]");
+          $$ = interpreter->Subscript_Expr($1, $3);
+          
+          if( !$$ )
+              return 0;
+          
+          // load it into EAX
+          if( $$->index )
+              interpreter->Load_Element($$);
+      }
     | func_call
       {
           parser_out("term -> func_call");
@@ -0,0 +1,35 @@
+
+int main()
+{
+	int fib[20];
+	int i = 2;
+	int sum = 0;
+	
+	fib[0] = 0;
+	fib[1] = 1;
+	
+	// no bounds check needed here
+	while( i < 20 )
+	{
+		fib[i] = fib[i - 1] + fib[i - 2];
+		++i;
+	}
+	
+	i = 0;
+	
+	while( i < 20 )
+	{
+		sum = sum + fib[i];
+		++i;
+	}
+	
+	print "The sum of the first 20 Fibonacci numbers is: ";
+	print sum;
+	print "\n";
+	
+	// this one is checked
+	print fib[sum % 20];
+	print "\n";
+	
+	return 0;
+}
@@ -0,0 +1,47 @@
+
+int collatz(int n)
+{
+	int steps = 0;
+	
+	while( n != 1 )
+	{
+		if( n % 2 == 0 ) {
+			n = n / 2;
+		} else {
+			n = 3 * n + 1;
+		}
+		
+		++steps;
+	}
+	
+	return steps;
+}
+
+int main()
+{
+	int steps[1000];
+	int i;
+	int total = 0;
+	int longest = 0;
+	
+	// iterations are independent, so they can run on every core
+	parallel for( i = 0; i < 1000; ++i ) reduce(+ total, max longest)
+	{
+		steps[i] = collatz(i + 1);
+		total = total + steps[i];
+		
+		if( steps[i] > longest ) {
+			longest = steps[i];
+		}
+	}
+	
+	print "Total number of Collatz steps below 1000: ";
+	print total;
+	print "\nLongest sequence: ";
+	print longest;
+	print "\nSteps of 27: ";
+	print steps[26];
+	print "\n";
+	
+	return 0;
+}
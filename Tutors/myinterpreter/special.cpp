@@ -4,13 +4,13 @@
 
 extern Interpreter* interpreter;
 
-void Interpreter::Print_Reg(void* arg1, void* arg2)
+void Interpreter::Print_Reg(int* registers, void* arg1, void* arg2)
 {
 	int reg = reinterpret_cast<int>(arg1);
-	std::cout << interpreter->registers[reg];
+	std::cout << registers[reg];
 }
 
-void Interpreter::Print_Memory(void* arg1, void* arg2)
+void Interpreter::Print_Memory(int* registers, void* arg1, void* arg2)
 {
 	std::string* str = reinterpret_cast<std::string*>(arg1);
 
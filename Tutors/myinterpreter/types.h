@@ -36,8 +36,12 @@ struct expression_desc
 	int		   address;
 	bool		  constexpr;
 
+	// array element with a non-constant subscript
+	expression_desc* index;
+	int		   length;
+
 	expression_desc()
-		: address(0), constexpr(false) {}
+		: address(0), constexpr(false), index(0), length(0) {}
 };
 
 struct declaration_desc
@@ -45,9 +49,10 @@ struct declaration_desc
 	std::string name;
 	bytestream bytecode;
 	expression_desc* expr;
+	int length;			// number of elements if array
 
 	declaration_desc()
-		: expr(0) {}
+		: expr(0), length(0) {}
 };
 
 struct statement_desc
@@ -71,14 +76,39 @@ struct symbol_desc
 
 	int		  address;
 	int		  type;
+	int		  length;	// number of elements if array
 	bool		 isfunc;
 
 	symbol_desc()
-		: args(0), address(0), type(Type_Unknown), isfunc(false)
+		: args(0), address(0), type(Type_Unknown), length(0), isfunc(false)
 	{
 	}
 };
 
+enum reduction_type
+{
+	Reduce_Add,
+	Reduce_Max
+};
+
+struct reduction_desc
+{
+	int address;
+	int type;
+
+	reduction_desc()
+		: address(0), type(Reduce_Add) {}
+};
+
+struct parallel_desc
+{
+	int counter;	// address of loop variable
+	std::vector<reduction_desc> reductions;
+
+	parallel_desc()
+		: counter(0) {}
+};
+
 struct unresolved_reference
 {
 	symbol_desc* func;	// if function call
@@ -90,6 +120,7 @@ struct unresolved_reference
 
 typedef std::list<symbol_desc*> symbollist;
 typedef std::list<statement_desc*> statlist;
+typedef std::list<reduction_desc*> reductionlist;
 typedef std::map<std::string, symbol_desc*> symboltable;
 typedef std::vector<symboltable> scopetable;
 
@@ -0,0 +1,155 @@
+
+#ifndef _ALLOCATOR_HPP_
+#define _ALLOCATOR_HPP_
+
+#include <vector>
+
+#include "functional.hpp"
+
+// minimum size of a pool block in bytes
+#define MYSTL_POOL_BLOCK_SIZE	4096
+
+namespace mystl
+{
+	// node allocators hand out uninitialized memory for one T:
+	//   T* allocate();
+	//   void deallocate(T* ptr);
+	//   void reset();	// every allocation has been given back
+
+	template <typename T>
+	class heap_allocator
+	{
+	public:
+		inline T* allocate() {
+			return (T*)malloc(sizeof(T));
+		}
+
+		inline void deallocate(T* ptr) {
+			free(ptr);
+		}
+
+		inline void reset() {
+			// nothing to do
+		}
+	};
+
+	// allocates cache line aligned blocks and carves them up; freed slots are kept on a free list
+	template <typename T>
+	class pool_allocator
+	{
+	private:
+		static const size_t alignment = (std::alignment_of<T>::value > sizeof(void*) ? std::alignment_of<T>::value : sizeof(void*));
+		static const size_t slotsize = ((sizeof(T) + alignment - 1) / alignment) * alignment;
+		static const size_t blocksize = (slotsize * 16 > MYSTL_POOL_BLOCK_SIZE ? slotsize * 16 : MYSTL_POOL_BLOCK_SIZE);
+
+		std::vector<char*> blocks;	// as returned by malloc
+		void* freelist;
+		char* next;					// first untouched slot in current block
+		char* last;					// end of current block
+		size_t current;
+
+		void _nextblock();
+
+		pool_allocator& operator =(const pool_allocator& other);
+
+	public:
+		pool_allocator();
+		pool_allocator(const pool_allocator& other);
+		~pool_allocator();
+
+		T* allocate();
+
+		void deallocate(T* ptr);
+		void reset();
+		void release();
+	};
+
+	template <typename T>
+	pool_allocator<T>::pool_allocator()
+	{
+		freelist = 0;
+		next = 0;
+		last = 0;
+		current = (size_t)-1;
+	}
+
+	template <typename T>
+	pool_allocator<T>::pool_allocator(const pool_allocator& other)
+	{
+		// pools are never shared
+		freelist = 0;
+		next = 0;
+		last = 0;
+		current = (size_t)-1;
+	}
+
+	template <typename T>
+	pool_allocator<T>::~pool_allocator()
+	{
+		release();
+	}
+
+	template <typename T>
+	void pool_allocator<T>::_nextblock()
+	{
+		// blocks are kept after reset(), use them again first
+		++current;
+
+		if( current == blocks.size() )
+			blocks.push_back((char*)malloc(blocksize + 64));
+
+		char* block = blocks[current];
+
+		next = block + 64 - ((size_t)block % 64);
+		last = next + blocksize;
+	}
+
+	template <typename T>
+	T* pool_allocator<T>::allocate()
+	{
+		if( freelist )
+		{
+			void* ptr = freelist;
+			freelist = *((void**)ptr);
+
+			return (T*)ptr;
+		}
+
+		// consecutive allocations are next to each other
+		if( next + slotsize > last )
+			_nextblock();
+
+		T* ptr = (T*)next;
+		next += slotsize;
+
+		return ptr;
+	}
+
+	template <typename T>
+	void pool_allocator<T>::deallocate(T* ptr)
+	{
+		*((void**)ptr) = freelist;
+		freelist = ptr;
+	}
+
+	template <typename T>
+	void pool_allocator<T>::reset()
+	{
+		freelist = 0;
+		next = 0;
+		last = 0;
+		current = (size_t)-1;
+	}
+
+	template <typename T>
+	void pool_allocator<T>::release()
+	{
+		for( size_t i = 0; i < blocks.size(); ++i )
+			free(blocks[i]);
+
+		blocks.clear();
+		reset();
+	}
+}
+
+#endif
@@ -0,0 +1,561 @@
+
+#include <iostream>
+#include <vector>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <list>
+#include <algorithm>
+
+#include "orderedarray.hpp"
+#include "orderedmultiarray.hpp"
+#include "static_orderedarray.hpp"
+#include "orderedmap.hpp"
+#include "small_orderedarray.hpp"
+#include "list.hpp"
+#include "intrusive_list.hpp"
+
+// one-by-one insertion is quadratic, don't wait for it above this
+#define MAX_SINGLE_INSERTS	131072
+
+// a 32 bit process can't hold the largest arrays
+#define MAX_SEARCH_ELEMENTS	(sizeof(void*) > 4 ? 100000000 : 10000000)
+#define NUM_QUERIES			2000000
+
+#define MAX_MAP_ELEMENTS	1000000
+#define NUM_NAME_QUERIES	1000000
+
+// typical key + payload struct (like OpenGLEffect::Uniform used to be)
+struct NamedRecord
+{
+	char	Name[32];
+	float	Payload[24];
+
+	inline bool operator <(const NamedRecord& other) const {
+		return (0 > strcmp(Name, other.Name));
+	}
+};
+
+struct Record
+{
+	float	Payload[24];
+};
+
+#define QUEUE_LENGTH		1000
+#define NUM_QUEUE_OPS		10000000
+#define TRAVERSAL_LENGTH	1000000
+#define NUM_TRAVERSALS		20
+
+#define NUM_SMALL_ARRAYS	100000
+#define MAX_SMALL_SIZE		12
+#define NUM_SMALL_QUERIES	10000000
+
+#define MALLOC_OVERHEAD		16
+
+typedef mystl::small_orderedarray<int, 8> smallintarray8;
+typedef mystl::small_orderedarray<int, 16> smallintarray16;
+
+inline bool IsInline(const mystl::orderedarray<int>&)	{ return false; }
+inline bool IsInline(const smallintarray8& arr)			{ return arr.is_inline(); }
+inline bool IsInline(const smallintarray16& arr)		{ return arr.is_inline(); }
+
+struct QueueItem
+{
+	int value;
+	mystl::list_hook hook;
+};
+
+typedef mystl::intrusive_list<QueueItem, &QueueItem::hook> QueueItemList;
+
+typedef std::vector<int> intvector;
+
+double Milliseconds(clock_t start, clock_t end)
+{
+	return (end - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+int Random()
+{
+	// RAND_MAX can be as small as 32767
+	return ((rand() & 0x7fff) << 15) | (rand() & 0x7fff);
+}
+
+void BenchmarkInsertion()
+{
+	intvector values;
+	clock_t start, end;
+
+	std::cout << "      elements |    insert (ms) | insert_range (ms) | range ctor (ms) |  2 x half (ms) |  multi (ms)\n";
+	std::cout << "---------------+----------------+-------------------+-----------------+----------------+------------\n";
+
+	for( size_t count = 1024; count <= 1024 * 1024; count *= 4 )
+	{
+		values.resize(count);
+
+		for( size_t i = 0; i < count; ++i )
+			values[i] = Random();
+
+		double singletime = -1;
+		double rangetime, ctortime, halftime, multitime;
+		size_t half = count / 2;
+
+		if( count <= MAX_SINGLE_INSERTS )
+		{
+			mystl::orderedarray<int> oa;
+
+			start = clock();
+
+			for( size_t i = 0; i < count; ++i )
+				oa.insert(values[i]);
+
+			end = clock();
+			singletime = Milliseconds(start, end);
+		}
+
+		{
+			mystl::orderedarray<int> oa;
+
+			start = clock();
+			oa.insert_range(values.begin(), values.end());
+
+			end = clock();
+			rangetime = Milliseconds(start, end);
+		}
+
+		{
+			start = clock();
+			mystl::orderedarray<int> oa(values.begin(), values.end());
+
+			end = clock();
+			ctortime = Milliseconds(start, end);
+		}
+
+		{
+			// merge into existing contents
+			mystl::orderedarray<int> oa;
+
+			start = clock();
+			oa.insert_range(values.begin(), values.begin() + half);
+			oa.insert_range(values.begin() + half, values.end());
+
+			end = clock();
+			halftime = Milliseconds(start, end);
+		}
+
+		{
+			mystl::orderedmultiarray<int> oma;
+
+			start = clock();
+			oma.insert_range(values.begin(), values.end());
+
+			end = clock();
+			multitime = Milliseconds(start, end);
+		}
+
+		if( singletime < 0 )
+			printf("%14u | %14s | %17.1f | %15.1f | %14.1f | %11.1f\n", (unsigned int)count, "-", rangetime, ctortime, halftime, multitime);
+		else
+			printf("%14u | %14.1f | %17.1f | %15.1f | %14.1f | %11.1f\n", (unsigned int)count, singletime, rangetime, ctortime, halftime, multitime);
+	}
+}
+
+// the bounds against the standard algorithms on the sorted data; lower_bound is the last element that is not greater
+// (std::upper_bound - 1), upper_bound is the first that is not smaller (std::lower_bound)
+bool CheckBounds(const mystl::static_orderedarray<int>& soa, const intvector& queries)
+{
+	const int* first = &soa[0];
+	const int* last = first + soa.size();
+	intvector probes(queries);
+
+	// below the first and above the last element
+	probes.push_back(soa[0] - 1);
+	probes.push_back(soa[0]);
+	probes.push_back(soa[soa.size() - 1]);
+	probes.push_back(soa[soa.size() - 1] + 1);
+
+	for( size_t i = 0; i < probes.size(); ++i )
+	{
+		size_t upper = std::upper_bound(first, last, probes[i]) - first;
+		size_t lower = std::lower_bound(first, last, probes[i]) - first;
+
+		if( soa.lower_bound(probes[i]) != (upper == 0 ? mystl::static_orderedarray<int>::npos : upper - 1) )
+			return false;
+
+		if( soa.upper_bound(probes[i]) != lower )
+			return false;
+	}
+
+	return true;
+}
+
+void BenchmarkSearch()
+{
+	intvector values;
+	intvector queries(NUM_QUERIES);
+	clock_t start, end;
+
+	std::cout << "      elements |   freeze (ms) | orderedarray (ns / find) | static_orderedarray (ns / find)\n";
+	std::cout << "---------------+---------------+--------------------------+--------------------------------\n";
+
+	for( size_t count = 1000; count <= MAX_SEARCH_ELEMENTS; count *= 10 )
+	{
+		values.resize(count);
+
+		for( size_t i = 0; i < count; ++i )
+			values[i] = Random();
+
+		mystl::orderedarray<int> oa(values.begin(), values.end());
+		mystl::static_orderedarray<int> soa;
+
+		values.clear();
+
+		start = clock();
+		soa.assign(oa);
+
+		end = clock();
+
+		double freezetime = Milliseconds(start, end);
+
+		// about half of them are hits
+		for( size_t i = 0; i < NUM_QUERIES; ++i )
+			queries[i] = ((i % 2) ? oa[Random() % oa.size()] : Random());
+
+		size_t found1 = 0;
+		size_t found2 = 0;
+
+		start = clock();
+
+		for( size_t i = 0; i < NUM_QUERIES; ++i )
+			found1 += (oa.find(queries[i]) != mystl::orderedarray<int>::npos);
+
+		end = clock();
+		double sorted = Milliseconds(start, end) * 1e6 / NUM_QUERIES;
+
+		start = clock();
+
+		for( size_t i = 0; i < NUM_QUERIES; ++i )
+			found2 += (soa.find(queries[i]) != mystl::static_orderedarray<int>::npos);
+
+		end = clock();
+		double eytzinger = Milliseconds(start, end) * 1e6 / NUM_QUERIES;
+
+		if( found1 != found2 )
+		{
+			std::cout << "* ERROR: The two arrays disagree!\n";
+			break;
+		}
+
+		if( !CheckBounds(soa, queries) )
+		{
+			std::cout << "* ERROR: static_orderedarray returned a wrong bound!\n";
+			break;
+		}
+
+		printf("%14u | %13.1f | %24.1f | %31.1f\n", (unsigned int)count, freezetime, sorted, eytzinger);
+	}
+}
+
+void BenchmarkMap()
+{
+	std::vector<std::string> names;
+	clock_t start, end;
+
+	std::cout << "      elements | orderedarray<struct> (ns / find) | orderedmap (ns / find)\n";
+	std::cout << "---------------+----------------------------------+-----------------------\n";
+
+	for( size_t count = 1000; count <= MAX_MAP_ELEMENTS; count *= 10 )
+	{
+		mystl::orderedarray<NamedRecord> records;
+		mystl::orderedmap<std::string, Record, mystl::string_less> map;
+		std::vector<std::pair<std::string, Record> > pairs;
+		std::vector<NamedRecord> structs;
+		char buff[32];
+
+		names.resize(count);
+		pairs.resize(count);
+		structs.resize(count);
+
+		for( size_t i = 0; i < count; ++i )
+		{
+			// short enough for the small string optimization
+			sprintf(buff, "u_%d", Random());
+
+			names[i] = buff;
+			pairs[i].first = buff;
+
+			strcpy(structs[i].Name, buff);
+		}
+
+		records.insert_range(structs.begin(), structs.end());
+		map.insert_range(pairs.begin(), pairs.end());
+
+		structs.clear();
+		pairs.clear();
+
+		size_t found1 = 0;
+		size_t found2 = 0;
+
+		start = clock();
+
+		for( size_t i = 0; i < NUM_NAME_QUERIES; ++i )
+		{
+			// the old way: copy the name into a temporary
+			NamedRecord test;
+			strcpy(test.Name, names[(i * 7919) % count].c_str());
+
+			found1 += (records.find(test) != mystl::orderedarray<NamedRecord>::npos);
+		}
+
+		end = clock();
+		double arraytime = Milliseconds(start, end) * 1e6 / NUM_NAME_QUERIES;
+
+		start = clock();
+
+		for( size_t i = 0; i < NUM_NAME_QUERIES; ++i )
+			found2 += (map.find(names[(i * 7919) % count].c_str()) != map.npos);
+
+		end = clock();
+		double maptime = Milliseconds(start, end) * 1e6 / NUM_NAME_QUERIES;
+
+		if( found1 != found2 )
+		{
+			std::cout << "* ERROR: The two containers disagree!\n";
+			break;
+		}
+
+		printf("%14u | %32.1f | %22.1f\n", (unsigned int)count, arraytime, maptime);
+	}
+}
+
+template <typename list_type>
+void QueueTest(double& queuetime, double& traversaltime, unsigned int& checksum)
+{
+	clock_t start, end;
+	list_type queue;
+
+	// push-pop in a loop
+	for( int i = 0; i < QUEUE_LENGTH; ++i )
+		queue.push_back(i);
+
+	start = clock();
+
+	for( int i = 0; i < NUM_QUEUE_OPS; ++i )
+	{
+		checksum += queue.front();
+
+		queue.pop_front();
+		queue.push_back(i);
+	}
+
+	end = clock();
+	queuetime = Milliseconds(start, end) * 1e6 / NUM_QUEUE_OPS;
+
+	// build a long list where every other element is removed, then walk it
+	list_type longlist;
+
+	for( int i = 0; i < TRAVERSAL_LENGTH; ++i )
+	{
+		longlist.push_back(i);
+		longlist.push_back(i);
+		longlist.pop_front();
+	}
+
+	start = clock();
+
+	for( int j = 0; j < NUM_TRAVERSALS; ++j )
+	{
+		for( typename list_type::const_iterator it = longlist.begin(); it != longlist.end(); ++it )
+			checksum += *it;
+	}
+
+	end = clock();
+	traversaltime = Milliseconds(start, end) * 1e6 / ((double)NUM_TRAVERSALS * TRAVERSAL_LENGTH);
+}
+
+void IntrusiveQueueTest(double& queuetime, double& traversaltime, unsigned int& checksum)
+{
+	// the items live somewhere else, the list only links them
+	std::vector<QueueItem> items(QUEUE_LENGTH);
+	std::vector<QueueItem> longitems(TRAVERSAL_LENGTH * 2);
+	clock_t start, end;
+	QueueItemList queue;
+
+	for( int i = 0; i < QUEUE_LENGTH; ++i )
+	{
+		items[i].value = i;
+		queue.push_back(items[i]);
+	}
+
+	start = clock();
+
+	for( int i = 0; i < NUM_QUEUE_OPS; ++i )
+	{
+		QueueItem& item = queue.front();
+		checksum += item.value;
+
+		queue.pop_front();
+
+		item.value = i;
+		queue.push_back(item);
+	}
+
+	end = clock();
+	queuetime = Milliseconds(start, end) * 1e6 / NUM_QUEUE_OPS;
+
+	QueueItemList longlist;
+
+	for( int i = 0; i < TRAVERSAL_LENGTH; ++i )
+	{
+		longitems[i * 2].value = i;
+		longitems[i * 2 + 1].value = i;
+
+		longlist.push_back(longitems[i * 2]);
+		longlist.push_back(longitems[i * 2 + 1]);
+		longlist.pop_front();
+	}
+
+	start = clock();
+
+	for( int j = 0; j < NUM_TRAVERSALS; ++j )
+	{
+		for( QueueItemList::iterator it = longlist.begin(); it != longlist.end(); ++it )
+			checksum += it->value;
+	}
+
+	end = clock();
+	traversaltime = Milliseconds(start, end) * 1e6 / ((double)NUM_TRAVERSALS * TRAVERSAL_LENGTH);
+}
+
+void BenchmarkList()
+{
+	const char* names[] = { "std::list", "mystl::list (heap)", "mystl::list (pool)", "intrusive_list" };
+	double queuetimes[4], traversaltimes[4];
+	unsigned int checksums[4] = { 0, 0, 0, 0 };
+
+	QueueTest<std::list<int> >(queuetimes[0], traversaltimes[0], checksums[0]);
+	QueueTest<mystl::list<int, mystl::heap_allocator> >(queuetimes[1], traversaltimes[1], checksums[1]);
+	QueueTest<mystl::list<int> >(queuetimes[2], traversaltimes[2], checksums[2]);
+	IntrusiveQueueTest(queuetimes[3], traversaltimes[3], checksums[3]);
+
+	std::cout << "                     | push + pop (ns / op) | traversal (ns / element)\n";
+	std::cout << "---------------------+----------------------+-------------------------\n";
+
+	for( int i = 0; i < 4; ++i )
+	{
+		if( checksums[i] != checksums[0] )
+			std::cout << "* ERROR: " << names[i] << " computed something else!\n";
+
+		printf("%20s | %20.1f | %24.2f\n", names[i], queuetimes[i], traversaltimes[i]);
+	}
+}
+
+template <typename array_type>
+void SmallArrayTest(std::vector<array_type>& arrays, double& buildtime, double& findtime, size_t& found)
+{
+	clock_t start, end;
+
+	srand(2048);
+	start = clock();
+
+	for( size_t i = 0; i < arrays.size(); ++i )
+	{
+		int count = 1 + rand() % MAX_SMALL_SIZE;
+
+		for( int j = 0; j < count; ++j )
+			arrays[i].insert(rand() % 64);
+	}
+
+	end = clock();
+	buildtime = Milliseconds(start, end);
+
+	// random keys, so that the branch predictor can't learn them
+	std::vector<int> keys(NUM_SMALL_QUERIES);
+
+	for( size_t i = 0; i < NUM_SMALL_QUERIES; ++i )
+		keys[i] = rand() % 64;
+
+	start = clock();
+
+	for( size_t i = 0; i < NUM_SMALL_QUERIES; ++i )
+		found += (arrays[(i * 7919) % arrays.size()].find(keys[i]) != array_type::npos);
+
+	end = clock();
+	findtime = Milliseconds(start, end) * 1e6 / NUM_SMALL_QUERIES;
+}
+
+template <typename array_type>
+void SmallArrayStats(const std::vector<array_type>& arrays, double& bytes, size_t& blocks)
+{
+	size_t total = 0;
+	blocks = 0;
+
+	for( size_t i = 0; i < arrays.size(); ++i )
+	{
+		total += sizeof(array_type);
+
+		// allocated ones (plus a typical malloc header)
+		if( arrays[i].capacity() > 0 && !IsInline(arrays[i]) )
+		{
+			total += arrays[i].capacity() * sizeof(int) + MALLOC_OVERHEAD;
+			++blocks;
+		}
+	}
+
+	bytes = (double)total / arrays.size();
+}
+
+void BenchmarkSmallArrays()
+{
+	std::vector<mystl::orderedarray<int> > arrays1(NUM_SMALL_ARRAYS);
+	std::vector<smallintarray8> arrays2(NUM_SMALL_ARRAYS);
+	std::vector<smallintarray16> arrays3(NUM_SMALL_ARRAYS);
+	double buildtimes[3], findtimes[3], bytes[3];
+	size_t found[3] = { 0, 0, 0 };
+	size_t blocks[3];
+
+	SmallArrayTest(arrays1, buildtimes[0], findtimes[0], found[0]);
+	SmallArrayTest(arrays2, buildtimes[1], findtimes[1], found[1]);
+	SmallArrayTest(arrays3, buildtimes[2], findtimes[2], found[2]);
+
+	if( found[0] != found[1] || found[0] != found[2] )
+		std::cout << "* ERROR: The arrays disagree!\n";
+
+	SmallArrayStats(arrays1, bytes[0], blocks[0]);
+	SmallArrayStats(arrays2, bytes[1], blocks[1]);
+	SmallArrayStats(arrays3, bytes[2], blocks[2]);
+
+	const char* names[] = { "orderedarray", "small_orderedarray (8)", "small_orderedarray (16)" };
+
+	std::cout << "                         | build (ms) | find (ns) | bytes / array | heap blocks\n";
+	std::cout << "-------------------------+------------+-----------+---------------+------------\n";
+
+	for( int i = 0; i < 3; ++i )
+		printf("%24s | %10.1f | %9.1f | %13.1f | %11u\n", names[i], buildtimes[i], findtimes[i], bytes[i], (unsigned int)blocks[i]);
+}
+
+int main()
+{
+	srand(1024);
+
+	BenchmarkInsertion();
+	std::cout << "\n";
+
+	BenchmarkSearch();
+	std::cout << "\n";
+
+	BenchmarkMap();
+	std::cout << "\n";
+
+	BenchmarkList();
+	std::cout << "\n";
+
+	BenchmarkSmallArrays();
+
+#ifdef _MSC_VER
+	system("pause");
+#endif
+
+	return 0;
+}
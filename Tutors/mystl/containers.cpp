@@ -0,0 +1,770 @@
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <list>
+#include <string>
+#include <algorithm>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+#include "orderedarray.hpp"
+#include "orderedmultiarray.hpp"
+#include "list.hpp"
+
+// a 32 bit process can't hold the largest containers; can be lowered from the command line
+#define MAX_ELEMENTS		(sizeof(void*) > 4 ? 10000000 : 1000000)
+
+// one-by-one insertion into arrays is quadratic, above this they are built in bulk
+#define MAX_SINGLE_INSERTS	131072
+
+// small containers are processed repeatedly, until at least this many elements are touched
+#define MIN_WORK			1000000
+
+#define NUM_QUERIES			1000000
+
+// erasing from an array moves half of it; limit the bytes moved for one measurement
+#define ERASE_BYTE_BUDGET	(256 * 1024 * 1024)
+#define MIN_ERASES			10
+#define MAX_ERASES			1000
+
+// 64 byte POD payload, ordered by key
+struct Pod64
+{
+	int		key;
+	char	data[60];
+
+	inline bool operator <(const Pod64& other) const {
+		return (key < other.key);
+	}
+
+	inline bool operator ==(const Pod64& other) const {
+		return (key == other.key);
+	}
+};
+
+inline void MakeValue(int& out, int key) {
+	out = key;
+}
+
+inline void MakeValue(Pod64& out, int key) {
+	out.key = key;
+	memset(out.data, key & 0xff, sizeof(out.data));
+}
+
+inline void MakeValue(std::string& out, int key) {
+	// 12 to 35 characters, both with and without small string optimization
+	char buff[64];
+	int len = sprintf(buff, "key_%08x", key);
+
+	out.assign(buff, len);
+	out.append(key % 24, 'x');
+}
+
+inline size_t Checksum(int value) {
+	return (size_t)value;
+}
+
+inline size_t Checksum(const Pod64& value) {
+	return (size_t)value.key + value.data[59];
+}
+
+inline size_t Checksum(const std::string& value) {
+	return value.size() + (unsigned char)value[7];
+}
+
+/**
+ * \brief Sorted std::vector without duplicates
+ */
+template <typename T>
+struct sortedvector
+{
+	std::vector<T> items;
+};
+
+/**
+ * \brief Sorted std::vector with duplicates
+ */
+template <typename T>
+struct sortedmultivector
+{
+	std::vector<T> items;
+};
+
+/**
+ * \brief Uniform interface for the measured containers
+ *
+ * Build() is allowed to do it in bulk, which is used for arrays above
+ * MAX_SINGLE_INSERTS. Lookups return a checksum, that has to be the same
+ * for every container of a table.
+ */
+template <typename container_type>
+struct ContainerOps;
+
+template <typename T>
+struct ContainerOps<mystl::orderedarray<T> >
+{
+	typedef mystl::orderedarray<T> container_type;
+
+	static const bool isarray = true;
+	static const char* Name() { return "mystl::orderedarray"; }
+
+	static void Insert(container_type& c, const T& value)	{ c.insert(value); }
+	static void Erase(container_type& c, const T& value)	{ c.erase(value); }
+
+	template <typename iterator>
+	static void Build(container_type& c, iterator first, iterator last) {
+		c.insert_range(first, last);
+	}
+
+	static size_t Find(const container_type& c, const T& value) {
+		return (c.find(value) != container_type::npos ? 1 : 0);
+	}
+
+	static size_t LowerBound(const container_type& c, const T& value) {
+		// orderedarray::upper_bound() is the first that is not smaller, like std::lower_bound()
+		size_t i = c.upper_bound(value);
+		return (i < c.size() ? Checksum(c[i]) : 0);
+	}
+
+	static size_t EqualRange(const container_type& c, const T& value) {
+		// unique keys
+		return (c.find(value) != container_type::npos ? 1 : 0);
+	}
+
+	static size_t Iterate(const container_type& c) {
+		size_t sum = 0;
+
+		for( size_t i = 0; i < c.size(); ++i )
+			sum += Checksum(c[i]);
+
+		return sum;
+	}
+};
+
+template <typename T>
+struct ContainerOps<mystl::orderedmultiarray<T> >
+{
+	typedef mystl::orderedmultiarray<T> container_type;
+
+	static const bool isarray = true;
+	static const char* Name() { return "mystl::orderedmultiarray"; }
+
+	static void Insert(container_type& c, const T& value)	{ c.insert(value); }
+	static void Erase(container_type& c, const T& value)	{ c.erase(value); }
+
+	template <typename iterator>
+	static void Build(container_type& c, iterator first, iterator last) {
+		c.insert_range(first, last);
+	}
+
+	static size_t Find(const container_type& c, const T& value) {
+		return (c.find(value) != container_type::npos ? 1 : 0);
+	}
+
+	static size_t LowerBound(const container_type& c, const T& value) {
+		// npos if all of them are smaller
+		size_t i = c.lower_bound(value);
+		return (i < c.size() ? Checksum(c[i]) : 0);
+	}
+
+	static size_t EqualRange(const container_type& c, const T& value) {
+		typename container_type::pairii p = c.equal_range(value);
+		return p.second - p.first;
+	}
+
+	static size_t Iterate(const container_type& c) {
+		size_t sum = 0;
+
+		for( size_t i = 0; i < c.size(); ++i )
+			sum += Checksum(c[i]);
+
+		return sum;
+	}
+};
+
+template <typename set_type, typename T>
+struct StdSetOps
+{
+	typedef set_type container_type;
+
+	static const bool isarray = false;
+
+	static void Insert(container_type& c, const T& value)	{ c.insert(value); }
+	static void Erase(container_type& c, const T& value)	{ c.erase(value); }
+
+	template <typename iterator>
+	static void Build(container_type& c, iterator first, iterator last) {
+		c.insert(first, last);
+	}
+
+	static size_t Find(const container_type& c, const T& value) {
+		return (c.find(value) != c.end() ? 1 : 0);
+	}
+
+	static size_t LowerBound(const container_type& c, const T& value) {
+		typename container_type::const_iterator it = c.lower_bound(value);
+		return (it != c.end() ? Checksum(*it) : 0);
+	}
+
+	static size_t EqualRange(const container_type& c, const T& value) {
+		std::pair<typename container_type::const_iterator, typename container_type::const_iterator> p = c.equal_range(value);
+		return std::distance(p.first, p.second);
+	}
+
+	static size_t Iterate(const container_type& c) {
+		size_t sum = 0;
+
+		for( typename container_type::const_iterator it = c.begin(); it != c.end(); ++it )
+			sum += Checksum(*it);
+
+		return sum;
+	}
+};
+
+template <typename T>
+struct ContainerOps<std::set<T> > : StdSetOps<std::set<T>, T>
+{
+	static const char* Name() { return "std::set"; }
+};
+
+template <typename T>
+struct ContainerOps<std::multiset<T> > : StdSetOps<std::multiset<T>, T>
+{
+	static const char* Name() { return "std::multiset"; }
+};
+
+template <typename vector_type, typename T, bool multi>
+struct SortedVectorOps
+{
+	typedef vector_type container_type;
+	typedef typename std::vector<T>::const_iterator const_iterator;
+
+	static const bool isarray = true;
+
+	static void Insert(container_type& c, const T& value) {
+		typename std::vector<T>::iterator it = std::upper_bound(c.items.begin(), c.items.end(), value);
+
+		if( multi || it == c.items.begin() || *(it - 1) < value )
+			c.items.insert(it, value);
+	}
+
+	static void Erase(container_type& c, const T& value) {
+		std::pair<typename std::vector<T>::iterator, typename std::vector<T>::iterator> p =
+			std::equal_range(c.items.begin(), c.items.end(), value);
+
+		c.items.erase(p.first, p.second);
+	}
+
+	template <typename iterator>
+	static void Build(container_type& c, iterator first, iterator last) {
+		c.items.insert(c.items.end(), first, last);
+		std::sort(c.items.begin(), c.items.end());
+
+		if( !multi )
+			c.items.erase(std::unique(c.items.begin(), c.items.end()), c.items.end());
+	}
+
+	static size_t Find(const container_type& c, const T& value) {
+		const_iterator it = std::lower_bound(c.items.begin(), c.items.end(), value);
+		return ((it != c.items.end() && !(value < *it)) ? 1 : 0);
+	}
+
+	static size_t LowerBound(const container_type& c, const T& value) {
+		const_iterator it = std::lower_bound(c.items.begin(), c.items.end(), value);
+		return (it != c.items.end() ? Checksum(*it) : 0);
+	}
+
+	static size_t EqualRange(const container_type& c, const T& value) {
+		std::pair<const_iterator, const_iterator> p = std::equal_range(c.items.begin(), c.items.end(), value);
+		return p.second - p.first;
+	}
+
+	static size_t Iterate(const container_type& c) {
+		size_t sum = 0;
+
+		for( size_t i = 0; i < c.items.size(); ++i )
+			sum += Checksum(c.items[i]);
+
+		return sum;
+	}
+};
+
+template <typename T>
+struct ContainerOps<sortedvector<T> > : SortedVectorOps<sortedvector<T>, T, false>
+{
+	static const char* Name() { return "sorted std::vector"; }
+};
+
+template <typename T>
+struct ContainerOps<sortedmultivector<T> > : SortedVectorOps<sortedmultivector<T>, T, true>
+{
+	static const char* Name() { return "sorted std::vector"; }
+};
+
+template <typename T>
+struct ContainerOps<mystl::list<T> >
+{
+	typedef mystl::list<T> container_type;
+	typedef typename container_type::iterator iterator;
+	typedef typename container_type::const_iterator const_iterator;
+
+	static const char* Name() { return "mystl::list"; }
+};
+
+template <typename T>
+struct ContainerOps<std::list<T> >
+{
+	typedef std::list<T> container_type;
+	typedef typename container_type::iterator iterator;
+	typedef typename container_type::const_iterator const_iterator;
+
+	static const char* Name() { return "std::list"; }
+};
+
+/**
+ * \brief Counts last level cache misses (Linux perf events only)
+ */
+class CacheMissCounter
+{
+private:
+	int fd;
+
+public:
+	CacheMissCounter()
+	{
+		fd = -1;
+
+#ifdef __linux__
+		perf_event_attr attr;
+
+		memset(&attr, 0, sizeof(attr));
+
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+	}
+
+	~CacheMissCounter()
+	{
+#ifdef __linux__
+		if( fd != -1 )
+			close(fd);
+#endif
+	}
+
+	inline bool Available() const {
+		return (fd != -1);
+	}
+
+	void Start()
+	{
+#ifdef __linux__
+		if( fd != -1 )
+		{
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	double Stop(size_t numops)
+	{
+		// misses per operation or -1
+		long long count = -1;
+
+#ifdef __linux__
+		if( fd != -1 )
+		{
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+			if( read(fd, &count, sizeof(count)) != sizeof(count) )
+				count = -1;
+		}
+#endif
+
+		return (count < 0 ? -1.0 : (double)count / numops);
+	}
+};
+
+struct Result
+{
+	double	insert;		// ns per element for each
+	double	find;
+	double	lowerbound;
+	double	equalrange;
+	double	iterate;
+	double	copy;
+	double	erase;
+	double	findmisses;	// cache misses per find
+	bool	bulk;		// built with insert_range/sort
+	size_t	checksum;
+};
+
+CacheMissCounter counter;
+
+double Nanoseconds(clock_t start, clock_t end, size_t numops)
+{
+	return (end - start) * 1e9 / CLOCKS_PER_SEC / numops;
+}
+
+int Random()
+{
+	// RAND_MAX can be as small as 32767
+	return ((rand() & 0x7fff) << 15) | (rand() & 0x7fff);
+}
+
+size_t NumRounds(size_t count)
+{
+	return std::max<size_t>(1, MIN_WORK / count);
+}
+
+size_t NumErases(size_t count, size_t elemsize)
+{
+	size_t num = ERASE_BYTE_BUDGET / (count * elemsize / 2 + 1);
+	return std::min<size_t>(std::min<size_t>(std::max<size_t>(num, MIN_ERASES), MAX_ERASES), count);
+}
+
+template <typename container_type, typename T>
+void MeasureOrdered(const std::vector<T>& values, const std::vector<T>& queries, Result& res)
+{
+	typedef ContainerOps<container_type> ops;
+
+	size_t count = values.size();
+	size_t rounds = NumRounds(count);
+	size_t numerases = NumErases(count, sizeof(T));
+	size_t checksum = 0;
+	clock_t start, end;
+
+	// insert
+	res.bulk = (ops::isarray && count > MAX_SINGLE_INSERTS);
+
+	{
+		start = clock();
+
+		for( size_t r = 0; r < rounds; ++r )
+		{
+			container_type c;
+
+			if( res.bulk )
+			{
+				ops::Build(c, values.begin(), values.end());
+			}
+			else
+			{
+				for( size_t i = 0; i < count; ++i )
+					ops::Insert(c, values[i]);
+			}
+		}
+
+		end = clock();
+		res.insert = Nanoseconds(start, end, rounds * count);
+	}
+
+	container_type c;
+	ops::Build(c, values.begin(), values.end());
+
+	// lookups
+	start = clock();
+	counter.Start();
+
+	for( size_t i = 0; i < queries.size(); ++i )
+		checksum += ops::Find(c, queries[i]);
+
+	res.findmisses = counter.Stop(queries.size());
+	end = clock();
+	res.find = Nanoseconds(start, end, queries.size());
+
+	start = clock();
+
+	for( size_t i = 0; i < queries.size(); ++i )
+		checksum += ops::LowerBound(c, queries[i]);
+
+	end = clock();
+	res.lowerbound = Nanoseconds(start, end, queries.size());
+
+	start = clock();
+
+	for( size_t i = 0; i < queries.size(); ++i )
+		checksum += ops::EqualRange(c, queries[i]);
+
+	end = clock();
+	res.equalrange = Nanoseconds(start, end, queries.size());
+
+	// iteration
+	start = clock();
+
+	for( size_t r = 0; r < rounds; ++r )
+		checksum += ops::Iterate(c);
+
+	end = clock();
+	res.iterate = Nanoseconds(start, end, rounds * count);
+
+	// copy
+	start = clock();
+
+	for( size_t r = 0; r < rounds; ++r )
+	{
+		container_type copy(c);
+		checksum += ops::Iterate(copy) & 1;
+	}
+
+	end = clock();
+	res.copy = Nanoseconds(start, end, rounds * count);
+
+	// erase existing values (every container gets the same ones)
+	start = clock();
+
+	for( size_t i = 0; i < numerases; ++i )
+		ops::Erase(c, values[(i * 7919) % count]);
+
+	end = clock();
+	res.erase = Nanoseconds(start, end, numerases);
+
+	res.checksum = checksum + ops::Iterate(c);
+}
+
+template <typename list_type, typename T>
+void MeasureList(const std::vector<T>& values, Result& res)
+{
+	typedef typename ContainerOps<list_type>::iterator iterator;
+	typedef typename ContainerOps<list_type>::const_iterator const_iterator;
+
+	size_t count = values.size();
+	size_t rounds = NumRounds(count);
+	size_t checksum = 0;
+	clock_t start, end;
+
+	res.bulk = false;
+	res.find = res.lowerbound = res.equalrange = res.findmisses = -1;
+
+	start = clock();
+
+	for( size_t r = 0; r < rounds; ++r )
+	{
+		list_type l;
+
+		for( size_t i = 0; i < count; ++i )
+			l.push_back(values[i]);
+	}
+
+	end = clock();
+	res.insert = Nanoseconds(start, end, rounds * count);
+
+	list_type l;
+
+	for( size_t i = 0; i < count; ++i )
+		l.push_back(values[i]);
+
+	start = clock();
+
+	for( size_t r = 0; r < rounds; ++r )
+	{
+		const list_type& cl = l;
+
+		for( const_iterator it = cl.begin(); it != cl.end(); ++it )
+			checksum += Checksum(*it);
+	}
+
+	end = clock();
+	res.iterate = Nanoseconds(start, end, rounds * count);
+
+	start = clock();
+
+	for( size_t r = 0; r < rounds; ++r )
+	{
+		list_type copy(l);
+		checksum += copy.size();
+	}
+
+	end = clock();
+	res.copy = Nanoseconds(start, end, rounds * count);
+
+	// erase every second element
+	size_t erased = 0;
+
+	start = clock();
+
+	for( iterator it = l.begin(); it != l.end(); )
+	{
+		it = l.erase(it);
+		++erased;
+
+		if( it != l.end() )
+			++it;
+	}
+
+	end = clock();
+	res.erase = Nanoseconds(start, end, erased);
+
+	for( const_iterator it = l.begin(); it != l.end(); ++it )
+		checksum += Checksum(*it);
+
+	res.checksum = checksum;
+}
+
+void PrintHeader(const char* title)
+{
+	printf("\n%s (ns / element)\n\n", title);
+	std::cout << "   elements | container                |   insert |     find | lower_bound | equal_range |  iterate |     copy |      erase | LLC miss/find\n";
+	std::cout << "------------+--------------------------+----------+----------+-------------+-------------+----------+----------+------------+--------------\n";
+}
+
+void PrintValue(double value, int width)
+{
+	if( value < 0 )
+		printf(" %*s |", width, "-");
+	else
+		printf(" %*.1f |", width, value);
+}
+
+void PrintRow(size_t count, const char* name, const Result& res, size_t reference)
+{
+	char insert[32];
+
+	if( res.bulk )
+		sprintf(insert, "%.1f*", res.insert);
+	else
+		sprintf(insert, "%.1f", res.insert);
+
+	printf("%11u | %-24s | %8s |", (unsigned int)count, name, insert);
+
+	PrintValue(res.find, 8);
+	PrintValue(res.lowerbound, 11);
+	PrintValue(res.equalrange, 11);
+	PrintValue(res.iterate, 8);
+	PrintValue(res.copy, 8);
+	PrintValue(res.erase, 10);
+
+	if( res.findmisses < 0 )
+		printf(" %12s", "-");
+	else
+		printf(" %12.2f", res.findmisses);
+
+	if( res.checksum != reference )
+		printf("   CHECKSUM MISMATCH");
+
+	printf("\n");
+}
+
+template <typename T>
+void BenchmarkPayload(const char* payloadname, size_t maxelements)
+{
+	std::vector<T> values, queries;
+	char title[128];
+	Result res[3];
+
+	// unique keys
+	sprintf(title, "%s, unique keys", payloadname);
+	PrintHeader(title);
+
+	for( size_t count = 1000; count <= maxelements; count *= 10 )
+	{
+		values.resize(count);
+		queries.resize(NUM_QUERIES);
+
+		for( size_t i = 0; i < count; ++i )
+			MakeValue(values[i], Random());
+
+		// half of them are hits
+		for( size_t i = 0; i < NUM_QUERIES; ++i )
+		{
+			if( i % 2 == 0 )
+				queries[i] = values[Random() % count];
+			else
+				MakeValue(queries[i], Random());
+		}
+
+		MeasureOrdered<mystl::orderedarray<T> >(values, queries, res[0]);
+		MeasureOrdered<std::set<T> >(values, queries, res[1]);
+		MeasureOrdered<sortedvector<T> >(values, queries, res[2]);
+
+		PrintRow(count, ContainerOps<mystl::orderedarray<T> >::Name(), res[0], res[1].checksum);
+		PrintRow(count, ContainerOps<std::set<T> >::Name(), res[1], res[1].checksum);
+		PrintRow(count, ContainerOps<sortedvector<T> >::Name(), res[2], res[1].checksum);
+	}
+
+	// about 4 of each key
+	sprintf(title, "%s, duplicate keys", payloadname);
+	PrintHeader(title);
+
+	for( size_t count = 1000; count <= maxelements; count *= 10 )
+	{
+		int range = (int)(count / 4);
+
+		values.resize(count);
+		queries.resize(NUM_QUERIES);
+
+		for( size_t i = 0; i < count; ++i )
+			MakeValue(values[i], Random() % range);
+
+		for( size_t i = 0; i < NUM_QUERIES; ++i )
+			MakeValue(queries[i], Random() % (range * 2));
+
+		MeasureOrdered<mystl::orderedmultiarray<T> >(values, queries, res[0]);
+		MeasureOrdered<std::multiset<T> >(values, queries, res[1]);
+		MeasureOrdered<sortedmultivector<T> >(values, queries, res[2]);
+
+		PrintRow(count, ContainerOps<mystl::orderedmultiarray<T> >::Name(), res[0], res[1].checksum);
+		PrintRow(count, ContainerOps<std::multiset<T> >::Name(), res[1], res[1].checksum);
+		PrintRow(count, ContainerOps<sortedmultivector<T> >::Name(), res[2], res[1].checksum);
+	}
+
+	// lists (insert is push_back, erase removes every second element)
+	sprintf(title, "%s, lists", payloadname);
+	PrintHeader(title);
+
+	for( size_t count = 1000; count <= maxelements; count *= 10 )
+	{
+		values.resize(count);
+
+		for( size_t i = 0; i < count; ++i )
+			MakeValue(values[i], Random());
+
+		MeasureList<mystl::list<T> >(values, res[0]);
+		MeasureList<std::list<T> >(values, res[1]);
+
+		PrintRow(count, ContainerOps<mystl::list<T> >::Name(), res[0], res[1].checksum);
+		PrintRow(count, ContainerOps<std::list<T> >::Name(), res[1], res[1].checksum);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	size_t maxelements = MAX_ELEMENTS;
+
+	if( argc > 1 )
+		maxelements = std::min<size_t>(maxelements, strtoul(argv[1], 0, 10));
+
+	srand(1024);
+
+	std::cout << "* = built with insert_range/sort, one-by-one insertion would be quadratic\n";
+
+	if( !counter.Available() )
+		std::cout << "cache miss counters are not available\n";
+
+	BenchmarkPayload<int>("int", maxelements);
+	BenchmarkPayload<Pod64>("64 byte POD", maxelements);
+	BenchmarkPayload<std::string>("std::string", maxelements);
+
+#ifdef _MSC_VER
+	system("pause");
+#endif
+
+	return 0;
+}
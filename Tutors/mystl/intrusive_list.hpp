@@ -0,0 +1,258 @@
+
+#ifndef _INTRUSIVE_LIST_HPP_
+#define _INTRUSIVE_LIST_HPP_
+
+#include "functional.hpp"
+
+namespace mystl
+{
+	// put this into the element type; an element can be in as many lists as many hooks it has
+	struct list_hook
+	{
+		list_hook* next;
+		list_hook* prev;
+
+		list_hook()
+			: next(0), prev(0) {}
+
+		inline bool linked() const {
+			return (next != 0);
+		}
+	};
+
+	// doesn't own or copy the elements, never allocates
+	template <typename value_type, list_hook value_type::* hook>
+	class intrusive_list
+	{
+	private:
+		list_hook head;
+		size_t mysize;
+
+		static inline value_type* _owner(list_hook* h) {
+			// offsetof() for member pointers
+			const value_type* dummy = reinterpret_cast<const value_type*>(64);
+			size_t offset = (size_t)((const char*)&(dummy->*hook) - (const char*)dummy);
+
+			return reinterpret_cast<value_type*>((char*)h - offset);
+		}
+
+		void _link(list_hook* h, list_hook* before);
+		void _unlink(list_hook* h);
+
+		// elements can't be in two lists with the same hook
+		intrusive_list(const intrusive_list& other);
+		intrusive_list& operator =(const intrusive_list& other);
+
+	public:
+		class iterator
+		{
+			friend class intrusive_list;
+
+		private:
+			list_hook* ptr;
+
+			iterator(list_hook* h)
+				: ptr(h) {}
+
+		public:
+			iterator()
+				: ptr(0) {}
+
+			inline iterator& operator ++() {
+				ptr = ptr->next;
+				return *this;
+			}
+
+			inline iterator operator ++(int) {
+				iterator tmp = *this;
+
+				ptr = ptr->next;
+				return tmp;
+			}
+
+			inline iterator& operator --() {
+				ptr = ptr->prev;
+				return *this;
+			}
+
+			inline iterator operator --(int) {
+				iterator tmp = *this;
+
+				ptr = ptr->prev;
+				return tmp;
+			}
+
+			inline value_type& operator *() const {
+				return *_owner(ptr);
+			}
+
+			inline value_type* operator ->() const {
+				return _owner(ptr);
+			}
+
+			inline bool operator !=(const iterator& other) const {
+				return (ptr != other.ptr);
+			}
+
+			inline bool operator ==(const iterator& other) const {
+				return (ptr == other.ptr);
+			}
+		};
+
+		intrusive_list();
+		~intrusive_list();
+
+		void push_back(value_type& item);
+		void push_front(value_type& item);
+		void pop_front();
+		void pop_back();
+		void clear();
+
+		iterator insert(const iterator& pos, value_type& item);
+		iterator erase(value_type& item);
+		iterator erase(const iterator& pos);
+
+		inline value_type& front() {
+			return *_owner(head.next);
+		}
+
+		inline const value_type& front() const {
+			return *_owner(head.next);
+		}
+
+		inline value_type& back() {
+			return *_owner(head.prev);
+		}
+
+		inline const value_type& back() const {
+			return *_owner(head.prev);
+		}
+
+		inline bool empty() const {
+			return (mysize == 0);
+		}
+
+		inline size_t size() const {
+			return mysize;
+		}
+
+		inline iterator begin() {
+			return iterator(head.next);
+		}
+
+		inline iterator end() {
+			return iterator(&head);
+		}
+	};
+
+	template <typename value_type, list_hook value_type::* hook>
+	intrusive_list<value_type, hook>::intrusive_list()
+	{
+		head.next = head.prev = &head;
+		mysize = 0;
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	intrusive_list<value_type, hook>::~intrusive_list()
+	{
+		clear();
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	void intrusive_list<value_type, hook>::_link(list_hook* h, list_hook* before)
+	{
+		h->next = before;
+		h->prev = before->prev;
+
+		before->prev->next = h;
+		before->prev = h;
+
+		++mysize;
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	void intrusive_list<value_type, hook>::_unlink(list_hook* h)
+	{
+		h->prev->next = h->next;
+		h->next->prev = h->prev;
+
+		h->next = h->prev = 0;
+		--mysize;
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	void intrusive_list<value_type, hook>::push_back(value_type& item)
+	{
+		myerror(, "intrusive_list::push_back(): element is already in a list", !(item.*hook).linked());
+		_link(&(item.*hook), &head);
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	void intrusive_list<value_type, hook>::push_front(value_type& item)
+	{
+		myerror(, "intrusive_list::push_front(): element is already in a list", !(item.*hook).linked());
+		_link(&(item.*hook), head.next);
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	void intrusive_list<value_type, hook>::pop_front()
+	{
+		myerror(, "intrusive_list::pop_front(): container is empty", mysize > 0);
+		_unlink(head.next);
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	void intrusive_list<value_type, hook>::pop_back()
+	{
+		myerror(, "intrusive_list::pop_back(): container is empty", mysize > 0);
+		_unlink(head.prev);
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	void intrusive_list<value_type, hook>::clear()
+	{
+		// the elements have to know that they are free
+		list_hook* q = head.next;
+		list_hook* p;
+
+		while( q != &head )
+		{
+			p = q;
+			q = q->next;
+
+			p->next = p->prev = 0;
+		}
+
+		head.next = head.prev = &head;
+		mysize = 0;
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	typename intrusive_list<value_type, hook>::iterator intrusive_list<value_type, hook>::insert(const iterator& pos, value_type& item)
+	{
+		mynerror(end(), "intrusive_list::insert(): element is already in a list", (item.*hook).linked());
+		_link(&(item.*hook), pos.ptr);
+
+		return iterator(&(item.*hook));
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	typename intrusive_list<value_type, hook>::iterator intrusive_list<value_type, hook>::erase(value_type& item)
+	{
+		myerror(end(), "intrusive_list::erase(): element is not in a list", (item.*hook).linked());
+
+		list_hook* q = (item.*hook).next;
+		_unlink(&(item.*hook));
+
+		return iterator(q);
+	}
+
+	template <typename value_type, list_hook value_type::* hook>
+	typename intrusive_list<value_type, hook>::iterator intrusive_list<value_type, hook>::erase(const iterator& pos)
+	{
+		mynerror(end(), "intrusive_list::erase(): iterator invalid", pos.ptr == &head);
+		return erase(*pos);
+	}
+}
+
+#endif
@@ -3,26 +3,40 @@
 #define _LIST_HPP_
 
 #include "functional.hpp"
+#include "allocator.hpp"
 
 namespace mystl
 {
-	template <typename value_type>
+	template <typename T, template <typename> class allocator = pool_allocator>
 	class list
 	{
+	public:
+		typedef T value_type;
+
 	protected:
 		struct link
 		{
 			value_type value;
 			link* next;
 			link* prev;
+
+			link()
+				: value(), next(0), prev(0) {}
+
+			link(const value_type& v)
+				: value(v), next(0), prev(0) {}
 		};
 
+		link sentinel;		// not allocated, head always points here
 		link* head;
 		size_t mysize;
 
-	public:
-		typedef value_type value_type;
+		allocator<link> alloc;
 
+		link* _newlink(const value_type& value);
+		void _deletelink(link* p);
+
+	public:
 		class iterator;
 		class const_iterator;
 
@@ -94,19 +108,19 @@ namespace mystl
 
 namespace mystl
 {
-	template <typename value_type>
-	list<value_type>::list()
+	template <typename value_type, template <typename> class allocator>
+	list<value_type, allocator>::list()
 	{
-		head = new link();
+		head = &sentinel;
 
 		head->next = head->prev = head;
 		mysize = 0;
 	}
 
-	template <typename value_type>
-	list<value_type>::list(size_t size, const value_type& value)
+	template <typename value_type, template <typename> class allocator>
+	list<value_type, allocator>::list(size_t size, const value_type& value)
 	{
-		head = new link();
+		head = &sentinel;
 
 		head->next = head->prev = head;
 		mysize = 0;
@@ -114,10 +128,10 @@ namespace mystl
 		resize(size, value);
 	}
 
-	template <typename value_type>
-	list<value_type>::list(const list& other)
+	template <typename value_type, template <typename> class allocator>
+	list<value_type, allocator>::list(const list& other)
 	{
-		head = new link();
+		head = &sentinel;
 
 		head->next = head->prev = head;
 		mysize = 0;
@@ -125,20 +139,30 @@ namespace mystl
 		operator =(other);
 	}
 
-	template <typename value_type>
-	list<value_type>::~list()
+	template <typename value_type, template <typename> class allocator>
+	list<value_type, allocator>::~list()
 	{
-		if( head )
-		{
-			clear();
+		clear();
+	}
 
-			delete head;
-			head = NULL;
-		}
+	template <typename value_type, template <typename> class allocator>
+	typename list<value_type, allocator>::link* list<value_type, allocator>::_newlink(const value_type& value)
+	{
+		link* p = alloc.allocate();
+		new(p) link(value);
+
+		return p;
 	}
 
-	template <typename value_type>
-	list<value_type>& list<value_type>::operator =(const list<value_type>& other)
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::_deletelink(link* p)
+	{
+		p->~link();
+		alloc.deallocate(p);
+	}
+
+	template <typename value_type, template <typename> class allocator>
+	list<value_type, allocator>& list<value_type, allocator>::operator =(const list& other)
 	{
 		if( &other == this )
 			return *this;
@@ -151,41 +175,39 @@ namespace mystl
 		return *this;
 	}
 
-	template <typename value_type>
-	void list<value_type>::push_back(const value_type& item)
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::push_back(const value_type& item)
 	{
 		link* last = head->prev;
 
-		last->next = new link();
+		last->next = _newlink(item);
 		last->next->prev = last;
 		last->next->next = head;
-		last->next->value = item;
 
 		head->prev = last->next;
 		++mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::push_front(const value_type& item)
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::push_front(const value_type& item)
 	{
 		link* first = head->next;
 
-		head->next = new link();
+		head->next = _newlink(item);
 		head->next->prev = head;
 		head->next->next = first;
-		head->next->value = item;
 
 		first->prev = head->next;
 		++mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::pop_front()
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::pop_front()
 	{
 		myerror(, "list::pop_front(): container is empty", mysize > 0);
 
 		link* second = head->next->next;
-		delete head->next;
+		_deletelink(head->next);
 
 		head->next = second;
 		second->prev = head;
@@ -193,8 +215,8 @@ namespace mystl
 		--mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::pop_back()
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::pop_back()
 	{
 		myerror(, "list::pop_back(): container is empty", mysize > 0);
 
@@ -202,13 +224,13 @@ namespace mystl
 		head->prev = last->prev;
 
 		last->prev->next = head;
-		delete last;
+		_deletelink(last);
 
 		--mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::resize(size_t newsize, const value_type& value)
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::resize(size_t newsize, const value_type& value)
 	{
 		if( mysize < newsize )
 		{
@@ -222,8 +244,8 @@ namespace mystl
 		}
 	}
 
-	template <typename value_type>
-	void list<value_type>::clear()
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::clear()
 	{
 		link* q = head->next;
 		link* p;
@@ -232,15 +254,18 @@ namespace mystl
 		{
 			p = q;
 			q = q->next;
-			delete p;
+			_deletelink(p);
 		}
 
 		head->next = head->prev = head;
 		mysize = 0;
+
+		// nothing is alive, new links can start from the beginning of the pool again
+		alloc.reset();
 	}
 
-	template <typename value_type>
-	void list<value_type>::remove(const value_type& value)
+	template <typename value_type, template <typename> class allocator>
+	void list<value_type, allocator>::remove(const value_type& value)
 	{
 		link *p, *r;
 
@@ -254,7 +279,7 @@ namespace mystl
 				p->next = r;
 				r->prev = p;
 
-				delete q;
+				_deletelink(q);
 				q = p;
 
 				--mysize;
@@ -262,26 +287,25 @@ namespace mystl
 		}
 	}
 
-	template <typename value_type>
-	typename list<value_type>::iterator list<value_type>::insert(const iterator& pos, const value_type& value)
+	template <typename value_type, template <typename> class allocator>
+	typename list<value_type, allocator>::iterator list<value_type, allocator>::insert(const iterator& pos, const value_type& value)
 	{
 		mynerror(end(), "list::insert(): iterator invalid", pos.container != this);
 
 		link* q = pos.ptr->prev;
 
-		q->next = new link();
+		q->next = _newlink(value);
 		q->next->next = pos.ptr;
 		q->next->prev = q;
 
 		pos.ptr->prev = q->next;
-		q->next->value = value;
 
 		++mysize;
 		return iterator(this, q->next);
 	}
 
-	template <typename value_type>
-	typename list<value_type>::iterator list<value_type>::erase(iterator& pos)
+	template <typename value_type, template <typename> class allocator>
+	typename list<value_type, allocator>::iterator list<value_type, allocator>::erase(iterator& pos)
 	{
 		myerror(end(), "list::erase(): container is empty", mysize > 0);
 		mynerror(end(), "list::erase(): iterator invalid", pos.container != this);
@@ -293,7 +317,7 @@ namespace mystl
 		p->next = q;
 		q->prev = p;
 
-		delete pos.ptr;
+		_deletelink(pos.ptr);
 		pos.ptr = head;
 
 		--mysize;
@@ -4,8 +4,8 @@
 
 namespace mystl
 {
-    template <typename value_type>
-    class list<value_type>::iterator
+    template <typename value_type, template <typename> class allocator>
+    class list<value_type, allocator>::iterator
     {
         friend class list;
 
@@ -83,8 +83,8 @@ namespace mystl
         }
     };
 
-    template <typename value_type>
-    class list<value_type>::const_iterator
+    template <typename value_type, template <typename> class allocator>
+    class list<value_type, allocator>::const_iterator
     {
         friend class list;
 
@@ -7,7 +7,10 @@
 #include <crtdbg.h>
 
 #include "list.hpp"
+#include "intrusive_list.hpp"
 #include "orderedarray.hpp"
+#include "orderedmultiarray.hpp"
+#include "orderedmap.hpp"
 
 #define DEBUG_METHOD(x)		std::cout << #x << "\n"; x;
 #define ASSERT(x)			{ if( !(x) ) { std::cout << "ASSERTION FAILED: " << #x << "\n"; } }
@@ -97,6 +100,36 @@ int main()
 				std::cout << "benne van a 30\n";
 		}
 
+		SECTION("orderedarray: bounds");
+		{
+			mystl::orderedarray<int> a5;
+
+			a5.insert(1);
+			a5.insert(5);
+			a5.insert(9);
+
+			ASSERT(a5.lower_bound(5) == 1);
+			ASSERT(a5.lower_bound(6) == 1);
+			ASSERT(a5.lower_bound(10) == 2);
+			ASSERT(a5.lower_bound(0) == mystl::orderedarray<int>::npos);
+			ASSERT(a5.upper_bound(6) == 2);
+			ASSERT(a5.upper_bound(10) == 3);
+		}
+
+		SECTION("orderedmultiarray: find");
+		{
+			mystl::orderedmultiarray<int> oma;
+
+			oma.insert(3);
+			oma.insert(7);
+			oma.insert(3);
+
+			ASSERT(oma.find(3) == 0);
+			ASSERT(oma.find(7) == 2);
+			ASSERT(oma.find(5) == mystl::orderedmultiarray<int>::npos);
+			ASSERT(oma.find(8) == mystl::orderedmultiarray<int>::npos);
+		}
+
 		// trls
 		SECTION("orderedarray: erase");
 		{
@@ -303,6 +336,91 @@ int main()
 		}
 	}
 
+	{
+		SECTION("intrusive_list");
+
+		struct Task
+		{
+			int id;
+			mystl::list_hook hook;
+		};
+
+		typedef mystl::intrusive_list<Task, &Task::hook> tasklist;
+
+		Task tasks[5];
+		tasklist t1;
+
+		for( int i = 0; i < 5; ++i )
+		{
+			tasks[i].id = i;
+			t1.push_back(tasks[i]);
+		}
+
+		DEBUG_METHOD(t1.erase(tasks[2]));
+		DEBUG_METHOD(t1.pop_front());
+		DEBUG_METHOD(t1.push_front(tasks[2]));
+
+		for( tasklist::iterator it = t1.begin(); it != t1.end(); ++it )
+			std::cout << it->id << " ";
+
+		std::cout << "\n";
+
+		ASSERT(t1.size() == 4);
+		ASSERT(t1.front().id == 2 && t1.back().id == 4);
+		ASSERT(!tasks[0].hook.linked());
+
+		t1.clear();
+	}
+
+	{
+		SECTION("orderedmap: insert & find");
+		typedef mystl::orderedmap<std::string, int, mystl::string_less> stringmap;
+
+		stringmap m1;
+		size_t ind;
+
+		m1.insert("kiwi", 3);
+		m1.insert("alma", 1);
+		m1.insert("dio", 2);
+		m1.insert("alma", 4);
+		m1.insert("citrom", 5);
+
+		for( size_t i = 0; i < m1.size(); ++i )
+			std::cout << m1.key(i) << " -> " << m1.value(i) << "\n";
+
+		// nem kell hozz std::string
+		DEBUG_METHOD(ind = m1.find("dio"));
+		ASSERT(ind != stringmap::npos && m1.value(ind) == 2);
+
+		DEBUG_METHOD(ind = m1.find("banan"));
+		ASSERT(ind == stringmap::npos);
+
+		SECTION("orderedmap: equal_range & erase");
+
+		stringmap::pairii range = m1.equal_range("alma");
+		std::cout << "equal_range(\"alma\") == [" << range.first << ", " << range.second << ")\n";
+
+		ASSERT(range.second - range.first == 2);
+		ASSERT(m1.value(range.first) == 1);
+
+		DEBUG_METHOD(m1.erase("alma"));
+		ASSERT(m1.size() == 3);
+
+		std::pair<std::string, int> more[] = {
+			std::make_pair(std::string("szilva"), 6),
+			std::make_pair(std::string("barack"), 7),
+			std::make_pair(std::string("kiwi"), 8)
+		};
+
+		DEBUG_METHOD(m1.insert_range(more, more + 3));
+
+		for( size_t i = 0; i < m1.size(); ++i )
+			std::cout << m1.key(i) << " -> " << m1.value(i) << "\n";
+
+		ASSERT(m1.lower_bound("kiwi") == 3);
+		ASSERT(m1.upper_bound("kiwi") == 5);
+	}
+
 	std::cout << "\n";
 	_CrtDumpMemoryLeaks();
 
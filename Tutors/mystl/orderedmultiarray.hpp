@@ -2,6 +2,9 @@
 #ifndef _ORDEREDMULTIARRAY_HPP_
 #define _ORDEREDMULTIARRAY_HPP_
 
+#include <vector>
+#include <algorithm>
+
 #include "functional.hpp"
 
 namespace mystl
@@ -15,18 +18,32 @@ namespace mystl
 		size_t mysize;
 
 		size_t _find(const value_type& value) const;
+		size_t _prepare(const value_type& value);
 
 	public:
-		typedef qpair<size_t, size_t> pairii;
+		typedef std::pair<size_t, size_t> pairii;
 		static const size_t npos = 0xffffffff;
 
 		compare comp;
 
 		orderedmultiarray();
 		orderedmultiarray(const orderedmultiarray& other);
+		orderedmultiarray(orderedmultiarray&& other);
+
+		template <typename input_iterator>
+		orderedmultiarray(input_iterator first, input_iterator last);
+
 		~orderedmultiarray();
 
 		size_t insert(const value_type& value);
+		size_t insert(value_type&& value);
+
+		template <typename arg_type>
+		size_t emplace(arg_type&& arg);
+
+		// sorts the range and merges it in one pass
+		template <typename input_iterator>
+		size_t insert_range(input_iterator first, input_iterator last);
 
 		void erase(const value_type& value);
 		void reserve(size_t newcap);
@@ -41,6 +58,7 @@ namespace mystl
 		size_t upper_bound(const value_type& value) const;
 
 		orderedmultiarray& operator =(const orderedmultiarray& other);
+		orderedmultiarray& operator =(orderedmultiarray&& other);
 	
 		inline const value_type& operator [](size_t index) const {
 			return data[index];
@@ -68,6 +86,29 @@ namespace mystl
 
 		this->operator =(other);
 	}
+
+	template <typename value_type, typename compare>
+	orderedmultiarray<value_type, compare>::orderedmultiarray(orderedmultiarray&& other)
+	{
+		data = other.data;
+		mysize = other.mysize;
+		mycap = other.mycap;
+
+		other.data = 0;
+		other.mysize = 0;
+		other.mycap = 0;
+	}
+	
+	template <typename value_type, typename compare>
+	template <typename input_iterator>
+	orderedmultiarray<value_type, compare>::orderedmultiarray(input_iterator first, input_iterator last)
+	{
+		data = 0;
+		mysize = 0;
+		mycap = 0;
+
+		insert_range(first, last);
+	}
 	
 	template <typename value_type, typename compare>
 	orderedmultiarray<value_type, compare>::~orderedmultiarray()
@@ -98,11 +139,13 @@ namespace mystl
 	}
 	
 	template <typename value_type, typename compare>
-	size_t orderedmultiarray<value_type, compare>::insert(const value_type& value)
+	size_t orderedmultiarray<value_type, compare>::_prepare(const value_type& value)
 	{
+		// leaves an uninitialized slot where value belongs
 		size_t i = 0;
 
-		reserve(mysize + 1);
+		if( mysize == mycap )
+			reserve(std::max<size_t>(mycap * 2, mysize + 1));
 
 		if( mysize > 0 )
 		{
@@ -110,19 +153,107 @@ namespace mystl
 
 			size_t count = (mysize - i);
 
-			new(data + mysize) value_type();
+			if( is_trivially_relocatable<value_type>::value )
+			{
+				memmove((void*)(data + i + 1), (const void*)(data + i), count * sizeof(value_type));
+			}
+			else if( count > 0 )
+			{
+				new(data + mysize) value_type(std::move(data[mysize - 1]));
+
+				for( size_t j = count - 1; j > 0; --j )
+					data[i + j] = std::move(data[i + j - 1]);
 
-			for( size_t j = count; j > 0; --j )
-				data[i + j] = data[i + j - 1];
+				(data + i)->~value_type();
+			}
 		}
-		else
-			new(data) value_type();
 
-		data[i] = value;
+		return i;
+	}
+
+	template <typename value_type, typename compare>
+	size_t orderedmultiarray<value_type, compare>::insert(const value_type& value)
+	{
+		size_t i = _prepare(value);
+
+		new(data + i) value_type(value);
 		++mysize;
 
 		return i;
 	}
+
+	template <typename value_type, typename compare>
+	size_t orderedmultiarray<value_type, compare>::insert(value_type&& value)
+	{
+		size_t i = _prepare(value);
+
+		new(data + i) value_type(std::move(value));
+		++mysize;
+
+		return i;
+	}
+
+	template <typename value_type, typename compare>
+	template <typename arg_type>
+	size_t orderedmultiarray<value_type, compare>::emplace(arg_type&& arg)
+	{
+		// the position depends on the value, so it has to be constructed first
+		value_type value(std::forward<arg_type>(arg));
+		return insert(std::move(value));
+	}
+	
+	template <typename value_type, typename compare>
+	template <typename input_iterator>
+	size_t orderedmultiarray<value_type, compare>::insert_range(input_iterator first, input_iterator last)
+	{
+		std::vector<value_type> batch(first, last);
+
+		if( batch.empty() )
+			return 0;
+
+		// stable, so that equal elements keep their order of insertion
+		std::stable_sort(batch.begin(), batch.end(), comp);
+
+		size_t newcap = std::max<size_t>(mycap, mysize + batch.size());
+		value_type* newdata = (value_type*)malloc(newcap * sizeof(value_type));
+		value_type* out = newdata;
+		size_t i = 0;
+		size_t j = 0;
+
+		// existing elements come first among equals
+		while( i < mysize || j < batch.size() )
+		{
+			if( j == batch.size() || (i < mysize && !comp(batch[j], data[i])) )
+			{
+				new(out) value_type(std::move(data[i]));
+
+				++out;
+				++i;
+			}
+			else
+			{
+				new(out) value_type(std::move(batch[j]));
+
+				++out;
+				++j;
+			}
+		}
+
+		size_t newsize = (size_t)(out - newdata);
+		size_t count = newsize - mysize;
+
+		for( size_t k = 0; k < mysize; ++k )
+			(data + k)->~value_type();
+
+		if( data )
+			free(data);
+
+		data = newdata;
+		mysize = newsize;
+		mycap = newcap;
+
+		return count;
+	}
 	
 	template <typename value_type, typename compare>
 	void orderedmultiarray<value_type, compare>::erase(const value_type& value)
@@ -133,11 +264,21 @@ namespace mystl
 		{
 			size_t count = (mysize - p.second);
 
-			for( size_t j = 0; j < count; ++j )
-				data[p.first + j] = data[p.second + j];
+			if( is_trivially_relocatable<value_type>::value )
+			{
+				for( size_t i = p.first; i < p.second; ++i )
+					(data + i)->~value_type();
 
-			for( size_t i = p.first + count; i < mysize; ++i )
-				(data + i)->~value_type();
+				memmove((void*)(data + p.first), (const void*)(data + p.second), count * sizeof(value_type));
+			}
+			else
+			{
+				for( size_t j = 0; j < count; ++j )
+					data[p.first + j] = std::move(data[p.second + j]);
+
+				for( size_t i = p.first + count; i < mysize; ++i )
+					(data + i)->~value_type();
+			}
 
 			mysize -= (p.second - p.first);
 
@@ -154,18 +295,27 @@ namespace mystl
 			size_t diff = newcap - mycap;
 			diff = std::max<size_t>(diff, 10);
 
-			value_type* newdata = (value_type*)malloc((mycap + diff) * sizeof(value_type));
+			if( is_trivially_relocatable<value_type>::value )
+			{
+				// no need to touch the elements one by one
+				data = (value_type*)realloc((void*)data, (mycap + diff) * sizeof(value_type));
+			}
+			else
+			{
+				value_type* newdata = (value_type*)malloc((mycap + diff) * sizeof(value_type));
+
+				for( size_t i = 0; i < mysize; ++i )
+					new(newdata + i) value_type(std::move(data[i]));
 
-			for( size_t i = 0; i < mysize; ++i )
-				new(newdata + i) value_type(data[i]);
+				for( size_t i = 0; i < mysize; ++i )
+					(data + i)->~value_type();
 
-			for( size_t i = 0; i < mysize; ++i )
-				(data + i)->~value_type();
+				if( data )
+					free(data);
 
-			if( data )
-				free(data);
+				data = newdata;
+			}
 
-			data = newdata;
 			mycap = mycap + diff;
 		}
 	}
@@ -257,7 +407,12 @@ namespace mystl
 	template <typename value_type, typename compare>
 	size_t orderedmultiarray<value_type, compare>::find(const value_type& value) const
 	{
-		return lower_bound(value);
+		size_t ind = lower_bound(value);
+
+		if( ind < mysize && !comp(value, data[ind]) )
+			return ind;
+
+		return npos;
 	}
 	
 	template <typename value_type, typename compare>
@@ -343,8 +498,35 @@ namespace mystl
 		reserve(other.mycap);
 		mysize = other.mysize;
 
-		for( size_t i = 0; i < mysize; ++i )
-			new(data + i) value_type(other.data[i]);
+		if( is_trivially_relocatable<value_type>::value )
+		{
+			if( mysize > 0 )
+				memcpy((void*)data, (const void*)other.data, mysize * sizeof(value_type));
+		}
+		else
+		{
+			for( size_t i = 0; i < mysize; ++i )
+				new(data + i) value_type(other.data[i]);
+		}
+
+		return *this;
+	}
+
+	template <typename value_type, typename compare>
+	orderedmultiarray<value_type, compare>& orderedmultiarray<value_type, compare>::operator =(orderedmultiarray&& other)
+	{
+		if( &other != this )
+		{
+			destroy();
+
+			data = other.data;
+			mysize = other.mysize;
+			mycap = other.mycap;
+
+			other.data = 0;
+			other.mysize = 0;
+			other.mycap = 0;
+		}
 
 		return *this;
 	}
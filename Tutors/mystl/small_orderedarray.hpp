@@ -0,0 +1,590 @@
+
+#ifndef _SMALL_ORDEREDARRAY_HPP_
+#define _SMALL_ORDEREDARRAY_HPP_
+
+#include <vector>
+#include <algorithm>
+
+#include "functional.hpp"
+
+#if defined(_MSC_VER) || defined(__SSE2__)
+#	include <emmintrin.h>
+#	define MYSTL_SSE2
+#endif
+
+namespace mystl
+{
+	// number of elements less than value; for sorted data it's the lower bound
+	template <typename value_type, typename compare>
+	inline size_t _count_less(const value_type* data, size_t count, const value_type& value, const compare& comp)
+	{
+		size_t result = 0;
+
+		// no early exit, the loop is short and branch free
+		for( size_t i = 0; i < count; ++i )
+			result += (comp(data[i], value) ? 1 : 0);
+
+		return result;
+	}
+
+#ifdef MYSTL_SSE2
+	inline size_t _count_less(const int* data, size_t count, const int& value, const default_less<int>&)
+	{
+		__m128i v = _mm_set1_epi32(value);
+		__m128i sum = _mm_setzero_si128();
+		size_t i = 0;
+		size_t result = 0;
+
+		for( ; i + 4 <= count; i += 4 )
+			sum = _mm_sub_epi32(sum, _mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)(data + i)), v));
+
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		result = (size_t)_mm_cvtsi128_si32(sum);
+
+		for( ; i < count; ++i )
+			result += (data[i] < value ? 1 : 0);
+
+		return result;
+	}
+
+	inline size_t _count_less(const float* data, size_t count, const float& value, const default_less<float>&)
+	{
+		__m128 v = _mm_set1_ps(value);
+		__m128i sum = _mm_setzero_si128();
+		size_t i = 0;
+		size_t result = 0;
+
+		for( ; i + 4 <= count; i += 4 )
+			sum = _mm_sub_epi32(sum, _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(data + i), v)));
+
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		result = (size_t)_mm_cvtsi128_si32(sum);
+
+		for( ; i < count; ++i )
+			result += (data[i] < value ? 1 : 0);
+
+		return result;
+	}
+#endif
+
+	// orderedarray that keeps up to N elements in itself, and only allocates beyond that
+	template <typename value_type, size_t N, typename compare = default_less<value_type> >
+	class small_orderedarray
+	{
+	private:
+		typedef typename std::aligned_storage<sizeof(value_type) * N, std::alignment_of<value_type>::value>::type storage;
+
+		value_type* data;	// points to buffer until it spills
+		size_t mycap;
+		size_t mysize;
+		storage buffer;
+
+		size_t _find(const value_type& value) const;
+		size_t _prepare(const value_type& value);
+
+		void _makeroom(size_t index);
+		void _relocate(value_type* dest, value_type* src, size_t count);
+		void _steal(small_orderedarray& other);
+
+		inline value_type* _inline() {
+			return reinterpret_cast<value_type*>(&buffer);
+		}
+
+	public:
+		static const size_t npos = 0xffffffff;
+
+		compare comp;
+
+		small_orderedarray();
+		small_orderedarray(const small_orderedarray& other);
+		small_orderedarray(small_orderedarray&& other);
+
+		template <typename input_iterator>
+		small_orderedarray(input_iterator first, input_iterator last);
+
+		~small_orderedarray();
+
+		bool insert(const value_type& value);
+		bool insert(value_type&& value);
+
+		template <typename arg_type>
+		bool emplace(arg_type&& arg);
+
+		// sorts the range and merges it in one pass, duplicates are dropped
+		template <typename input_iterator>
+		size_t insert_range(input_iterator first, input_iterator last);
+
+		void erase(const value_type& value);
+		void erase_at(size_t index);
+		void reserve(size_t newcap);
+		void destroy();
+		void clear();
+		void swap(small_orderedarray& other);
+
+		size_t find(const value_type& value) const;
+		size_t lower_bound(const value_type& value) const;
+		size_t upper_bound(const value_type& value) const;
+
+		small_orderedarray& operator =(const small_orderedarray& other);
+		small_orderedarray& operator =(small_orderedarray&& other);
+
+		inline const value_type& operator [](size_t index) const {
+			return data[index];
+		}
+
+		inline size_t size() const {
+			return mysize;
+		}
+
+		inline size_t capacity() const {
+			return mycap;
+		}
+
+		inline bool is_inline() const {
+			return (mycap == N);
+		}
+	};
+
+	template <typename value_type, size_t N, typename compare>
+	small_orderedarray<value_type, N, compare>::small_orderedarray()
+	{
+		data = _inline();
+		mysize = 0;
+		mycap = N;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	small_orderedarray<value_type, N, compare>::small_orderedarray(const small_orderedarray& other)
+	{
+		data = _inline();
+		mysize = 0;
+		mycap = N;
+
+		this->operator =(other);
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	small_orderedarray<value_type, N, compare>::small_orderedarray(small_orderedarray&& other)
+	{
+		data = _inline();
+		mysize = 0;
+		mycap = N;
+
+		_steal(other);
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	template <typename input_iterator>
+	small_orderedarray<value_type, N, compare>::small_orderedarray(input_iterator first, input_iterator last)
+	{
+		data = _inline();
+		mysize = 0;
+		mycap = N;
+
+		insert_range(first, last);
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	small_orderedarray<value_type, N, compare>::~small_orderedarray()
+	{
+		destroy();
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	size_t small_orderedarray<value_type, N, compare>::_find(const value_type& value) const
+	{
+		// a linear scan of a few elements is faster than jumping around
+		if( mysize <= N )
+			return _count_less(data, mysize, value, comp);
+
+		size_t low = 0;
+		size_t high = mysize;
+		size_t mid = (low + high) / 2;
+
+		while( low < high )
+		{
+			if( comp(data[mid], value) )
+				low = mid + 1;
+			else if( comp(value, data[mid]) )
+				high = mid;
+			else
+				return mid;
+
+			mid = (low + high) / 2;
+		}
+
+		return low;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::_relocate(value_type* dest, value_type* src, size_t count)
+	{
+		if( is_trivially_relocatable<value_type>::value )
+		{
+			if( count > 0 )
+				memcpy((void*)dest, (const void*)src, count * sizeof(value_type));
+		}
+		else
+		{
+			for( size_t i = 0; i < count; ++i )
+				new(dest + i) value_type(std::move(src[i]));
+
+			for( size_t i = 0; i < count; ++i )
+				(src + i)->~value_type();
+		}
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::_steal(small_orderedarray& other)
+	{
+		// expects this to be empty and inline
+		comp = other.comp;
+
+		if( other.is_inline() )
+		{
+			_relocate(data, other.data, other.mysize);
+			mysize = other.mysize;
+		}
+		else
+		{
+			data = other.data;
+			mysize = other.mysize;
+			mycap = other.mycap;
+
+			other.data = other._inline();
+			other.mycap = N;
+		}
+
+		other.mysize = 0;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::_makeroom(size_t index)
+	{
+		// leaves an uninitialized slot at index
+		size_t count = (mysize - index);
+
+		if( is_trivially_relocatable<value_type>::value )
+		{
+			memmove((void*)(data + index + 1), (const void*)(data + index), count * sizeof(value_type));
+		}
+		else if( count > 0 )
+		{
+			new(data + mysize) value_type(std::move(data[mysize - 1]));
+
+			for( size_t j = count - 1; j > 0; --j )
+				data[index + j] = std::move(data[index + j - 1]);
+
+			(data + index)->~value_type();
+		}
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	size_t small_orderedarray<value_type, N, compare>::_prepare(const value_type& value)
+	{
+		size_t i = 0;
+
+		if( mysize > 0 )
+		{
+			i = _find(value);
+
+			if( i < mysize && !(comp(data[i], value) || comp(value, data[i])) )
+				return npos;
+		}
+
+		if( mysize == mycap )
+			reserve(mycap * 2);
+
+		_makeroom(i);
+		return i;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	bool small_orderedarray<value_type, N, compare>::insert(const value_type& value)
+	{
+		size_t i = _prepare(value);
+
+		if( i == npos )
+			return false;
+
+		new(data + i) value_type(value);
+		++mysize;
+
+		return true;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	bool small_orderedarray<value_type, N, compare>::insert(value_type&& value)
+	{
+		size_t i = _prepare(value);
+
+		if( i == npos )
+			return false;
+
+		new(data + i) value_type(std::move(value));
+		++mysize;
+
+		return true;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	template <typename arg_type>
+	bool small_orderedarray<value_type, N, compare>::emplace(arg_type&& arg)
+	{
+		// the position depends on the value, so it has to be constructed first
+		value_type value(std::forward<arg_type>(arg));
+		return insert(std::move(value));
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	template <typename input_iterator>
+	size_t small_orderedarray<value_type, N, compare>::insert_range(input_iterator first, input_iterator last)
+	{
+		std::vector<value_type> batch(first, last);
+
+		if( batch.empty() )
+			return 0;
+
+		// stable, so that the first of equal elements is kept (like with insert())
+		std::stable_sort(batch.begin(), batch.end(), comp);
+
+		size_t newcap = std::max<size_t>(mycap, mysize + batch.size());
+		value_type* newdata = (value_type*)malloc(newcap * sizeof(value_type));
+		value_type* out = newdata;
+		size_t i = 0;
+		size_t j = 0;
+
+		// existing elements come first among equals
+		while( i < mysize || j < batch.size() )
+		{
+			if( j == batch.size() || (i < mysize && !comp(batch[j], data[i])) )
+			{
+				new(out) value_type(std::move(data[i]));
+
+				++out;
+				++i;
+			}
+			else
+			{
+				if( out == newdata || comp(*(out - 1), batch[j]) )
+				{
+					new(out) value_type(std::move(batch[j]));
+					++out;
+				}
+
+				++j;
+			}
+		}
+
+		size_t newsize = (size_t)(out - newdata);
+		size_t count = newsize - mysize;
+
+		for( size_t k = 0; k < mysize; ++k )
+			(data + k)->~value_type();
+
+		if( !is_inline() )
+		{
+			free(data);
+
+			data = newdata;
+			mycap = newcap;
+		}
+		else if( newsize > N )
+		{
+			data = newdata;
+			mycap = newcap;
+		}
+		else
+		{
+			// duplicates were dropped, so it might still fit
+			_relocate(data, newdata, newsize);
+			free(newdata);
+		}
+
+		mysize = newsize;
+		return count;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::erase(const value_type& value)
+	{
+		size_t i = find(value);
+
+		if( i != npos )
+			erase_at(i);
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::erase_at(size_t index)
+	{
+		if( index < mysize )
+		{
+			size_t count = (mysize - index) - 1;
+
+			if( is_trivially_relocatable<value_type>::value )
+			{
+				(data + index)->~value_type();
+				memmove((void*)(data + index), (const void*)(data + index + 1), count * sizeof(value_type));
+			}
+			else
+			{
+				for( size_t j = 0; j < count; ++j )
+					data[index + j] = std::move(data[index + j + 1]);
+
+				(data + index + count)->~value_type();
+			}
+
+			--mysize;
+		}
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::reserve(size_t newcap)
+	{
+		if( mycap < newcap )
+		{
+			size_t diff = newcap - mycap;
+			diff = std::max<size_t>(diff, 10);
+
+			if( !is_inline() && is_trivially_relocatable<value_type>::value )
+			{
+				data = (value_type*)realloc((void*)data, (mycap + diff) * sizeof(value_type));
+			}
+			else
+			{
+				// spill to the heap (or grow there)
+				value_type* newdata = (value_type*)malloc((mycap + diff) * sizeof(value_type));
+				_relocate(newdata, data, mysize);
+
+				if( !is_inline() )
+					free(data);
+
+				data = newdata;
+			}
+
+			mycap = mycap + diff;
+		}
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::destroy()
+	{
+		clear();
+
+		if( !is_inline() )
+			free(data);
+
+		data = _inline();
+		mysize = 0;
+		mycap = N;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::clear()
+	{
+		for( size_t i = 0; i < mysize; ++i )
+			(data + i)->~value_type();
+
+		mysize = 0;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	void small_orderedarray<value_type, N, compare>::swap(small_orderedarray& other)
+	{
+		if( &other == this )
+			return;
+
+		// inline elements can't be exchanged by pointers
+		small_orderedarray tmp(std::move(other));
+
+		other._steal(*this);
+		_steal(tmp);
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	size_t small_orderedarray<value_type, N, compare>::find(const value_type& value) const
+	{
+		if( mysize > 0 )
+		{
+			size_t ind = _find(value);
+
+			if( ind < mysize )
+			{
+				if( !(comp(data[ind], value) || comp(value, data[ind])) )
+					return ind;
+			}
+		}
+
+		return npos;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	size_t small_orderedarray<value_type, N, compare>::lower_bound(const value_type& value) const
+	{
+		// returns the first that is not greater
+		if( mysize > 0 )
+		{
+			size_t ind = _find(value);
+
+			if( ind < mysize && !(comp(data[ind], value) || comp(value, data[ind])) )
+				return ind;
+			else if( ind > 0 )
+				return ind - 1;
+		}
+
+		return npos;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	size_t small_orderedarray<value_type, N, compare>::upper_bound(const value_type& value) const
+	{
+		// returns the first that is not smaller
+		return _find(value);
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	small_orderedarray<value_type, N, compare>& small_orderedarray<value_type, N, compare>::operator =(const small_orderedarray& other)
+	{
+		if( &other == this )
+			return *this;
+
+		clear();
+
+		// stays inline if it fits
+		reserve(other.mysize);
+
+		mysize = other.mysize;
+		comp = other.comp;
+
+		if( is_trivially_relocatable<value_type>::value )
+		{
+			if( mysize > 0 )
+				memcpy((void*)data, (const void*)other.data, mysize * sizeof(value_type));
+		}
+		else
+		{
+			for( size_t i = 0; i < mysize; ++i )
+				new(data + i) value_type(other.data[i]);
+		}
+
+		return *this;
+	}
+
+	template <typename value_type, size_t N, typename compare>
+	small_orderedarray<value_type, N, compare>& small_orderedarray<value_type, N, compare>::operator =(small_orderedarray&& other)
+	{
+		if( &other != this )
+		{
+			destroy();
+			_steal(other);
+		}
+
+		return *this;
+	}
+}
+
+#endif
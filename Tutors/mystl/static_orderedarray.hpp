@@ -0,0 +1,271 @@
+
+#ifndef _STATIC_ORDEREDARRAY_HPP_
+#define _STATIC_ORDEREDARRAY_HPP_
+
+#include "orderedarray.hpp"
+
+#if defined(_MSC_VER) || defined(__SSE__)
+#	include <xmmintrin.h>
+#	define MYSTL_PREFETCH(p)	_mm_prefetch((const char*)(p), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#	define MYSTL_PREFETCH(p)	__builtin_prefetch(p)
+#else
+#	define MYSTL_PREFETCH(p)
+#endif
+
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
+
+namespace mystl
+{
+	// read-only version of orderedarray for lookup tables; searches an Eytzinger (BFS) ordered copy
+	template <typename value_type, typename compare = default_less<value_type> >
+	class static_orderedarray
+	{
+	private:
+		value_type* data;		// sorted order
+		value_type* tree;		// Eytzinger order, starting at index 1
+		unsigned int* ranks;	// index of tree[k] in data
+		char* treebuffer;		// tree is aligned to cache line
+		size_t mysize;
+
+		size_t _build(size_t index, size_t node);
+		size_t _find(const value_type& value) const;
+		size_t _rank(size_t node) const;
+
+		void _assign(const value_type* sorted, size_t count);
+
+	public:
+		static const size_t npos = 0xffffffff;
+
+		compare comp;
+
+		static_orderedarray();
+		static_orderedarray(const static_orderedarray& other);
+		explicit static_orderedarray(const orderedarray<value_type, compare>& other);
+		~static_orderedarray();
+
+		void assign(const orderedarray<value_type, compare>& other);
+		void destroy();
+
+		size_t find(const value_type& value) const;
+		size_t lower_bound(const value_type& value) const;
+		size_t upper_bound(const value_type& value) const;
+
+		static_orderedarray& operator =(const static_orderedarray& other);
+
+		inline const value_type& operator [](size_t index) const {
+			return data[index];
+		}
+
+		inline size_t size() const {
+			return mysize;
+		}
+	};
+
+	template <typename value_type, typename compare>
+	static_orderedarray<value_type, compare>::static_orderedarray()
+	{
+		data = 0;
+		tree = 0;
+		ranks = 0;
+		treebuffer = 0;
+		mysize = 0;
+	}
+
+	template <typename value_type, typename compare>
+	static_orderedarray<value_type, compare>::static_orderedarray(const static_orderedarray& other)
+	{
+		data = 0;
+		tree = 0;
+		ranks = 0;
+		treebuffer = 0;
+		mysize = 0;
+
+		this->operator =(other);
+	}
+
+	template <typename value_type, typename compare>
+	static_orderedarray<value_type, compare>::static_orderedarray(const orderedarray<value_type, compare>& other)
+	{
+		data = 0;
+		tree = 0;
+		ranks = 0;
+		treebuffer = 0;
+		mysize = 0;
+
+		assign(other);
+	}
+
+	template <typename value_type, typename compare>
+	static_orderedarray<value_type, compare>::~static_orderedarray()
+	{
+		destroy();
+	}
+
+	template <typename value_type, typename compare>
+	size_t static_orderedarray<value_type, compare>::_build(size_t index, size_t node)
+	{
+		// in-order traversal of the implicit tree visits the elements in sorted order
+		if( node <= mysize )
+		{
+			index = _build(index, 2 * node);
+
+			new(tree + node) value_type(data[index]);
+			ranks[node] = (unsigned int)index;
+
+			index = _build(index + 1, 2 * node + 1);
+		}
+
+		return index;
+	}
+
+	template <typename value_type, typename compare>
+	size_t static_orderedarray<value_type, compare>::_find(const value_type& value) const
+	{
+		// descendants of node four levels deeper (for ints) share one cache line
+		const size_t lookahead = (64 / sizeof(value_type) > 0 ? 64 / sizeof(value_type) : 1);
+		size_t node = 1;
+
+		// branchless: the comparison result selects the child
+		while( node <= mysize )
+		{
+			MYSTL_PREFETCH(tree + node * lookahead);
+			node = 2 * node + (size_t)comp(tree[node], value);
+		}
+
+		// the last left turn was to the first element not less than value (0 if none)
+#if defined(_MSC_VER)
+		unsigned long ones;
+
+#	ifdef _WIN64
+		_BitScanForward64(&ones, ~node);
+#	else
+		_BitScanForward(&ones, ~node);
+#	endif
+
+		return (node >> (ones + 1));
+#elif defined(__GNUC__)
+		return (node >> (__builtin_ctzl(~node) + 1));
+#else
+		while( node & 1 )
+			node >>= 1;
+
+		return (node >> 1);
+#endif
+	}
+
+	template <typename value_type, typename compare>
+	size_t static_orderedarray<value_type, compare>::_rank(size_t node) const
+	{
+		return (node == 0 ? mysize : ranks[node]);
+	}
+
+	template <typename value_type, typename compare>
+	void static_orderedarray<value_type, compare>::_assign(const value_type* sorted, size_t count)
+	{
+		destroy();
+
+		if( count == 0 )
+			return;
+
+		data = (value_type*)malloc(count * sizeof(value_type));
+		treebuffer = (char*)malloc((count + 1) * sizeof(value_type) + 64);
+		tree = (value_type*)(treebuffer + 64 - ((size_t)treebuffer % 64));
+		ranks = (unsigned int*)malloc((count + 1) * sizeof(unsigned int));
+
+		for( size_t i = 0; i < count; ++i )
+			new(data + i) value_type(sorted[i]);
+
+		mysize = count;
+		ranks[0] = 0;
+
+		_build(0, 1);
+	}
+
+	template <typename value_type, typename compare>
+	void static_orderedarray<value_type, compare>::assign(const orderedarray<value_type, compare>& other)
+	{
+		if( other.size() == 0 )
+		{
+			destroy();
+			return;
+		}
+
+		comp = other.comp;
+		_assign(&other[0], other.size());
+	}
+
+	template <typename value_type, typename compare>
+	void static_orderedarray<value_type, compare>::destroy()
+	{
+		for( size_t i = 0; i < mysize; ++i )
+		{
+			(data + i)->~value_type();
+			(tree + i + 1)->~value_type();
+		}
+
+		if( data )
+			free(data);
+
+		if( treebuffer )
+			free(treebuffer);
+
+		if( ranks )
+			free(ranks);
+
+		data = 0;
+		tree = 0;
+		ranks = 0;
+		treebuffer = 0;
+		mysize = 0;
+	}
+
+	template <typename value_type, typename compare>
+	size_t static_orderedarray<value_type, compare>::find(const value_type& value) const
+	{
+		size_t node = _find(value);
+
+		if( node > 0 && !comp(value, tree[node]) )
+			return ranks[node];
+
+		return npos;
+	}
+
+	template <typename value_type, typename compare>
+	size_t static_orderedarray<value_type, compare>::lower_bound(const value_type& value) const
+	{
+		// returns the first that is not greater
+		size_t node = _find(value);
+		size_t ind = _rank(node);
+
+		if( node > 0 && !comp(value, tree[node]) )
+			return ind;
+		else if( ind > 0 )
+			return ind - 1;
+
+		return npos;
+	}
+
+	template <typename value_type, typename compare>
+	size_t static_orderedarray<value_type, compare>::upper_bound(const value_type& value) const
+	{
+		// returns the first that is not smaller
+		return _rank(_find(value));
+	}
+
+	template <typename value_type, typename compare>
+	static_orderedarray<value_type, compare>& static_orderedarray<value_type, compare>::operator =(const static_orderedarray& other)
+	{
+		if( &other == this )
+			return *this;
+
+		comp = other.comp;
+		_assign(other.data, other.mysize);
+
+		return *this;
+	}
+}
+
+#endif
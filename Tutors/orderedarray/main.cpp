@@ -1,6 +1,10 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
 
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
@@ -18,6 +22,10 @@ typedef orderedarray orderedarray_t;
 typedef mystl::orderedarray<int> orderedarray_t;
 #endif
 
+#include "orderedarray.h"
+
+#define NUM_LOOKUPS	1048576
+
 struct test_struct
 {
 	int i;
@@ -29,8 +37,73 @@ struct test_struct
 	}
 };
 
+// a find() s a find_many() a vrt indexet adja-e, s mennyivel gyorsabb a find_many()
+bool TestFindMany(size_t count)
+{
+	orderedarray oa;
+	std::vector<int> keys(NUM_LOOKUPS);
+	std::vector<size_t> single(NUM_LOOKUPS);
+	std::vector<size_t> batched(NUM_LOOKUPS);
+
+	oa.reserve(count);
+
+	// pros szmok, gy a kulcsok fele benne van
+	for( size_t i = 0; i < count; ++i )
+		oa.insert((int)i * 2);
+
+	// a kt szln kvl is keresnk
+	for( size_t i = 0; i < NUM_LOOKUPS; ++i )
+		keys[i] = (int)((((size_t)rand() << 15) ^ (size_t)rand()) % (count * 2 + 2)) - 1;
+
+	clock_t start = clock();
+
+	for( size_t i = 0; i < NUM_LOOKUPS; ++i )
+		single[i] = oa.find(keys[i]);
+
+	clock_t middle = clock();
+	oa.find_many(&keys[0], NUM_LOOKUPS, &batched[0]);
+
+	clock_t end = clock();
+
+	printf("%10u | %11.1f | %15.1f\n", (unsigned int)count,
+		(middle - start) * 1e9 / CLOCKS_PER_SEC / NUM_LOOKUPS,
+		(end - middle) * 1e9 / CLOCKS_PER_SEC / NUM_LOOKUPS);
+
+	// a pros kulcs indexe key / 2, a tbbi nincs benne
+	for( size_t i = 0; i < NUM_LOOKUPS; ++i )
+	{
+		size_t expected = ((keys[i] >= 0 && keys[i] % 2 == 0 && keys[i] < (int)count * 2) ? (size_t)keys[i] / 2 : orderedarray::npos);
+
+		if( single[i] != expected )
+		{
+			std::cout << "* ERROR: find(" << keys[i] << ") != " << expected << "\n";
+			return false;
+		}
+
+		if( batched[i] != expected )
+		{
+			std::cout << "* ERROR: find_many(" << keys[i] << ") != " << expected << "\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
 int main()
 {
+	// int-es vltozat: find() vs. find_many(), ns / keress
+	std::cout << "      size |  find (ns)  |  find_many (ns)\n";
+	std::cout << "-----------+-------------+----------------\n";
+
+	for( size_t count = 1; count <= 10000000; count *= 10 )
+	{
+		if( !TestFindMany(count) )
+			break;
+	}
+
+	std::cout << "\n";
+
 	{
 		mystl::orderedmultiarray<test_struct, mystl::default_less<test_struct> > a;
 		test_struct t;
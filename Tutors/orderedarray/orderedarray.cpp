@@ -1,6 +1,61 @@
 
 #include "orderedarray.h"
 #include <cstring>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#elif defined(_MSC_VER) || defined(__SSE2__)
+#	include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) || defined(__SSE2__)
+#	define PREFETCH(p)	_mm_prefetch((const char*)(p), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#	define PREFETCH(p)	__builtin_prefetch(p)
+#else
+#	define PREFETCH(p)
+#endif
+
+// ennyi elemet mr linerisan nznk vgig (kt cache line)
+#define SEARCH_WINDOW	32
+
+// ennyi keress fut egyszerre a find_many()-ben
+#define SEARCH_BATCH	8
+
+static size_t CountLess(const int* window, int value)
+{
+	// SEARCH_WINDOW darab elembl hny kisebb value-nl
+#if defined(__AVX2__)
+	__m256i v = _mm256_set1_epi32(value);
+	__m256i acc = _mm256_setzero_si256();
+
+	for( int i = 0; i < SEARCH_WINDOW; i += 8 )
+		acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(v, _mm256_loadu_si256((const __m256i*)(window + i))));
+
+	__m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+#elif defined(_MSC_VER) || defined(__SSE2__)
+	__m128i v = _mm_set1_epi32(value);
+	__m128i sum = _mm_setzero_si128();
+
+	for( int i = 0; i < SEARCH_WINDOW; i += 4 )
+		sum = _mm_sub_epi32(sum, _mm_cmpgt_epi32(v, _mm_loadu_si128((const __m128i*)(window + i))));
+#else
+	size_t count = 0;
+
+	for( int i = 0; i < SEARCH_WINDOW; ++i )
+		count += (window[i] < value);
+
+	return count;
+#endif
+
+#if defined(__AVX2__) || defined(_MSC_VER) || defined(__SSE2__)
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	return (size_t)_mm_cvtsi128_si32(sum);
+#endif
+}
 
 orderedarray::orderedarray()
 {
@@ -26,24 +81,40 @@ orderedarray::~orderedarray()
 
 size_t orderedarray::_find(int value) const
 {
-	size_t low = 0;
-	size_t high = mysize;
-	size_t mid = (low + high) / 2;
+	// az els olyan indexet adja, ami nem kisebb value-nl
+	if( mysize < SEARCH_WINDOW )
+	{
+		size_t count = 0;
+
+		for( size_t i = 0; i < mysize; ++i )
+			count += (data[i] < value);
 
-	// logaritmikus keress
-	while( low < high )
+		return count;
+	}
+
+	const int* base = data;
+	size_t n = mysize;
+
+	// elgazs nlkli logaritmikus keress, a keresett hely mindig [base, base + n]-ben van
+	while( n > SEARCH_WINDOW )
 	{
-		if( data[mid] < value )
-			low = mid + 1;
-		else if( data[mid] > value )
-			high = mid;
-		else
-			return mid;
-
-		mid = (low + high) / 2;
+		size_t half = n / 2;
+
+		// mindkt lehetsges kvetkez kzps elemet elre betltjk
+		PREFETCH(base + half / 2);
+		PREFETCH(base + half + half / 2);
+
+		base = (base[half] < value ? base + half : base);
+		n -= half;
 	}
 
-	return low;
+	// base eltt minden kisebb, ezrt az ablak eltolhat, hogy ne lgjon ki
+	const int* window = data + mysize - SEARCH_WINDOW;
+
+	if( base < window )
+		window = base;
+
+	return (size_t)(window - data) + CountLess(window, value);
 }
 
 bool orderedarray::insert(int value)
@@ -148,6 +219,57 @@ size_t orderedarray::find(int value) const
 	return npos;
 }
 
+void orderedarray::find_many(const int* keys, size_t n, size_t* out) const
+{
+	// a keressek egymstl fggetlenek, gy a cache miss-ek tfedik egymst
+	const int* base[SEARCH_BATCH];
+
+	if( mysize < SEARCH_WINDOW )
+	{
+		for( size_t i = 0; i < n; ++i )
+			out[i] = find(keys[i]);
+
+		return;
+	}
+
+	const int* window = data + mysize - SEARCH_WINDOW;
+
+	for( size_t i = 0; i < n; i += SEARCH_BATCH )
+	{
+		size_t batch = std::min<size_t>(SEARCH_BATCH, n - i);
+		size_t count = mysize;
+		const int* k = keys + i;
+
+		for( size_t j = 0; j < batch; ++j )
+			base[j] = data;
+
+		// a mret minden keressnl ugyangy fogy
+		while( count > SEARCH_WINDOW )
+		{
+			size_t half = count / 2;
+
+			for( size_t j = 0; j < batch; ++j )
+			{
+				PREFETCH(base[j] + half / 2);
+				PREFETCH(base[j] + half + half / 2);
+			}
+
+			for( size_t j = 0; j < batch; ++j )
+				base[j] = (base[j][half] < k[j] ? base[j] + half : base[j]);
+
+			count -= half;
+		}
+
+		for( size_t j = 0; j < batch; ++j )
+		{
+			const int* start = (base[j] < window ? base[j] : window);
+			size_t ind = (size_t)(start - data) + CountLess(start, k[j]);
+
+			out[i + j] = ((ind < mysize && data[ind] == k[j]) ? ind : npos);
+		}
+	}
+}
+
 orderedarray& orderedarray::operator =(const orderedarray& other)
 {
 	if( &other == this )
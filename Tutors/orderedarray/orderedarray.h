@@ -46,6 +46,9 @@ public:
 	//! Ha benne van akkor az indext adja, ha nem akkor npos-t
 	size_t find(int value) const;
 
+	//! Tbb elemet keres egyszerre, out[i] = find(keys[i])
+	void find_many(const int* keys, size_t n, size_t* out) const;
+
 	//! rtkads opertor
 	orderedarray& operator =(const orderedarray& other);
 
@@ -0,0 +1,531 @@
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "batch.h"
+#include "imagefile.h"
+
+#ifndef _WIN32
+#	include <pthread.h>
+#	include <dirent.h>
+#	include <sys/stat.h>
+#	include <time.h>
+#endif
+
+#define PAGE_SIZE_HINT	4096
+
+enum batchstage
+{
+	StageRead = 0,
+	StageCompute,
+	StageWrite
+};
+
+struct batchitem
+{
+	qstring		name1;
+	qstring		name2;
+	qstring		outname;
+
+	mappedfile	file1;
+	mappedfile	file2;
+	mappedfile	outfile;
+
+	imageview	img1;
+	imageview	img2;
+	imageview	out;
+
+	bool		valid;
+};
+
+class batchqueue
+{
+private:
+#ifdef _WIN32
+	CRITICAL_SECTION	guard;
+	CONDITION_VARIABLE	notempty;
+	CONDITION_VARIABLE	notfull;
+#else
+	pthread_mutex_t		guard;
+	pthread_cond_t		notempty;
+	pthread_cond_t		notfull;
+#endif
+
+	batchitem*	items[BATCH_QUEUE_SIZE];
+	int			first;
+	int			count;
+	bool		closed;
+
+	void lock();
+	void unlock();
+	void wait(bool full);
+	void wake(bool full);
+
+public:
+	batchqueue();
+	~batchqueue();
+
+	// blocks while the queue is full
+	void push(batchitem* item);
+
+	// blocks while the queue is empty; NULL if it was closed
+	batchitem* pop();
+
+	void close();
+};
+
+struct batchjob;
+
+typedef void (*stage_func)(batchjob* job, int index);
+
+struct stagethread
+{
+	batchjob*	job;
+	stage_func	func;
+	int			index;
+
+#ifdef _WIN32
+	HANDLE		handle;
+#else
+	pthread_t	handle;
+#endif
+};
+
+struct batchjob
+{
+	std::vector<batchitem*>	items;
+	std::vector<double>		workerbusy;
+
+	batchqueue	computequeue;
+	batchqueue	writequeue;
+	double		readbusy;
+	double		writebusy;
+	int			processed;
+	int			failed;
+};
+
+batchqueue::batchqueue()
+{
+	first	= 0;
+	count	= 0;
+	closed	= false;
+
+#ifdef _WIN32
+	InitializeCriticalSection(&guard);
+	InitializeConditionVariable(&notempty);
+	InitializeConditionVariable(&notfull);
+#else
+	pthread_mutex_init(&guard, NULL);
+	pthread_cond_init(&notempty, NULL);
+	pthread_cond_init(&notfull, NULL);
+#endif
+}
+
+batchqueue::~batchqueue()
+{
+#ifdef _WIN32
+	DeleteCriticalSection(&guard);
+#else
+	pthread_cond_destroy(&notfull);
+	pthread_cond_destroy(&notempty);
+	pthread_mutex_destroy(&guard);
+#endif
+}
+
+void batchqueue::lock()
+{
+#ifdef _WIN32
+	EnterCriticalSection(&guard);
+#else
+	pthread_mutex_lock(&guard);
+#endif
+}
+
+void batchqueue::unlock()
+{
+#ifdef _WIN32
+	LeaveCriticalSection(&guard);
+#else
+	pthread_mutex_unlock(&guard);
+#endif
+}
+
+void batchqueue::wait(bool full)
+{
+#ifdef _WIN32
+	SleepConditionVariableCS((full ? &notfull : &notempty), &guard, INFINITE);
+#else
+	pthread_cond_wait((full ? &notfull : &notempty), &guard);
+#endif
+}
+
+void batchqueue::wake(bool full)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable(full ? &notfull : &notempty);
+#else
+	pthread_cond_broadcast(full ? &notfull : &notempty);
+#endif
+}
+
+void batchqueue::push(batchitem* item)
+{
+	lock();
+	{
+		while( count == BATCH_QUEUE_SIZE )
+			wait(true);
+
+		items[(first + count) % BATCH_QUEUE_SIZE] = item;
+		++count;
+	}
+	unlock();
+
+	wake(false);
+}
+
+batchitem* batchqueue::pop()
+{
+	batchitem* item = NULL;
+
+	lock();
+	{
+		while( count == 0 && !closed )
+			wait(false);
+
+		if( count > 0 )
+		{
+			item = items[first];
+
+			first = (first + 1) % BATCH_QUEUE_SIZE;
+			--count;
+		}
+	}
+	unlock();
+
+	if( item )
+		wake(true);
+
+	return item;
+}
+
+void batchqueue::close()
+{
+	lock();
+	closed = true;
+	unlock();
+
+	wake(false);
+}
+
+static double GetTime()
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, now;
+
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+#ifdef _WIN32
+static unsigned long __stdcall StageProc(void* param)
+#else
+static void* StageProc(void* param)
+#endif
+{
+	stagethread* thread = (stagethread*)param;
+
+	thread->func(thread->job, thread->index);
+	return 0;
+}
+
+static bool StartStage(stagethread& thread, batchjob* job, stage_func func, int index)
+{
+	thread.job		= job;
+	thread.func		= func;
+	thread.index	= index;
+
+#ifdef _WIN32
+	thread.handle = CreateThread(NULL, 0, &StageProc, &thread, 0, NULL);
+	return (thread.handle != NULL);
+#else
+	return (0 == pthread_create(&thread.handle, NULL, &StageProc, &thread));
+#endif
+}
+
+static void JoinStage(stagethread& thread)
+{
+#ifdef _WIN32
+	WaitForSingleObject(thread.handle, INFINITE);
+	CloseHandle(thread.handle);
+#else
+	pthread_join(thread.handle, NULL);
+#endif
+}
+
+static bool EndsWith(const qstring& str, const qstring& what)
+{
+	return (str.length() >= what.length() && 0 == str.compare(str.length() - what.length(), what.length(), what));
+}
+
+static bool IsDirectory(const qstring& path)
+{
+#ifdef _WIN32
+	DWORD attrib = GetFileAttributesA(path.c_str());
+	return (attrib != INVALID_FILE_ATTRIBUTES && (attrib & FILE_ATTRIBUTE_DIRECTORY));
+#else
+	struct stat info;
+	return (0 == stat(path.c_str(), &info) && S_ISDIR(info.st_mode));
+#endif
+}
+
+static void AddItem(batchjob& job, const qstring& name1, const qstring& name2, const qstring& outname)
+{
+	batchitem* item = new batchitem();
+
+	item->name1		= name1;
+	item->name2		= name2;
+	item->outname	= outname;
+	item->valid		= false;
+
+	job.items.push_back(item);
+}
+
+static bool ListDirectory(batchjob& job, const qstring& dir, const qstring& outdir)
+{
+	std::vector<qstring> names;
+
+#ifdef _WIN32
+	WIN32_FIND_DATAA data;
+	HANDLE h = FindFirstFileA((dir + "\\*_1.bmp").c_str(), &data);
+
+	// no pairs at all isn't an error
+	if( h == INVALID_HANDLE_VALUE )
+		return (GetLastError() == ERROR_FILE_NOT_FOUND);
+
+	do
+	{
+		if( !(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) )
+			names.push_back(data.cFileName);
+	}
+	while( FindNextFileA(h, &data) );
+
+	FindClose(h);
+#else
+	DIR* d = opendir(dir.c_str());
+	dirent* entry;
+
+	if( !d )
+		return false;
+
+	while( (entry = readdir(d)) != NULL )
+	{
+		if( EndsWith(entry->d_name, "_1.bmp") )
+			names.push_back(entry->d_name);
+	}
+
+	closedir(d);
+#endif
+
+	std::sort(names.begin(), names.end());
+
+	for( size_t i = 0; i < names.size(); ++i )
+	{
+		qstring base = names[i].substr(0, names[i].length() - 6);
+		AddItem(job, dir + "/" + base + "_1.bmp", dir + "/" + base + "_2.bmp", outdir + "/" + base + ".tga");
+	}
+
+	return true;
+}
+
+static bool ReadManifest(batchjob& job, const qstring& file)
+{
+	char	line[1024];
+	char	name1[340], name2[340], outname[340];
+	FILE*	infile = fopen(file.c_str(), "rb");
+
+	if( !infile )
+		return false;
+
+	while( fgets(line, sizeof(line), infile) )
+	{
+		if( line[0] == '#' )
+			continue;
+
+		if( 3 == sscanf(line, "%339s %339s %339s", name1, name2, outname) )
+			AddItem(job, name1, name2, outname);
+	}
+
+	fclose(infile);
+	return true;
+}
+
+static void Prefault(const imageview& img)
+{
+	const quint8* data = img.row(0);
+	size_t size = img.stride * img.height;
+	volatile quint8 sum = 0;
+
+	// the mapping is lazy, the page faults should happen here and not in the workers
+	for( size_t i = 0; i < size; i += PAGE_SIZE_HINT )
+		sum += data[i];
+
+	sum += data[size - 1];
+}
+
+static void ReadStage(batchjob* job, int)
+{
+	for( size_t i = 0; i < job->items.size(); ++i )
+	{
+		batchitem* item = job->items[i];
+		double start = GetTime();
+
+		if( MapBMP(item->file1, item->img1, item->name1) &&
+			MapBMP(item->file2, item->img2, item->name2) )
+		{
+			const imageview& img1 = item->img1;
+			const imageview& img2 = item->img2;
+
+			item->valid = (
+				img1.bytes == 3 && img2.bytes == 3 &&
+				img1.width == img2.width && img1.height == img2.height &&
+				img1.topdown == img2.topdown);
+
+			if( item->valid )
+				item->valid = CreateTGA(item->outfile, item->out, item->outname, img1.width, img1.height, 4, img1.topdown);
+
+			if( item->valid )
+			{
+				Prefault(img1);
+				Prefault(img2);
+			}
+		}
+
+		job->readbusy += GetTime() - start;
+		job->computequeue.push(item);
+	}
+
+	job->computequeue.close();
+}
+
+static void ComputeStage(batchjob* job, int index)
+{
+	batchitem* item;
+
+	while( (item = job->computequeue.pop()) != NULL )
+	{
+		double start = GetTime();
+
+		if( item->valid )
+			RemoveBackground(item->out, item->img1, item->img2);
+
+		job->workerbusy[index] += GetTime() - start;
+		job->writequeue.push(item);
+	}
+}
+
+static void WriteStage(batchjob* job, int)
+{
+	batchitem* item;
+
+	while( (item = job->writequeue.pop()) != NULL )
+	{
+		double start = GetTime();
+
+		if( item->valid )
+			++job->processed;
+		else
+			++job->failed;
+
+		// unmapping hands the pages of the result over to the file system
+		item->outfile.close();
+		item->file1.close();
+		item->file2.close();
+
+		job->writebusy += GetTime() - start;
+	}
+}
+
+bool RemoveBackgroundBatch(const qstring& source, const qstring& outdir, int numworkers, batchstats& stats)
+{
+	batchjob					job;
+	stagethread					reader, writer;
+	std::vector<stagethread>	workers;
+	double						start;
+	bool						success = false;
+	int							started = 0;
+
+	memset(&stats, 0, sizeof(batchstats));
+
+	job.readbusy	= 0;
+	job.writebusy	= 0;
+	job.processed	= 0;
+	job.failed		= 0;
+
+	if( IsDirectory(source) )
+		success = ListDirectory(job, source, outdir);
+	else
+		success = ReadManifest(job, source);
+
+	if( !success )
+		goto _cleanup;
+
+	numworkers = std::max(numworkers, 1);
+
+	workers.resize(numworkers);
+	job.workerbusy.resize(numworkers, 0.0);
+
+	start = GetTime();
+	success = StartStage(writer, &job, &WriteStage, 0);
+
+	if( !success )
+		goto _cleanup;
+
+	for( ; started < numworkers; ++started )
+	{
+		if( !StartStage(workers[started], &job, &ComputeStage, started) )
+			break;
+	}
+
+	success = (started > 0);
+
+	if( success )
+	{
+		// if there's no reader thread the caller reads
+		if( StartStage(reader, &job, &ReadStage, 0) )
+			JoinStage(reader);
+		else
+			ReadStage(&job, 0);
+	}
+
+	// the compute queue is closed by the reader
+	for( int i = 0; i < started; ++i )
+		JoinStage(workers[i]);
+
+	job.writequeue.close();
+	JoinStage(writer);
+
+	stats.processed	= job.processed;
+	stats.failed	= job.failed;
+	stats.seconds	= GetTime() - start;
+	stats.busy[StageRead]	= job.readbusy;
+	stats.busy[StageWrite]	= job.writebusy;
+
+	for( int i = 0; i < started; ++i )
+		stats.busy[StageCompute] += job.workerbusy[i];
+
+_cleanup:
+	for( size_t i = 0; i < job.items.size(); ++i )
+		delete job.items[i];
+
+	return success;
+}
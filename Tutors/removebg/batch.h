@@ -0,0 +1,26 @@
+
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+#include "removebg.h"
+
+// number of images waiting between two stages
+#define BATCH_QUEUE_SIZE	8
+
+struct batchstats
+{
+	int		processed;
+	int		failed;
+	double	seconds;	// wall time of the whole batch
+	double	busy[3];	// time spent in the reader, the workers (summed) and the writer
+};
+
+/**
+ * Runs a reader thread (maps the inputs), numworkers compute threads and a writer thread
+ * (unmaps the results) connected by bounded queues. The source is either a manifest with
+ * one "in1.bmp in2.bmp out.tga" line per image or a directory with name_1.bmp/name_2.bmp
+ * pairs, which are written to outdir/name.tga.
+ */
+bool RemoveBackgroundBatch(const qstring& source, const qstring& outdir, int numworkers, batchstats& stats);
+
+#endif
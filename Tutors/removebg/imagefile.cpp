@@ -0,0 +1,334 @@
+
+#include <cstring>
+#include <cstdlib>
+
+#include "imagefile.h"
+
+#ifndef _WIN32
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+mappedfile::mappedfile()
+{
+#ifdef _WIN32
+	file	= INVALID_HANDLE_VALUE;
+	mapping	= NULL;
+#else
+	file	= -1;
+#endif
+
+	data	= 0;
+	length	= 0;
+}
+
+mappedfile::~mappedfile()
+{
+	close();
+}
+
+bool mappedfile::open(const qstring& name)
+{
+	close();
+
+#ifdef _WIN32
+	LARGE_INTEGER filesize;
+
+	file = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+	if( file == INVALID_HANDLE_VALUE )
+		return false;
+
+	if( !GetFileSizeEx(file, &filesize) || filesize.QuadPart == 0 )
+		goto _fail;
+
+	length = (size_t)filesize.QuadPart;
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if( !mapping )
+		goto _fail;
+
+	data = (quint8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	struct stat info;
+	void* ptr;
+
+	file = ::open(name.c_str(), O_RDONLY);
+
+	if( file == -1 )
+		return false;
+
+	if( 0 != fstat(file, &info) || info.st_size == 0 )
+		goto _fail;
+
+	length = (size_t)info.st_size;
+	ptr = mmap(NULL, length, PROT_READ, MAP_PRIVATE, file, 0);
+
+	if( ptr == MAP_FAILED )
+		goto _fail;
+
+	// the images are read front to back
+	madvise(ptr, length, MADV_SEQUENTIAL);
+	data = (quint8*)ptr;
+#endif
+
+	if( data )
+		return true;
+
+_fail:
+	close();
+	return false;
+}
+
+bool mappedfile::create(const qstring& name, size_t size)
+{
+	close();
+
+	if( size == 0 )
+		return false;
+
+#ifdef _WIN32
+	ULARGE_INTEGER filesize;
+
+	file = CreateFileA(name.c_str(), GENERIC_READ|GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL);
+
+	if( file == INVALID_HANDLE_VALUE )
+		return false;
+
+	// the mapping grows the file to its final size
+	filesize.QuadPart = size;
+	mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, filesize.HighPart, filesize.LowPart, NULL);
+
+	if( !mapping )
+		goto _fail;
+
+	data = (quint8*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+#else
+	void* ptr;
+
+	file = ::open(name.c_str(), O_RDWR|O_CREAT|O_TRUNC, 0644);
+
+	if( file == -1 )
+		return false;
+
+	if( 0 != ftruncate(file, (off_t)size) )
+		goto _fail;
+
+	ptr = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, file, 0);
+
+	if( ptr == MAP_FAILED )
+		goto _fail;
+
+	data = (quint8*)ptr;
+#endif
+
+	length = size;
+
+	if( data )
+		return true;
+
+_fail:
+	close();
+	return false;
+}
+
+void mappedfile::close()
+{
+#ifdef _WIN32
+	if( data )
+		UnmapViewOfFile(data);
+
+	if( mapping )
+		CloseHandle(mapping);
+
+	if( file != INVALID_HANDLE_VALUE )
+		CloseHandle(file);
+
+	file	= INVALID_HANDLE_VALUE;
+	mapping	= NULL;
+#else
+	if( data )
+		munmap(data, length);
+
+	if( file != -1 )
+		::close(file);
+
+	file	= -1;
+#endif
+
+	data	= 0;
+	length	= 0;
+}
+
+bool MapBMP(mappedfile& file, imageview& view, const qstring& name)
+{
+	if( !file.open(name) )
+		return false;
+
+	const quint8* fh = file.pointer();
+	const quint8* ih = fh + FILE_HEADER_SIZE;
+
+	if( file.size() < FILE_HEADER_SIZE + INFO_HEADER_SIZE )
+		goto _fail;
+
+	if( *((quint16*)fh) != BMP_MAGIC_NUMBER )
+		goto _fail;
+
+	{
+		quint32 imageoffset	= *((quint32*)(fh + 10));
+		int width			= *((int*)(ih + 4));
+		int height			= *((int*)(ih + 8));
+		quint16 bitcount	= *((quint16*)(ih + 14));
+		quint32 compression	= *((quint32*)(ih + 16));
+
+		if( (bitcount != 24 && bitcount != 32) || compression != 0 )
+			goto _fail;
+
+		view.width		= width;
+		view.height		= abs(height);
+		view.bytes		= bitcount / 8;
+		view.topdown	= (height < 0);
+		view.stride		= (((size_t)width * view.bytes + 3) / 4) * 4;
+
+		if( width <= 0 || height == 0 )
+			goto _fail;
+
+		if( imageoffset > file.size() || (file.size() - imageoffset) / view.stride < (size_t)view.height )
+			goto _fail;
+
+		view.data = file.pointer() + imageoffset;
+	}
+
+	return true;
+
+_fail:
+	file.close();
+	return false;
+}
+
+bool CreateBMP(mappedfile& file, imageview& view, const qstring& name, int width, int height, bool topdown)
+{
+	size_t stride = (((size_t)width * 3 + 3) / 4) * 4;
+	size_t imageoffset = FILE_HEADER_SIZE + INFO_HEADER_SIZE;
+	size_t filesize = imageoffset + stride * height;
+
+	if( width <= 0 || height <= 0 || filesize > 0xffffffffu )
+		return false;
+
+	if( !file.create(name, filesize) )
+		return false;
+
+	quint8* fh = file.pointer();
+	quint8* ih = fh + FILE_HEADER_SIZE;
+
+	// the mapping is zero filled, so is the padding
+	*((quint16*)fh)			= BMP_MAGIC_NUMBER;
+	*((quint32*)(fh + 2))	= (quint32)filesize;
+	*((quint32*)(fh + 10))	= (quint32)imageoffset;
+
+	*((quint32*)(ih))		= INFO_HEADER_SIZE;
+	*((int*)(ih + 4))		= width;
+	*((int*)(ih + 8))		= (topdown ? -height : height);
+	*((quint16*)(ih + 12))	= 1;
+	*((quint16*)(ih + 14))	= 24;
+	*((quint32*)(ih + 16))	= 0;
+	*((quint32*)(ih + 20))	= (quint32)(stride * height);
+
+	view.data		= fh + imageoffset;
+	view.stride		= stride;
+	view.width		= width;
+	view.height		= height;
+	view.bytes		= 3;
+	view.topdown	= topdown;
+
+	return true;
+}
+
+bool CreateTGA(mappedfile& file, imageview& view, const qstring& name, int width, int height, int bytes, bool topdown)
+{
+	// the format can't store larger images
+	if( width <= 0 || height <= 0 || width > 0xffff || height > 0xffff )
+		return false;
+
+	if( bytes != 3 && bytes != 4 )
+		return false;
+
+	if( !file.create(name, TGA_HEADER_SIZE + (size_t)width * height * bytes) )
+		return false;
+
+	quint8* header = file.pointer();
+
+	header[2] = 2; // type
+
+	*((quint16*)(&header[12])) = (quint16)width;
+	*((quint16*)(&header[14])) = (quint16)height;
+
+	header[16] = bytes * 8;
+	header[17] = (topdown ? 0x20 : 0);
+
+	view.data		= header + TGA_HEADER_SIZE;
+	view.stride		= (size_t)width * bytes;
+	view.width		= width;
+	view.height		= height;
+	view.bytes		= bytes;
+	view.topdown	= topdown;
+
+	return true;
+}
+
+void CopyPixels(const imageview& dst, const imageview& src)
+{
+	if( dst.bytes == src.bytes )
+	{
+		if( dst.contiguous() && src.contiguous() )
+		{
+			memcpy(dst.data, src.data, dst.stride * dst.height);
+			return;
+		}
+
+		for( int i = 0; i < dst.height; ++i )
+			memcpy(dst.row(i), src.row(i), (size_t)dst.width * dst.bytes);
+
+		return;
+	}
+
+	for( int i = 0; i < dst.height; ++i )
+	{
+		quint8* out = dst.row(i);
+		const quint8* in = src.row(i);
+
+		if( dst.bytes == 3 )
+		{
+			for( int j = 0; j < dst.width; ++j, out += 3, in += 4 )
+			{
+				out[0] = in[0];
+				out[1] = in[1];
+				out[2] = in[2];
+			}
+		}
+		else
+		{
+			for( int j = 0; j < dst.width; ++j, out += 4, in += 3 )
+			{
+				out[0] = in[0];
+				out[1] = in[1];
+				out[2] = in[2];
+				out[3] = 255;
+			}
+		}
+	}
+}
+
+void RemoveBackground(const imageview& out, const imageview& in1, const imageview& in2)
+{
+	if( out.contiguous() && in1.contiguous() && in2.contiguous() )
+	{
+		RemoveBackground(out.data, in1.data, in2.data, (size_t)out.width * out.height);
+		return;
+	}
+
+	for( int i = 0; i < out.height; ++i )
+		RemoveBackground(out.row(i), in1.row(i), in2.row(i), out.width);
+}
@@ -0,0 +1,86 @@
+
+#ifndef _IMAGEFILE_H_
+#define _IMAGEFILE_H_
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <Windows.h>
+#endif
+
+#include "removebg.h"
+
+class mappedfile
+{
+private:
+#ifdef _WIN32
+	HANDLE	file;
+	HANDLE	mapping;
+#else
+	int		file;
+#endif
+
+	quint8*	data;
+	size_t	length;
+
+	mappedfile(const mappedfile&);
+	mappedfile& operator =(const mappedfile&);
+
+public:
+	mappedfile();
+	~mappedfile();
+
+	// maps an existing file read only
+	bool open(const qstring& name);
+
+	// creates (or truncates) the file with the given size and maps it for writing
+	bool create(const qstring& name, size_t size);
+
+	void close();
+
+	inline quint8* pointer() const {
+		return data;
+	}
+
+	inline size_t size() const {
+		return length;
+	}
+};
+
+// rows of an image in file order; points into a mapping, nothing is copied
+struct imageview
+{
+	quint8*	data;		// first row
+	size_t	stride;		// distance of two rows in bytes (with padding)
+	int		width;
+	int		height;
+	int		bytes;		// per pixel
+	bool	topdown;	// first row is the top of the image
+
+	inline quint8* row(int i) const {
+		return data + i * stride;
+	}
+
+	inline bool contiguous() const {
+		return (stride == (size_t)width * bytes);
+	}
+};
+
+// uncompressed 24 or 32 bit BMP; the view stays valid while the file is mapped
+bool MapBMP(mappedfile& file, imageview& view, const qstring& name);
+
+// preallocated 24 bit BMP / 24 or 32 bit TGA, the pixels are to be written through the view
+bool CreateBMP(mappedfile& file, imageview& view, const qstring& name, int width, int height, bool topdown);
+bool CreateTGA(mappedfile& file, imageview& view, const qstring& name, int width, int height, int bytes, bool topdown);
+
+// converts between 24 and 32 bit if needed (alpha is set to 255); same size and orientation
+void CopyPixels(const imageview& dst, const imageview& src);
+
+// runs the kernel on the whole image at once if there is no padding
+void RemoveBackground(const imageview& out, const imageview& in1, const imageview& in2);
+
+#endif
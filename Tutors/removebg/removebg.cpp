@@ -0,0 +1,373 @@
+
+#include <algorithm>
+#include "removebg.h"
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#	define REMOVEBG_AVX2
+#elif defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64)))
+#	include <smmintrin.h>
+#	define REMOVEBG_SSE41
+#	if !defined(__SSE4_1__) && !defined(__AVX__)
+// MSVC compiles SSE4.1 for any target, so the CPU has to be checked
+#		include <intrin.h>
+#		define REMOVEBG_SSE41_CPUID
+#	endif
+#endif
+
+/*
+	For a pixel that differs in the two images the original code computes
+
+		a = max(r2, g2, b2) / 255.0
+		r = (quint8)(r2 / a), ...
+
+	(the branches on c1 and c2 reduce to this). Instead of the division
+	the kernels multiply by recip[m] = ceil(255 * 2^16 / m), which gives
+	floor(v * 255 / m) exactly for v <= m <= 255.
+
+	The double division comes out one less at some points, where
+	v * 255 / m is an integer. The quotient is a multiple of 17 there, so
+	bit q / 17 of fixmask[m] tells whether to decrement it. Both tables are
+	built from the reference formula at startup.
+*/
+
+static quint32 recip[256];
+static quint32 fixmask[256];
+
+static inline quint8 ReferenceQuotient(quint8 v, quint8 m)
+{
+	double a = (255.0 - (255 - m)) / 255.0;
+	return (quint8)std::min<double>(v / a, 255.0);
+}
+
+static inline quint32 Quotient(quint32 v, quint32 m)
+{
+	quint32 q = (v * recip[m]) >> 16;
+
+	if( q * m == v * 255 )
+		q -= (fixmask[m] >> ((q * 3856) >> 16)) & 1;
+
+	return q;
+}
+
+static struct TableInitializer
+{
+	TableInitializer()
+	{
+		recip[0] = 0;
+		fixmask[0] = 0;
+
+		for( quint32 m = 1; m < 256; ++m )
+		{
+			recip[m] = (255 * 65536 + m - 1) / m;
+			fixmask[m] = 0;
+
+			for( quint32 v = 1; v <= m; ++v )
+			{
+				quint32 q = (v * recip[m]) >> 16;
+
+				if( ReferenceQuotient((quint8)v, (quint8)m) != q )
+					fixmask[m] |= (1 << (q / 17));
+			}
+		}
+	}
+} tableinitializer;
+
+static inline void RemoveBackgroundScalar(quint8* out, const quint8* in1, const quint8* in2, size_t count)
+{
+	for( size_t i = 0; i < count; ++i )
+	{
+		const quint8* p1 = in1 + i * 3;
+		const quint8* p2 = in2 + i * 3;
+		quint8* q = out + i * 4;
+
+		if( p1[0] == p2[0] && p1[1] == p2[1] && p1[2] == p2[2] )
+		{
+			q[0] = p1[0];
+			q[1] = p1[1];
+			q[2] = p1[2];
+			q[3] = 255;
+		}
+		else
+		{
+			quint32 m = std::max(p2[0], std::max(p2[1], p2[2]));
+
+			q[0] = (quint8)Quotient(p2[0], m);
+			q[1] = (quint8)Quotient(p2[1], m);
+			q[2] = (quint8)Quotient(p2[2], m);
+			q[3] = (quint8)m;
+		}
+	}
+}
+
+#if defined(REMOVEBG_SSE41)
+
+#ifdef REMOVEBG_SSE41_CPUID
+static bool HasSSE41()
+{
+	int info[4];
+
+	__cpuid(info, 1);
+	return ((info[2] & (1 << 19)) != 0);
+}
+
+static const bool hassse41 = HasSSE41();
+#endif
+
+static inline __m128i Quotient4(__m128i v, __m128i m, __m128i rcp, __m128i fix)
+{
+	const __m128i exponent = _mm_set1_epi32(127);
+	const __m128i div17 = _mm_set1_epi32(3856);
+
+	__m128i q = _mm_srli_epi32(_mm_mullo_epi32(v, rcp), 16);
+	__m128i exact = _mm_cmpeq_epi32(_mm_mullo_epi32(q, m), _mm_sub_epi32(_mm_slli_epi32(v, 8), v));
+
+	// 1 << (q / 17) through the exponent of a float
+	__m128i k = _mm_srli_epi32(_mm_mullo_epi32(q, div17), 16);
+	__m128i bit = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(k, exponent), 23)));
+	__m128i notset = _mm_cmpeq_epi32(_mm_and_si128(fix, bit), _mm_setzero_si128());
+
+	// -1 where exact and set
+	return _mm_add_epi32(q, _mm_andnot_si128(notset, exact));
+}
+
+static inline __m128i RemoveBackground4(__m128i p1, __m128i p2)
+{
+	const __m128i mask = _mm_set1_epi32(0xff);
+	const __m128i opaque = _mm_set1_epi32(0xff000000);
+
+	__m128i same = _mm_cmpeq_epi32(p1, p2);
+	__m128i r = _mm_and_si128(p2, mask);
+	__m128i g = _mm_and_si128(_mm_srli_epi32(p2, 8), mask);
+	__m128i b = _mm_srli_epi32(p2, 16);
+	__m128i m = _mm_max_epi32(r, _mm_max_epi32(g, b));
+
+	// no gather before AVX2
+	int m0 = _mm_cvtsi128_si32(m);
+	int m1 = _mm_extract_epi32(m, 1);
+	int m2 = _mm_extract_epi32(m, 2);
+	int m3 = _mm_extract_epi32(m, 3);
+
+	__m128i rcp = _mm_setr_epi32(recip[m0], recip[m1], recip[m2], recip[m3]);
+	__m128i fix = _mm_setr_epi32(fixmask[m0], fixmask[m1], fixmask[m2], fixmask[m3]);
+
+	__m128i res = Quotient4(r, m, rcp, fix);
+
+	res = _mm_or_si128(res, _mm_slli_epi32(Quotient4(g, m, rcp, fix), 8));
+	res = _mm_or_si128(res, _mm_slli_epi32(Quotient4(b, m, rcp, fix), 16));
+	res = _mm_or_si128(res, _mm_slli_epi32(m, 24));
+
+	return _mm_blendv_epi8(res, _mm_or_si128(p1, opaque), same);
+}
+
+void RemoveBackground(quint8* out, const quint8* in1, const quint8* in2, size_t count)
+{
+	// 8 pixels are exactly 24 bytes
+	const __m128i expand = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	size_t i = 0;
+
+#ifdef REMOVEBG_SSE41_CPUID
+	if( !hassse41 )
+	{
+		RemoveBackgroundScalar(out, in1, in2, count);
+		return;
+	}
+#endif
+
+	for( ; i + 8 <= count; i += 8 )
+	{
+		const quint8* p1 = in1 + i * 3;
+		const quint8* p2 = in2 + i * 3;
+
+		__m128i lo1 = _mm_loadu_si128((const __m128i*)p1);
+		__m128i lo2 = _mm_loadu_si128((const __m128i*)p2);
+		__m128i hi1 = _mm_loadl_epi64((const __m128i*)(p1 + 16));
+		__m128i hi2 = _mm_loadl_epi64((const __m128i*)(p2 + 16));
+
+		__m128i a1 = _mm_shuffle_epi8(lo1, expand);
+		__m128i a2 = _mm_shuffle_epi8(lo2, expand);
+		__m128i b1 = _mm_shuffle_epi8(_mm_alignr_epi8(hi1, lo1, 12), expand);
+		__m128i b2 = _mm_shuffle_epi8(_mm_alignr_epi8(hi2, lo2, 12), expand);
+
+		_mm_storeu_si128((__m128i*)(out + i * 4), RemoveBackground4(a1, a2));
+		_mm_storeu_si128((__m128i*)(out + i * 4 + 16), RemoveBackground4(b1, b2));
+	}
+
+	RemoveBackgroundScalar(out + i * 4, in1 + i * 3, in2 + i * 3, count - i);
+}
+
+const char* RemoveBackgroundPath()
+{
+#ifdef REMOVEBG_SSE41_CPUID
+	if( !hassse41 )
+		return "scalar";
+#endif
+
+	return "SSE4.1";
+}
+
+#elif defined(REMOVEBG_AVX2)
+
+static inline __m256i Quotient8(__m256i v, __m256i m, __m256i rcp, __m256i fix)
+{
+	const __m256i div17 = _mm256_set1_epi32(3856);
+	const __m256i one = _mm256_set1_epi32(1);
+
+	__m256i q = _mm256_srli_epi32(_mm256_mullo_epi32(v, rcp), 16);
+	__m256i exact = _mm256_cmpeq_epi32(_mm256_mullo_epi32(q, m), _mm256_sub_epi32(_mm256_slli_epi32(v, 8), v));
+	__m256i k = _mm256_srli_epi32(_mm256_mullo_epi32(q, div17), 16);
+	__m256i set = _mm256_and_si256(_mm256_srlv_epi32(fix, k), one);
+
+	return _mm256_sub_epi32(q, _mm256_and_si256(exact, set));
+}
+
+static inline __m256i RemoveBackground8(__m256i p1, __m256i p2)
+{
+	const __m256i mask = _mm256_set1_epi32(0xff);
+	const __m256i opaque = _mm256_set1_epi32(0xff000000);
+
+	__m256i same = _mm256_cmpeq_epi32(p1, p2);
+	__m256i r = _mm256_and_si256(p2, mask);
+	__m256i g = _mm256_and_si256(_mm256_srli_epi32(p2, 8), mask);
+	__m256i b = _mm256_srli_epi32(p2, 16);
+	__m256i m = _mm256_max_epi32(r, _mm256_max_epi32(g, b));
+
+	__m256i rcp = _mm256_i32gather_epi32((const int*)recip, m, 4);
+	__m256i fix = _mm256_i32gather_epi32((const int*)fixmask, m, 4);
+
+	__m256i res = Quotient8(r, m, rcp, fix);
+
+	res = _mm256_or_si256(res, _mm256_slli_epi32(Quotient8(g, m, rcp, fix), 8));
+	res = _mm256_or_si256(res, _mm256_slli_epi32(Quotient8(b, m, rcp, fix), 16));
+	res = _mm256_or_si256(res, _mm256_slli_epi32(m, 24));
+
+	return _mm256_blendv_epi8(res, _mm256_or_si256(p1, opaque), same);
+}
+
+static inline __m256i Load8(const quint8* p)
+{
+	// reads 28 bytes
+	const __m256i expand = _mm256_setr_epi8(
+		0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+		0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+
+	__m256i v = _mm256_inserti128_si256(
+		_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)p)),
+		_mm_loadu_si128((const __m128i*)(p + 12)), 1);
+
+	return _mm256_shuffle_epi8(v, expand);
+}
+
+void RemoveBackground(quint8* out, const quint8* in1, const quint8* in2, size_t count)
+{
+	size_t i = 0;
+
+	// 16 pixels are 48 bytes, but the second load reads 4 more
+	for( ; i + 18 <= count; i += 16 )
+	{
+		const quint8* p1 = in1 + i * 3;
+		const quint8* p2 = in2 + i * 3;
+
+		__m256i a = RemoveBackground8(Load8(p1), Load8(p2));
+		__m256i b = RemoveBackground8(Load8(p1 + 24), Load8(p2 + 24));
+
+		_mm256_storeu_si256((__m256i*)(out + i * 4), a);
+		_mm256_storeu_si256((__m256i*)(out + i * 4 + 32), b);
+	}
+
+	RemoveBackgroundScalar(out + i * 4, in1 + i * 3, in2 + i * 3, count - i);
+}
+
+const char* RemoveBackgroundPath()
+{
+	return "AVX2";
+}
+
+#else
+
+void RemoveBackground(quint8* out, const quint8* in1, const quint8* in2, size_t count)
+{
+	RemoveBackgroundScalar(out, in1, in2, count);
+}
+
+const char* RemoveBackgroundPath()
+{
+	return "scalar";
+}
+
+#endif
+
+void RemoveBackgroundReference(quint8* out, const quint8* in1, const quint8* in2, size_t count)
+{
+	quint8 r, g, b;
+	double a, x, y, z;
+	quint8 r1, g1, b1;
+	quint8 r2, g2, b2;
+	quint8 c1, c2;
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		r1 = in1[i * 3 + 0];
+		g1 = in1[i * 3 + 1];
+		b1 = in1[i * 3 + 2];
+
+		r2 = in2[i * 3 + 0];
+		g2 = in2[i * 3 + 1];
+		b2 = in2[i * 3 + 2];
+
+		if( r1 == r2 && g1 == g2 && b1 == b2 )
+		{
+			// same -> no alpha
+			a = 1.0;
+			r = r1;
+			g = g1;
+			b = b1;
+		}
+		else
+		{
+			c1 = 255;
+			c2 = 0;
+
+			if( r1 - r2 < 255 )
+				c2 = r2;
+
+			if( g1 - g2 < 255 )
+			{
+				if( g2 > c2 )
+					c2 = g2;
+			}
+
+			if( b1 - b2 < 255 )
+			{
+				if( b2 > c2 )
+					c2 = b2;
+			}
+
+			if( c1 - c2 < 255 )
+			{
+				a = (255.0 - (c1 - c2)) / 255.0;
+
+				x = std::min<double>(r2 / a, 255.0);
+				y = std::min<double>(g2 / a, 255.0);
+				z = std::min<double>(b2 / a, 255.0);
+
+				r = (quint8)x;
+				g = (quint8)y;
+				b = (quint8)z;
+			}
+			else
+			{
+				// background in both
+				a = 0.0;
+				r = 0;
+				g = 0;
+				b = 0;
+			}
+		}
+
+		out[i * 4 + 0] = r;
+		out[i * 4 + 1] = g;
+		out[i * 4 + 2] = b;
+		out[i * 4 + 3] = (quint8)(a * 255.0);
+	}
+}
@@ -0,0 +1,27 @@
+
+#ifndef _REMOVEBG_H_
+#define _REMOVEBG_H_
+
+#include <string>
+
+typedef unsigned int quint32;
+typedef unsigned short quint16;
+typedef unsigned char quint8;
+typedef std::string qstring;
+
+#define BMP_MAGIC_NUMBER	19778
+#define RGB_BYTE_SIZE		3
+#define FILE_HEADER_SIZE	14
+#define INFO_HEADER_SIZE	40
+#define TGA_HEADER_SIZE		18
+
+// the same scene in front of two different backgrounds (24 bit) -> 32 bit image with alpha
+void RemoveBackground(quint8* out, const quint8* in1, const quint8* in2, size_t count);
+
+// the original per pixel implementation with double divisions, the result is the same
+void RemoveBackgroundReference(quint8* out, const quint8* in1, const quint8* in2, size_t count);
+
+// "AVX2", "SSE4.1" or "scalar"
+const char* RemoveBackgroundPath();
+
+#endif
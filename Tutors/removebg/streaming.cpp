@@ -0,0 +1,242 @@
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "streaming.h"
+#include "../myinterpreter/threadpool.h"
+
+// a band is split into this many chunks per thread
+#define CHUNKS_PER_THREAD	4
+
+struct bmpstream
+{
+	FILE*	file;
+	int		width;
+	int		height;
+	size_t	linesize;	// with padding
+	bool	topdown;
+};
+
+struct streamjob
+{
+	bmpstream	in1;
+	bmpstream	in2;
+	FILE*		out;
+
+	// double buffered; band i is processed while i - 1 is written and i + 1 is read
+	quint8*		band1[2];
+	quint8*		band2[2];
+	quint8*		result[2];
+	int			rows[2];
+
+	int			current;
+	int			bandrows;
+	int			rowsread;
+	int			rowsperchunk;
+	bool		failed;
+};
+
+static bool OpenBMP(bmpstream& stream, const qstring& file)
+{
+	quint8 headers[FILE_HEADER_SIZE + INFO_HEADER_SIZE];
+
+	stream.file = fopen(file.c_str(), "rb");
+
+	if( !stream.file )
+		return false;
+
+	if( 1 != fread(headers, sizeof(headers), 1, stream.file) )
+		return false;
+
+	if( *((quint16*)headers) != BMP_MAGIC_NUMBER )
+		return false;
+
+	quint32 imageoffset	= *((quint32*)(headers + 10));
+	int width			= *((int*)(headers + FILE_HEADER_SIZE + 4));
+	int height			= *((int*)(headers + FILE_HEADER_SIZE + 8));
+	quint16 bitcount	= *((quint16*)(headers + FILE_HEADER_SIZE + 14));
+	quint32 compression	= *((quint32*)(headers + FILE_HEADER_SIZE + 16));
+
+	// the kernel reads 24 bit pixels
+	if( bitcount != 24 || compression != 0 )
+		return false;
+
+	if( width <= 0 || height == 0 )
+		return false;
+
+	stream.width	= width;
+	stream.height	= abs(height);
+	stream.topdown	= (height < 0);
+	stream.linesize	= (((size_t)width * 3 + 3) / 4) * 4;
+
+	// same as in MapBMP
+	if( 0 != fseek(stream.file, 0, SEEK_END) )
+		return false;
+
+	long filesize = ftell(stream.file);
+
+	if( filesize < 0 || imageoffset > (size_t)filesize || ((size_t)filesize - imageoffset) / stream.linesize < (size_t)stream.height )
+		return false;
+
+	return (0 == fseek(stream.file, imageoffset, SEEK_SET));
+}
+
+static void CloseBMP(bmpstream& stream)
+{
+	if( stream.file )
+		fclose(stream.file);
+
+	stream.file = 0;
+}
+
+static bool WriteTGAHeader(FILE* file, int width, int height, bool topdown)
+{
+	quint8 header[TGA_HEADER_SIZE];
+
+	// the format can't store larger images
+	if( width > 0xffff || height > 0xffff )
+		return false;
+
+	memset(header, 0, TGA_HEADER_SIZE);
+
+	header[2] = 2; // type
+
+	*((quint16*)(&header[12])) = (quint16)width;
+	*((quint16*)(&header[14])) = (quint16)height;
+
+	header[16] = 32;
+	header[17] = (topdown ? 0x20 : 0);
+
+	return (1 == fwrite(header, TGA_HEADER_SIZE, 1, file));
+}
+
+static int ReadBand(streamjob* job, int index)
+{
+	int count = std::min(job->bandrows, job->in1.height - job->rowsread);
+
+	if( count > 0 )
+	{
+		size_t size = job->in1.linesize * count;
+
+		if( 1 != fread(job->band1[index], size, 1, job->in1.file) ||
+			1 != fread(job->band2[index], size, 1, job->in2.file) )
+		{
+			job->failed = true;
+			return 0;
+		}
+
+		job->rowsread += count;
+	}
+
+	return count;
+}
+
+static void WriteBand(streamjob* job, int index)
+{
+	if( job->rows[index] > 0 )
+	{
+		size_t size = (size_t)job->in1.width * 4 * job->rows[index];
+
+		if( 1 != fwrite(job->result[index], size, 1, job->out) )
+			job->failed = true;
+	}
+}
+
+static void StreamTask(void* arg, int chunk, int)
+{
+	streamjob* job = (streamjob*)arg;
+	int cur = job->current;
+	int other = 1 - cur;
+
+	if( chunk == 0 )
+	{
+		// I/O of the neighbouring bands overlaps with processing
+		WriteBand(job, other);
+		job->rows[other] = ReadBand(job, other);
+
+		return;
+	}
+
+	int first = (chunk - 1) * job->rowsperchunk;
+	int last = std::min(first + job->rowsperchunk, job->rows[cur]);
+	size_t outstride = (size_t)job->in1.width * 4;
+
+	for( int i = first; i < last; ++i )
+	{
+		RemoveBackground(
+			job->result[cur] + i * outstride,
+			job->band1[cur] + i * job->in1.linesize,
+			job->band2[cur] + i * job->in1.linesize,
+			job->in1.width);
+	}
+}
+
+bool RemoveBackgroundStreaming(const qstring& file1, const qstring& file2, const qstring& outfile, threadpool& pool, size_t bandsize)
+{
+	streamjob job;
+	bool success = false;
+
+	memset(&job, 0, sizeof(streamjob));
+
+	if( !OpenBMP(job.in1, file1) || !OpenBMP(job.in2, file2) )
+		goto _cleanup;
+
+	if( job.in1.width != job.in2.width || job.in1.height != job.in2.height || job.in1.topdown != job.in2.topdown )
+		goto _cleanup;
+
+	job.out = fopen(outfile.c_str(), "wb");
+
+	if( !job.out )
+		goto _cleanup;
+
+	if( !WriteTGAHeader(job.out, job.in1.width, job.in1.height, job.in1.topdown) )
+		goto _cleanup;
+
+	job.bandrows = (int)std::max<size_t>(1, bandsize / job.in1.linesize);
+	job.bandrows = std::min(job.bandrows, std::max(job.in1.height, 1));
+	job.rowsperchunk = std::max(1, job.bandrows / (CHUNKS_PER_THREAD * (pool.size() + 1)));
+
+	for( int i = 0; i < 2; ++i )
+	{
+		job.band1[i] = (quint8*)malloc(job.in1.linesize * job.bandrows);
+		job.band2[i] = (quint8*)malloc(job.in1.linesize * job.bandrows);
+		job.result[i] = (quint8*)malloc((size_t)job.in1.width * 4 * job.bandrows);
+
+		if( !job.band1[i] || !job.band2[i] || !job.result[i] )
+			goto _cleanup;
+	}
+
+	job.current = 0;
+	job.rows[0] = ReadBand(&job, 0);
+	job.rows[1] = 0;
+
+	while( job.rows[job.current] > 0 && !job.failed )
+	{
+		int numchunks = (job.rows[job.current] + job.rowsperchunk - 1) / job.rowsperchunk;
+
+		pool.run(&StreamTask, &job, numchunks + 1);
+		job.current = 1 - job.current;
+	}
+
+	// the last band is still in the other buffer
+	WriteBand(&job, 1 - job.current);
+	success = !job.failed;
+
+_cleanup:
+	for( int i = 0; i < 2; ++i )
+	{
+		free(job.band1[i]);
+		free(job.band2[i]);
+		free(job.result[i]);
+	}
+
+	if( job.out )
+		fclose(job.out);
+
+	CloseBMP(job.in1);
+	CloseBMP(job.in2);
+
+	return success;
+}
@@ -0,0 +1,18 @@
+
+#ifndef _STREAMING_H_
+#define _STREAMING_H_
+
+#include "removebg.h"
+
+class threadpool;
+
+// size of one input band in bytes (6 buffers are in memory at once: 2 x 2 input bands and 2 output bands, 4/3 as large)
+#define STREAM_BAND_SIZE	(4 * 1024 * 1024)
+
+/**
+ * Reads the two (24 bit) BMP files band by band, processes the bands on the pool
+ * and writes the result as a 32 bit TGA. Memory use doesn't depend on the image size.
+ */
+bool RemoveBackgroundStreaming(const qstring& file1, const qstring& file2, const qstring& outfile, threadpool& pool, size_t bandsize = STREAM_BAND_SIZE);
+
+#endif
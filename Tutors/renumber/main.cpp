@@ -1,7 +1,17 @@
 
 #include <iostream>
 #include <string>
-#include <Windows.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "renumber.h"
+#include "../myinterpreter/threadpool.h"
+
+#ifdef _WIN32
+#	include <Windows.h>
+#else
+#	include <time.h>
+#endif
 
 static void Replace(std::string& buff, const std::string& what, const std::string& with)
 {
@@ -17,164 +27,69 @@ static void Replace(std::string& buff, const std::string& what, const std::strin
 	buff = tmp;
 }
 
-static bool RenameFile(const std::string& oldname, const std::string& newname, const std::string& path)
+static double GetTime()
 {
-	std::string	newpath(path);
-	std::string	name;
-	size_t		pos, end;
-	size_t		start = path.find_last_of("\\/");
-
-	if( start != std::string::npos )
-		++start;
-	else
-		start = 0;
-
-	name = path.substr(start);
+#ifdef _WIN32
+	LARGE_INTEGER freq, now;
 
-	end = name.find_last_of(".");
-	name = name.substr(0, end);
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
 
-	pos = name.find(oldname);
-
-	if( pos != std::string::npos )
-	{
-		name.replace(pos, oldname.length(), newname);
-		newpath.replace(start, end, name);
-
-		MoveFileA(path.c_str(), newpath.c_str());
-	}
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	timespec now;
 
-	return (pos != std::string::npos);
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
 }
 
-static bool ReplaceInFile(const std::string& oldname, const std::string& newname, const std::string& file)
+int main(int argc, char* argv[])
 {
-	std::string			buff;
-	size_t				pos = 0;
-	FILE*				fd = 0;
-	bool				found = false;
-
-	fopen_s(&fd, file.c_str(), "rb");
-
-	if( !fd )
-		return false;
-
-	fseek(fd, 0, SEEK_END);
-	size_t length = ftell(fd);
-	fseek(fd, 0, SEEK_SET);
-
-	buff.resize(length);
+	std::vector<std::string>	extensions;
+	std::vector<std::string>	args;
+	multireplace				patterns;
+	renumberstats				stats;
+	int							numthreads = threadpool::numcores();
 
-	fread(&buff[0], 1, length, fd);
-	fclose(fd);
+	extensions.push_back(".vcxproj");
+	extensions.push_back(".filters");
+	extensions.push_back(".sln");
 
-	pos = buff.find(oldname);
-
-	while( pos != std::string::npos )
+	for( int i = 1; i < argc; ++i )
 	{
-		found = true;
-
-		buff.replace(pos, oldname.length(), newname);
-		pos = buff.find(oldname, pos + newname.length());
+		if( 0 == strcmp(argv[i], "-j") && i + 1 < argc )
+			numthreads = atoi(argv[++i]);
+		else if( 0 == strcmp(argv[i], "-e") && i + 1 < argc )
+			extensions.push_back(argv[++i]);
+		else
+			args.push_back(argv[i]);
 	}
-	
-	if( found )
-	{
-		fopen_s(&fd, file.c_str(), "wb");
 
-		if( !fd )
-			return false;
-
-		fwrite(buff.data(), 1, buff.length(), fd);
-		fclose(fd);
-	}
-
-	return found;
-}
-
-void ProcessRecursive(const std::string& oldname, const std::string& newname, const std::string& path)
-{
-	WIN32_FIND_DATAA data;
-	memset(&data, 0, sizeof(data));
-
-	HANDLE h = FindFirstFileA((path + "*.*").c_str(), &data);
-
-	if( h != INVALID_HANDLE_VALUE )
+	if( args.size() < 3 || (args.size() % 2) != 1 )
 	{
-		BOOL success = 1;
-
-		do
-		{
-			std::string str(data.cFileName);
-
-			if( data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY )
-			{
-				if( str != "." && str != ".." )
-				{
-					printf("Entering directory '%s'\n", data.cFileName);
-
-					ProcessRecursive(oldname, newname, path + str + "\\");
-
-					if( RenameFile(oldname, newname, path + data.cFileName) )
-						printf("Renamed '%s'\n", data.cFileName);
-				}
-			}
-			else
-			{
-				size_t p1 = str.rfind(".vcxproj");
-				size_t p2 = str.rfind(".filters");
-				size_t p3 = str.rfind(".sln");
-
-				if( p1 != std::string::npos || p2 != std::string::npos || p3 != std::string::npos )
-				{
-					if( ReplaceInFile(oldname, newname, path + data.cFileName) )
-						printf("Updated '%s'\n", data.cFileName);
-
-					if( RenameFile(oldname, newname, path + data.cFileName) )
-						printf("Renamed '%s'\n", data.cFileName);
-				}
-			}
-
-			success = FindNextFileA(h, &data);
-		}
-		while( success != 0 );
-
-		FindClose(h);
+		std::cout << "Usage: renumber.exe [-j threads] [-e extension] oldname newname [oldname newname ...] directory\n\n";
 	}
 	else
 	{
-		DWORD err = GetLastError();
-		LPVOID lpMsgBuf = 0;
+		std::string folder(args.back());
 
-		FormatMessageA(
-			FORMAT_MESSAGE_ALLOCATE_BUFFER|FORMAT_MESSAGE_FROM_SYSTEM|FORMAT_MESSAGE_IGNORE_INSERTS,
-			NULL, err, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPSTR)&lpMsgBuf, 0, NULL);
+		for( size_t i = 0; i + 1 < args.size(); i += 2 )
+			patterns.add(args[i], args[i + 1]);
 
-		std::cout << "File error (" << err << "):\n" << (const char*)lpMsgBuf << "\n";
-		std::cout << path << "\n";
+		Replace(folder, "\\", "/");
 
-		LocalFree(lpMsgBuf);
-	}
-}
-
-int main(int argc, char* argv[])
-{
-	if( argc != 4 )
-	{
-		std::cout << "Usage: renumber.exe oldname newname directory\n\n";
-	}
-	else
-	{
-		std::string oldname(argv[1]);
-		std::string newname(argv[2]);
-		std::string folder(argv[3]);
+		while( folder.length() > 1 && folder[folder.length() - 1] == '/' )
+			folder.erase(folder.length() - 1);
 
-		Replace(folder, "/", "\\");
+		double start = GetTime();
 
-		if( folder[folder.length() - 1] != '\\' )
-			folder += "\\";
+		if( !RenumberTree(folder, patterns, extensions, numthreads, stats) )
+			return 1;
 
-		ProcessRecursive(oldname, newname, folder);
+		std::cout << stats.directories << " directories, " << stats.scanned << " files scanned, "
+			<< stats.updated << " updated, " << stats.renamed << " renamed, " << stats.errors << " errors in "
+			<< (GetTime() - start) << " s\n";
 	}
 
 	//system("pause");
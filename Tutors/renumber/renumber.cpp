@@ -0,0 +1,495 @@
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#include "renumber.h"
+#include "../myinterpreter/threadpool.h"
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <Windows.h>
+#else
+#	include <pthread.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <dirent.h>
+#	include <unistd.h>
+#endif
+
+struct direntry
+{
+	std::string	name;
+	bool		directory;
+};
+
+struct filemapping
+{
+#ifdef _WIN32
+	HANDLE	file;
+	HANDLE	mapping;
+#else
+	int		file;
+#endif
+
+	const char*	data;
+	size_t		size;
+};
+
+struct walkjob
+{
+#ifdef _WIN32
+	CRITICAL_SECTION	guard;
+	CONDITION_VARIABLE	workready;
+#else
+	pthread_mutex_t		guard;
+	pthread_cond_t		workready;
+#endif
+
+	const multireplace*				patterns;
+	const std::vector<std::string>*	extensions;
+
+	std::vector<std::string>	pending;	// directories to list
+	std::vector<std::string>	renames;	// directories to rename when the walk is over
+	renumberstats				stats;
+	int							active;		// directories being processed
+};
+
+static void Lock(walkjob* job)
+{
+#ifdef _WIN32
+	EnterCriticalSection(&job->guard);
+#else
+	pthread_mutex_lock(&job->guard);
+#endif
+}
+
+static void Unlock(walkjob* job)
+{
+#ifdef _WIN32
+	LeaveCriticalSection(&job->guard);
+#else
+	pthread_mutex_unlock(&job->guard);
+#endif
+}
+
+static void Wait(walkjob* job)
+{
+#ifdef _WIN32
+	SleepConditionVariableCS(&job->workready, &job->guard, INFINITE);
+#else
+	pthread_cond_wait(&job->workready, &job->guard);
+#endif
+}
+
+static void WakeAll(walkjob* job)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable(&job->workready);
+#else
+	pthread_cond_broadcast(&job->workready);
+#endif
+}
+
+static void PrintError(const std::string& path)
+{
+#ifdef _WIN32
+	DWORD err = GetLastError();
+	LPVOID lpMsgBuf = 0;
+
+	FormatMessageA(
+		FORMAT_MESSAGE_ALLOCATE_BUFFER|FORMAT_MESSAGE_FROM_SYSTEM|FORMAT_MESSAGE_IGNORE_INSERTS,
+		NULL, err, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPSTR)&lpMsgBuf, 0, NULL);
+
+	printf("File error (%u):\n%s\n%s\n", (unsigned int)err, (const char*)lpMsgBuf, path.c_str());
+	LocalFree(lpMsgBuf);
+#else
+	int err = errno;
+	printf("File error (%d):\n%s\n%s\n", err, strerror(err), path.c_str());
+#endif
+}
+
+static bool MapFile(filemapping& map, const std::string& path)
+{
+	map.data = 0;
+	map.size = 0;
+
+#ifdef _WIN32
+	LARGE_INTEGER filesize;
+
+	map.mapping = NULL;
+	map.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+	if( map.file == INVALID_HANDLE_VALUE )
+		return false;
+
+	if( !GetFileSizeEx(map.file, &filesize) )
+		return false;
+
+	// can't map an empty file, but there is nothing to replace either
+	if( filesize.QuadPart == 0 )
+		return true;
+
+	map.mapping = CreateFileMappingA(map.file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if( !map.mapping )
+		return false;
+
+	map.data = (const char*)MapViewOfFile(map.mapping, FILE_MAP_READ, 0, 0, 0);
+	map.size = (size_t)filesize.QuadPart;
+#else
+	struct stat info;
+	void* ptr;
+
+	map.file = open(path.c_str(), O_RDONLY);
+
+	if( map.file == -1 )
+		return false;
+
+	if( 0 != fstat(map.file, &info) )
+		return false;
+
+	if( info.st_size == 0 )
+		return true;
+
+	ptr = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, map.file, 0);
+
+	if( ptr == MAP_FAILED )
+		return false;
+
+	map.data = (const char*)ptr;
+	map.size = (size_t)info.st_size;
+#endif
+
+	return (map.data != 0);
+}
+
+static void UnmapFile(filemapping& map)
+{
+#ifdef _WIN32
+	if( map.data )
+		UnmapViewOfFile(map.data);
+
+	if( map.mapping )
+		CloseHandle(map.mapping);
+
+	if( map.file != INVALID_HANDLE_VALUE )
+		CloseHandle(map.file);
+
+	map.file = INVALID_HANDLE_VALUE;
+	map.mapping = NULL;
+#else
+	if( map.data )
+		munmap((void*)map.data, map.size);
+
+	if( map.file != -1 )
+		close(map.file);
+
+	map.file = -1;
+#endif
+
+	map.data = 0;
+	map.size = 0;
+}
+
+static bool ListDirectory(const std::string& path, std::vector<direntry>& entries)
+{
+	direntry entry;
+
+#ifdef _WIN32
+	WIN32_FIND_DATAA data;
+	HANDLE h = FindFirstFileA((path + "/*").c_str(), &data);
+
+	if( h == INVALID_HANDLE_VALUE )
+		return false;
+
+	do
+	{
+		entry.name = data.cFileName;
+		entry.directory = ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0);
+
+		if( entry.name != "." && entry.name != ".." )
+			entries.push_back(entry);
+	}
+	while( FindNextFileA(h, &data) );
+
+	FindClose(h);
+#else
+	DIR* d = opendir(path.c_str());
+	dirent* ent;
+
+	if( !d )
+		return false;
+
+	while( (ent = readdir(d)) != NULL )
+	{
+		entry.name = ent->d_name;
+
+		if( entry.name == "." || entry.name == ".." )
+			continue;
+
+		if( ent->d_type == DT_UNKNOWN )
+		{
+			struct stat info;
+
+			// some file systems don't fill d_type
+			entry.directory = (0 == lstat((path + "/" + entry.name).c_str(), &info) && S_ISDIR(info.st_mode));
+		}
+		else
+		{
+			entry.directory = (ent->d_type == DT_DIR);
+		}
+
+		entries.push_back(entry);
+	}
+
+	closedir(d);
+#endif
+
+	return true;
+}
+
+static bool MoveEntry(const std::string& oldpath, const std::string& newpath)
+{
+#ifdef _WIN32
+	return (0 != MoveFileA(oldpath.c_str(), newpath.c_str()));
+#else
+	return (0 == rename(oldpath.c_str(), newpath.c_str()));
+#endif
+}
+
+static bool NewName(const multireplace& patterns, const std::string& name, std::string& newname)
+{
+	// only the part before the extension is renamed
+	size_t end = name.find_last_of(".");
+	size_t length = (end == std::string::npos ? name.length() : end);
+
+	if( 0 == patterns.apply(newname, name.data(), length, 1) )
+		return false;
+
+	newname.append(name, length, std::string::npos);
+	return true;
+}
+
+static bool RenameEntry(const multireplace& patterns, const std::string& dir, const std::string& name, renumberstats& stats)
+{
+	std::string newname;
+
+	if( !NewName(patterns, name, newname) )
+		return false;
+
+	if( !MoveEntry(dir + "/" + name, dir + "/" + newname) )
+	{
+		PrintError(dir + "/" + name);
+		++stats.errors;
+
+		return false;
+	}
+
+	printf("Renamed '%s'\n", name.c_str());
+	++stats.renamed;
+
+	return true;
+}
+
+static bool ReplaceInFile(const multireplace& patterns, const std::string& path, renumberstats& stats)
+{
+	filemapping	map;
+	std::string	buff;
+	FILE*		fd;
+	size_t		count = 0;
+
+	if( MapFile(map, path) )
+		count = patterns.apply(buff, map.data, map.size);
+	else
+	{
+		PrintError(path);
+		++stats.errors;
+	}
+
+	// has to be closed before it can be overwritten
+	UnmapFile(map);
+
+	if( count == 0 )
+		return false;
+
+	fd = fopen(path.c_str(), "wb");
+
+	if( !fd || buff.length() != fwrite(buff.data(), 1, buff.length(), fd) )
+	{
+		PrintError(path);
+		++stats.errors;
+
+		if( fd )
+			fclose(fd);
+
+		return false;
+	}
+
+	fclose(fd);
+	++stats.updated;
+
+	return true;
+}
+
+static bool IsCandidate(const std::vector<std::string>& extensions, const std::string& name)
+{
+	for( size_t i = 0; i < extensions.size(); ++i )
+	{
+		if( name.rfind(extensions[i]) != std::string::npos )
+			return true;
+	}
+
+	return false;
+}
+
+static void ProcessDirectory(walkjob* job, const std::string& path, std::vector<std::string>& subdirs, std::vector<std::string>& renames, renumberstats& stats)
+{
+	std::vector<direntry> entries;
+
+	// the whole listing is read first, renaming while reading could list a file twice
+	if( !ListDirectory(path, entries) )
+	{
+		PrintError(path);
+		++stats.errors;
+
+		return;
+	}
+
+	++stats.directories;
+
+	for( size_t i = 0; i < entries.size(); ++i )
+	{
+		const direntry& entry = entries[i];
+		std::string newname;
+
+		if( entry.directory )
+		{
+			subdirs.push_back(path + "/" + entry.name);
+
+			if( NewName(*job->patterns, entry.name, newname) )
+				renames.push_back(path + "/" + entry.name);
+		}
+		else if( IsCandidate(*job->extensions, entry.name) )
+		{
+			++stats.scanned;
+
+			if( ReplaceInFile(*job->patterns, path + "/" + entry.name, stats) )
+				printf("Updated '%s'\n", entry.name.c_str());
+
+			RenameEntry(*job->patterns, path, entry.name, stats);
+		}
+	}
+}
+
+static void WalkTask(void* arg, int, int)
+{
+	walkjob*					job = (walkjob*)arg;
+	std::vector<std::string>	subdirs;
+	std::vector<std::string>	renames;
+	std::string					path;
+
+	Lock(job);
+
+	for( ;; )
+	{
+		while( job->pending.empty() && job->active > 0 )
+			Wait(job);
+
+		if( job->pending.empty() )
+			break;
+
+		path = job->pending.back();
+		job->pending.pop_back();
+		++job->active;
+
+		Unlock(job);
+		{
+			renumberstats stats;
+
+			memset(&stats, 0, sizeof(renumberstats));
+
+			subdirs.clear();
+			renames.clear();
+
+			ProcessDirectory(job, path, subdirs, renames, stats);
+
+			Lock(job);
+
+			job->pending.insert(job->pending.end(), subdirs.begin(), subdirs.end());
+			job->renames.insert(job->renames.end(), renames.begin(), renames.end());
+
+			job->stats.directories	+= stats.directories;
+			job->stats.scanned		+= stats.scanned;
+			job->stats.updated		+= stats.updated;
+			job->stats.renamed		+= stats.renamed;
+			job->stats.errors		+= stats.errors;
+
+			--job->active;
+		}
+
+		// either there is new work or everything is done
+		WakeAll(job);
+	}
+
+	Unlock(job);
+}
+
+static bool IsDeeper(const std::string& a, const std::string& b)
+{
+	return (std::count(a.begin(), a.end(), '/') > std::count(b.begin(), b.end(), '/'));
+}
+
+bool RenumberTree(const std::string& root, const multireplace& patterns, const std::vector<std::string>& extensions, int numthreads, renumberstats& stats)
+{
+	walkjob		job;
+	threadpool	pool;
+
+#ifdef _WIN32
+	InitializeCriticalSection(&job.guard);
+	InitializeConditionVariable(&job.workready);
+#else
+	pthread_mutex_init(&job.guard, NULL);
+	pthread_cond_init(&job.workready, NULL);
+#endif
+
+	memset(&job.stats, 0, sizeof(renumberstats));
+
+	job.patterns	= &patterns;
+	job.extensions	= &extensions;
+	job.active		= 0;
+
+	job.pending.push_back(root);
+
+	numthreads = std::max(numthreads, 1);
+	pool.create(numthreads - 1);
+
+	// every chunk works until the queue runs dry
+	pool.run(&WalkTask, &job, numthreads);
+	pool.destroy();
+
+	// children first, so that the paths of the parents stay valid
+	std::stable_sort(job.renames.begin(), job.renames.end(), &IsDeeper);
+
+	for( size_t i = 0; i < job.renames.size(); ++i )
+	{
+		const std::string& path = job.renames[i];
+		size_t pos = path.find_last_of("/");
+
+		RenameEntry(patterns, path.substr(0, pos), path.substr(pos + 1), job.stats);
+	}
+
+#ifdef _WIN32
+	DeleteCriticalSection(&job.guard);
+#else
+	pthread_cond_destroy(&job.workready);
+	pthread_mutex_destroy(&job.guard);
+#endif
+
+	stats = job.stats;
+	return (job.stats.directories > 0);
+}
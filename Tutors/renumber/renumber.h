@@ -0,0 +1,27 @@
+
+#ifndef _RENUMBER_H_
+#define _RENUMBER_H_
+
+#include <string>
+#include <vector>
+
+#include "search.h"
+
+struct renumberstats
+{
+	size_t	directories;
+	size_t	scanned;	// files with one of the extensions
+	size_t	updated;	// files whose content changed
+	size_t	renamed;	// files and directories
+	size_t	errors;
+};
+
+/**
+ * Replaces the patterns in the content of files whose name contains one of the
+ * extensions and renames files and directories whose name (without extension)
+ * contains a pattern. Directories are walked by numthreads threads, files are
+ * mapped and only the changed ones are written.
+ */
+bool RenumberTree(const std::string& root, const multireplace& patterns, const std::vector<std::string>& extensions, int numthreads, renumberstats& stats);
+
+#endif
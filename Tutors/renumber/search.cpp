@@ -0,0 +1,120 @@
+
+#include <cstring>
+#include "search.h"
+
+patternsearch::patternsearch()
+{
+	assign("");
+}
+
+patternsearch::patternsearch(const std::string& what)
+{
+	assign(what);
+}
+
+void patternsearch::assign(const std::string& what)
+{
+	size_t length = what.length();
+
+	pattern = what;
+
+	for( int i = 0; i < 256; ++i )
+		skip[i] = length;
+
+	// distance of the last occurrence from the end (the last character itself excluded)
+	for( size_t i = 0; i + 1 < length; ++i )
+		skip[(unsigned char)what[i]] = length - 1 - i;
+}
+
+size_t patternsearch::find(const char* data, size_t size, size_t from) const
+{
+	size_t length = pattern.length();
+
+	if( length == 0 || size < length || from > size - length )
+		return std::string::npos;
+
+	const char* str = pattern.data();
+	const char* curr = data + from;
+	const char* last = data + size - length; // last possible start
+	char first = str[0];
+	char tail = str[length - 1];
+
+	while( curr <= last )
+	{
+		curr = (const char*)memchr(curr, first, (last - curr) + 1);
+
+		if( !curr )
+			break;
+
+		if( curr[length - 1] == tail && 0 == memcmp(curr + 1, str + 1, length - 1) )
+			return (size_t)(curr - data);
+
+		// valid for any window, not only for the ones the plain algorithm would visit
+		curr += skip[(unsigned char)curr[length - 1]];
+	}
+
+	return std::string::npos;
+}
+
+void multireplace::add(const std::string& what, const std::string& with)
+{
+	if( what.empty() )
+		return;
+
+	patterns.push_back(patternsearch(what));
+	replacements.push_back(with);
+}
+
+size_t multireplace::apply(std::string& out, const char* data, size_t size, size_t maxcount) const
+{
+	std::vector<size_t> next(patterns.size());
+	size_t count = 0;
+	size_t cursor = 0;
+
+	for( size_t i = 0; i < patterns.size(); ++i )
+		next[i] = patterns[i].find(data, size);
+
+	while( count < maxcount )
+	{
+		size_t best = patterns.size();
+
+		for( size_t i = 0; i < patterns.size(); ++i )
+		{
+			if( next[i] == std::string::npos )
+				continue;
+
+			if( best == patterns.size() || next[i] < next[best] ||
+				(next[i] == next[best] && patterns[i].str().length() > patterns[best].str().length()) )
+			{
+				best = i;
+			}
+		}
+
+		if( best == patterns.size() )
+			break;
+
+		if( count == 0 )
+		{
+			out.clear();
+			out.reserve(size + size / 16);
+		}
+
+		out.append(data + cursor, next[best] - cursor);
+		out.append(replacements[best]);
+
+		cursor = next[best] + patterns[best].str().length();
+		++count;
+
+		// matches overlapping the replaced one are gone
+		for( size_t i = 0; i < patterns.size(); ++i )
+		{
+			if( next[i] != std::string::npos && next[i] < cursor )
+				next[i] = patterns[i].find(data, size, cursor);
+		}
+	}
+
+	if( count > 0 )
+		out.append(data + cursor, size - cursor);
+
+	return count;
+}
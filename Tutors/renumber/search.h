@@ -0,0 +1,48 @@
+
+#ifndef _SEARCH_H_
+#define _SEARCH_H_
+
+#include <string>
+#include <vector>
+
+// Boyer-Moore-Horspool; memchr (vectorized in the CRT) jumps to the next possible start first
+class patternsearch
+{
+private:
+	std::string	pattern;
+	size_t		skip[256];
+
+public:
+	patternsearch();
+	explicit patternsearch(const std::string& what);
+
+	void assign(const std::string& what);
+
+	// position of the first match at or after from, std::string::npos if there is none
+	size_t find(const char* data, size_t size, size_t from = 0) const;
+
+	inline const std::string& str() const {
+		return pattern;
+	}
+};
+
+class multireplace
+{
+private:
+	std::vector<patternsearch>	patterns;
+	std::vector<std::string>	replacements;
+
+public:
+	// empty patterns are ignored
+	void add(const std::string& what, const std::string& with);
+
+	// builds the result into out in one pass (leftmost match first, the longer pattern on ties);
+	// returns the number of replacements, out is left untouched if there were none
+	size_t apply(std::string& out, const char* data, size_t size, size_t maxcount = (size_t)-1) const;
+
+	inline bool empty() const {
+		return patterns.empty();
+	}
+};
+
+#endif
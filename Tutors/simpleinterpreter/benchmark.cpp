@@ -0,0 +1,139 @@
+
+#include <iostream>
+#include <fstream>
+#include <ctime>
+#include <cstdio>
+#include "interpreter.h"
+
+#define PROGRAM_FILE	"benchmark.p"
+
+// swallows the output of the interpreter, but remembers when the program first printed something
+class nullbuffer : public std::streambuf
+{
+protected:
+	int overflow(int c) {
+		if( c == '#' && firstoutput == 0 )
+			firstoutput = clock();
+
+		return c;
+	}
+
+public:
+	clock_t firstoutput;
+
+	nullbuffer() {
+		firstoutput = 0;
+	}
+};
+
+size_t GenerateProgram(const char* file, size_t numstatements)
+{
+	std::ofstream outfile(file, std::ios::out|std::ios::binary);
+
+	if( !outfile.good() )
+		return 0;
+
+	outfile << "// generated program\nint main()\n{\n";
+
+	for( size_t i = 0; i < numstatements; ++i )
+		outfile << "    print \"# statement " << i << "\\n\";\n";
+
+	outfile << "}\n";
+
+	return (size_t)outfile.tellp();
+}
+
+double Milliseconds(clock_t start, clock_t end)
+{
+	return (end - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+int main()
+{
+	nullbuffer nullbuff;
+	nullbuffer nulldiag;
+	std::streambuf* stdbuff = std::cout.rdbuf();
+	std::streambuf* diagbuff = std::cerr.rdbuf();
+
+	std::cout << "               |               |                  batch                  |           streaming\n";
+	std::cout << "    statements |     size (KB) |  compile (ms) |  run (ms) | first out (ms) |  total (ms) | first out (ms)\n";
+	std::cout << "---------------+---------------+---------------+-----------+----------------+-------------+----------------\n";
+
+	for( size_t count = 16384; count <= 262144 * 4; count *= 2 )
+	{
+		size_t filesize = GenerateProgram(PROGRAM_FILE, count);
+
+		if( filesize == 0 )
+		{
+			std::cout << "* ERROR: Could not generate program!\n";
+			break;
+		}
+
+		bool success;
+		double compiletime, runtime, firstbatch;
+		double streamtime, firststream;
+
+		// compile everything, then run
+		{
+			Interpreter ip;
+
+			nullbuff.firstoutput = 0;
+			std::cout.rdbuf(&nullbuff);
+			std::cerr.rdbuf(&nulldiag);
+
+			clock_t start = clock();
+			success = ip.Compile(PROGRAM_FILE);
+
+			clock_t middle = clock();
+			success = (success && ip.Run());
+
+			clock_t end = clock();
+
+			std::cout.rdbuf(stdbuff);
+			std::cerr.rdbuf(diagbuff);
+
+			compiletime = Milliseconds(start, middle);
+			runtime = Milliseconds(middle, end);
+			firstbatch = Milliseconds(start, nullbuff.firstoutput);
+		}
+
+		// run while compiling
+		if( success )
+		{
+			Interpreter ip;
+
+			nullbuff.firstoutput = 0;
+			std::cout.rdbuf(&nullbuff);
+			std::cerr.rdbuf(&nulldiag);
+
+			clock_t start = clock();
+			success = ip.CompileAndRun(PROGRAM_FILE);
+
+			clock_t end = clock();
+
+			std::cout.rdbuf(stdbuff);
+			std::cerr.rdbuf(diagbuff);
+
+			streamtime = Milliseconds(start, end);
+			firststream = Milliseconds(start, nullbuff.firstoutput);
+		}
+
+		if( !success )
+		{
+			std::cout << "* ERROR: Benchmark failed!\n";
+			break;
+		}
+
+		printf("%14u | %13u | %13.1f | %9.1f | %14.1f | %11.1f | %14.1f\n",
+			(unsigned int)count, (unsigned int)(filesize / 1024),
+			compiletime, runtime, firstbatch, streamtime, firststream);
+	}
+
+	remove(PROGRAM_FILE);
+
+#ifdef _MSC_VER
+	system("pause");
+#endif
+
+	return 0;
+}
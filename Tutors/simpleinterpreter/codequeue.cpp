@@ -0,0 +1,234 @@
+//=============================================================================================================
+#include "codequeue.h"
+#include <cstdlib>
+
+#ifdef _WIN32
+#   include <Windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+struct codequeue::syncobjects
+{
+#ifdef _WIN32
+    CRITICAL_SECTION    guard;
+    CONDITION_VARIABLE  notfull;
+    CONDITION_VARIABLE  notempty;
+#else
+    pthread_mutex_t     guard;
+    pthread_cond_t      notfull;
+    pthread_cond_t      notempty;
+#endif
+};
+
+struct threadstart
+{
+    thread_func func;
+    void* arg;
+};
+
+#ifdef _WIN32
+static unsigned long __stdcall Thread_Main(void* param)
+#else
+static void* Thread_Main(void* param)
+#endif
+{
+    threadstart* start = reinterpret_cast<threadstart*>(param);
+
+    start->func(start->arg);
+    delete start;
+
+    return 0;
+}
+//=============================================================================================================
+void* StartThread(thread_func func, void* arg)
+{
+    threadstart* start = new threadstart;
+
+    start->func = func;
+    start->arg = arg;
+
+#ifdef _WIN32
+    HANDLE thread = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)&Thread_Main, start, 0, NULL);
+
+    if( thread == NULL )
+        delete start;
+
+    return thread;
+#else
+    pthread_t* thread = new pthread_t;
+
+    if( 0 != pthread_create(thread, NULL, &Thread_Main, start) )
+    {
+        delete thread;
+        delete start;
+
+        return 0;
+    }
+
+    return thread;
+#endif
+}
+//=============================================================================================================
+void JoinThread(void* thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)thread, INFINITE);
+    CloseHandle((HANDLE)thread);
+#else
+    pthread_join(*((pthread_t*)thread), NULL);
+    delete (pthread_t*)thread;
+#endif
+}
+//=============================================================================================================
+codequeue::codequeue(size_t size)
+{
+    sync        = new syncobjects;
+    entries     = (code_entry*)malloc(size * sizeof(code_entry));
+    capacity    = (entries ? size : 0);
+    first       = 0;
+    count       = 0;
+    closed      = false;
+
+#ifdef _WIN32
+    InitializeCriticalSection(&sync->guard);
+    InitializeConditionVariable(&sync->notfull);
+    InitializeConditionVariable(&sync->notempty);
+#else
+    pthread_mutex_init(&sync->guard, NULL);
+    pthread_cond_init(&sync->notfull, NULL);
+    pthread_cond_init(&sync->notempty, NULL);
+#endif
+}
+//=============================================================================================================
+codequeue::~codequeue()
+{
+#ifdef _WIN32
+    DeleteCriticalSection(&sync->guard);
+#else
+    pthread_cond_destroy(&sync->notempty);
+    pthread_cond_destroy(&sync->notfull);
+    pthread_mutex_destroy(&sync->guard);
+#endif
+
+    delete sync;
+
+    if( entries )
+        free(entries);
+}
+//=============================================================================================================
+void codequeue::lock()
+{
+#ifdef _WIN32
+    EnterCriticalSection(&sync->guard);
+#else
+    pthread_mutex_lock(&sync->guard);
+#endif
+}
+//=============================================================================================================
+void codequeue::unlock()
+{
+#ifdef _WIN32
+    LeaveCriticalSection(&sync->guard);
+#else
+    pthread_mutex_unlock(&sync->guard);
+#endif
+}
+//=============================================================================================================
+void codequeue::wait(bool full)
+{
+#ifdef _WIN32
+    SleepConditionVariableCS((full ? &sync->notfull : &sync->notempty), &sync->guard, INFINITE);
+#else
+    pthread_cond_wait((full ? &sync->notfull : &sync->notempty), &sync->guard);
+#endif
+}
+//=============================================================================================================
+void codequeue::wake(bool full)
+{
+#ifdef _WIN32
+    WakeConditionVariable(full ? &sync->notfull : &sync->notempty);
+#else
+    pthread_cond_signal(full ? &sync->notfull : &sync->notempty);
+#endif
+}
+//=============================================================================================================
+void codequeue::push(const code_entry* data, size_t num)
+{
+    size_t last, space;
+
+    lock();
+
+    while( num > 0 && capacity > 0 )
+    {
+        while( count == capacity )
+            wait(true);
+
+        space = capacity - count;
+
+        if( space > num )
+            space = num;
+
+        for( size_t i = 0; i < space; ++i )
+        {
+            last = (first + count + i) % capacity;
+            entries[last] = data[i];
+        }
+
+        count += space;
+        data += space;
+        num -= space;
+
+        wake(false);
+    }
+
+    unlock();
+}
+//=============================================================================================================
+size_t codequeue::pop(code_entry* data, size_t maxnum)
+{
+    size_t num;
+
+    lock();
+
+    while( count == 0 && !closed )
+        wait(false);
+
+    num = (count < maxnum ? count : maxnum);
+
+    for( size_t i = 0; i < num; ++i )
+    {
+        data[i] = entries[first];
+        first = (first + 1) % capacity;
+    }
+
+    count -= num;
+
+    if( num > 0 )
+        wake(true);
+
+    unlock();
+    return num;
+}
+//=============================================================================================================
+void codequeue::close()
+{
+    lock();
+    {
+        closed = true;
+        wake(false);
+    }
+    unlock();
+}
+//=============================================================================================================
+void codequeue::reset()
+{
+    lock();
+    {
+        first = 0;
+        count = 0;
+        closed = false;
+    }
+    unlock();
+}
+//=============================================================================================================
@@ -0,0 +1,54 @@
+//=============================================================================================================
+#ifndef _CODEQUEUE_H_
+#define _CODEQUEUE_H_
+
+#include <cstddef>
+
+// NOTE: no platform headers here, Windows.h would clash with the parser tokens (INT)
+
+struct code_entry
+{
+    unsigned char opcode;
+    void* arg1;
+    void* arg2;
+};
+
+// bounded queue between the compiler and the executor
+class codequeue
+{
+private:
+    struct syncobjects;
+
+    syncobjects* sync;
+    code_entry*  entries;
+    size_t       capacity;
+    size_t       first;
+    size_t       count;
+    bool         closed;
+
+    void lock();
+    void unlock();
+    void wait(bool full);
+    void wake(bool full);
+
+public:
+    codequeue(size_t size);
+    ~codequeue();
+
+    // blocks while the queue is full
+    void push(const code_entry* data, size_t num);
+
+    // blocks while the queue is empty; returns 0 if closed and drained
+    size_t pop(code_entry* data, size_t maxnum);
+
+    void close();
+    void reset();
+};
+
+typedef void (*thread_func)(void* arg);
+
+void* StartThread(thread_func func, void* arg);
+void JoinThread(void* thread);
+
+#endif
+//=============================================================================================================
@@ -43,6 +43,6 @@ int yylex()
 //=============================================================================================================
 void yyerror(const char *s)
 {
-    std::cout << "* ERROR: ln " << yylloc.first_line << ": " << s << "\n";
+    std::cerr << "* ERROR: ln " << yylloc.first_line << ": " << s << "\n";
 }
 //=============================================================================================================
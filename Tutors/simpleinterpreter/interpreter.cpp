@@ -11,45 +11,77 @@ Interpreter::stm_ptr Interpreter::op_special[NUM_STAT] =
 };
 
 Interpreter::Interpreter()
+    : queue(QUEUE_SIZE)
 {
     interpreter = this;
 
-    bytecode = 0;
     bytesize = 0;
-
-    heap = 0;
     heapsize = 0;
+
+    source = 0;
+    flushsize = 1;
+    streaming = false;
+    compiled = false;
 }
 //=============================================================================================================
 Interpreter::~Interpreter()
 {
-    if( bytecode )
-    {
-        free(bytecode);
+    for( size_t i = 0; i < codesegments.size(); ++i )
+        free(codesegments[i]);
 
-        bytecode = 0;
-        bytesize = 0;
-    }
+    for( size_t i = 0; i < heapchunks.size(); ++i )
+        free(heapchunks[i]);
 
-    if( heap )
-    {
-        free(heap);
-        heapsize = 0;
-    }
+    codesegments.clear();
+    heapchunks.clear();
+
+    bytesize = 0;
+    heapsize = 0;
 }
 //=============================================================================================================
 void Interpreter::AddCodeEntry(unsigned char opcode, void* arg1, void* arg2)
 {
-    nassert(, "Interpreter::AddCodeEntry(): Out of memory",
-        (bytesize + ENTRY_SIZE) >= CODE_SIZE);
+    // entries never cross segment boundaries
+    size_t segment = bytesize / (SEGMENT_ENTRIES * ENTRY_SIZE);
+    size_t offset = bytesize % (SEGMENT_ENTRIES * ENTRY_SIZE);
 
-    char* ptr = (bytecode + bytesize);
+    if( segment == codesegments.size() )
+    {
+        char* newsegment = (char*)malloc(CODE_SEGMENT_SIZE);
+        assert(, "Interpreter::AddCodeEntry(): Out of memory", newsegment);
+
+        codesegments.push_back(newsegment);
+    }
+
+    char* ptr = (codesegments[segment] + offset);
 
     *((unsigned char*)ptr) = opcode;
     *((void**)(ptr + 1)) = arg1;
     *((void**)(ptr + 1 + sizeof(void*))) = arg2;
 
     bytesize += ENTRY_SIZE;
+
+    if( streaming )
+    {
+        code_entry entry = { opcode, arg1, arg2 };
+        pending.push_back(entry);
+    }
+}
+//=============================================================================================================
+void Interpreter::Flush(bool force)
+{
+    // called when a statement is complete; the first one is passed on immediately
+    if( !streaming || pending.empty() )
+        return;
+
+    if( force || pending.size() >= flushsize )
+    {
+        queue.push(&pending[0], pending.size());
+        pending.clear();
+
+        if( flushsize < MAX_FLUSH_SIZE )
+            flushsize *= 2;
+    }
 }
 //=============================================================================================================
 void Interpreter::Cleanup()
@@ -60,91 +92,144 @@ void Interpreter::Cleanup()
     garbage.clear();
 }
 //=============================================================================================================
-bool Interpreter::Compile(const std::string& file)
+bool Interpreter::Open(const std::string& file)
 {
 #ifdef _MSC_VER
-    FILE* infile = NULL;
-    fopen_s(&infile, file.c_str(), "rb");
+    source = NULL;
+    fopen_s(&source, file.c_str(), "rb");
 #else
-    FILE* infile = fopen(file.c_str(), "rb");
+    source = fopen(file.c_str(), "rb");
 #endif
 
-    assert(false, "Interpreter::Compile(): Could not open file", infile);
+    assert(false, "Interpreter::Open(): Could not open file", source);
 
-    // get file length
-    fseek(infile, 0, SEEK_END);
-    long end = ftell(infile);
+    // previous segments are reused
+    bytesize = 0;
+    progname = file;
 
-    fseek(infile, 0, SEEK_SET);
-    long length = end - ftell(infile);
+    return true;
+}
+//=============================================================================================================
+bool Interpreter::Parse()
+{
+    // the lexer reads the file in YY_READ_BUF_SIZE chunks through YY_INPUT
+    YY_BUFFER_STATE buffer = yy_create_buffer(source, YY_BUF_SIZE);
+    yy_switch_to_buffer(buffer);
 
-    // read program into buffer
-    char* buffer = (char*)malloc((length + 2) * sizeof(char));
-    assert(false, "Interpreter::Compile(): Could not create buffer", buffer);
+    BEGIN(INITIAL);
 
-    buffer[length + 1] = buffer[length] = 0;
+    // run lexer and parser
+    int ret = yyparse();
 
-    fread(buffer, sizeof(char), length, infile);
-    fclose(infile);
+    yy_delete_buffer(buffer);
+
+    fclose(source);
+    source = 0;
+
+    Cleanup();
+
+    nassert(false, "Interpreter::Parse(): Parser error", ret != 0);
+    return true;
+}
+//=============================================================================================================
+bool Interpreter::Compile(const std::string& file)
+{
+    if( !Open(file) )
+        return false;
 
     std::cout << "Compiling \'" << file << "\'\n";
-    yy_scan_buffer(buffer, length + 2);
+    return Parse();
+}
+//=============================================================================================================
+void Interpreter::Compile_Thread(void* param)
+{
+    Interpreter* ip = reinterpret_cast<Interpreter*>(param);
+
+    ip->compiled = ip->Parse();
+    ip->Flush(true);
+    ip->queue.close();
+}
+//=============================================================================================================
+bool Interpreter::CompileAndRun(const std::string& file)
+{
+    if( !Open(file) )
+        return false;
+
+    std::cout << "Compiling and executing \'" << file << "\'...\n";
+
+    streaming = true;
+    compiled = false;
+
+    pending.clear();
+    queue.reset();
 
-    if( !bytecode )
-        bytecode = (char*)malloc(CODE_SIZE);
+    flushsize = 1;
 
-    if( !heap )
+    void* thread = StartThread(&Interpreter::Compile_Thread, this);
+
+    if( !thread )
     {
-        heapsize = 0;
-        heap = (char*)malloc(HEAP_SIZE);
+        // fall back to compiling first
+        streaming = false;
+        std::cerr << "* WARNING: Could not create compiler thread!\n";
+
+        if( !Parse() )
+            return false;
+
+        return Run();
     }
 
-    bytesize = 0;
-    progname = file;
+    // execute entries as the compiler produces them
+    code_entry entries[MAX_FLUSH_SIZE];
+    size_t count;
 
-    // run lexer and parser
-    int ret = yyparse();
+    while( (count = queue.pop(entries, MAX_FLUSH_SIZE)) > 0 )
+    {
+        for( size_t i = 0; i < count; ++i )
+            Execute(entries[i].opcode, entries[i].arg1, entries[i].arg2);
+    }
 
-    yy_delete_buffer(YY_CURRENT_BUFFER);
-    free(buffer);
+    JoinThread(thread);
 
-    Cleanup();
+    streaming = false;
 
-    nassert(false, "Interpreter::Compile(): Parser error", ret != 0);
+    nassert(false, "Interpreter::CompileAndRun(): Parser error", !compiled);
     return true;
 }
 //=============================================================================================================
 bool Interpreter::Run()
 {
     std::cout << "Executing program '" << progname << "'...\n";
-    assert(false, "Interpreter::Run(): No code generated", bytecode);
+    assert(false, "Interpreter::Run(): No code generated", !codesegments.empty());
 
-    size_t off = 0;
-    stm_ptr stm;
+    size_t segsize = SEGMENT_ENTRIES * ENTRY_SIZE;
+    size_t remaining = bytesize;
+    size_t off, end;
     unsigned char opcode;
     void *arg1, *arg2;
+    char* bytecode;
     char* ptr;
 
-    while( off != bytesize )
+    for( size_t i = 0; remaining > 0; ++i )
     {
-        ptr = (bytecode + off);
+        bytecode = codesegments[i];
+        end = (remaining < segsize ? remaining : segsize);
+        off = 0;
 
-        opcode = *((unsigned char*)ptr);
-        arg1 = *((void**)(ptr + 1));
-        arg2 = *((void**)(ptr + 1 + sizeof(void*)));
+        while( off != end )
+        {
+            ptr = (bytecode + off);
 
-        off += ENTRY_SIZE;
+            opcode = *((unsigned char*)ptr);
+            arg1 = *((void**)(ptr + 1));
+            arg2 = *((void**)(ptr + 1 + sizeof(void*)));
 
-        // 20 special statements reserved
-        if( opcode < 0x20 )
-        {
-            stm = op_special[opcode];
-            (*stm)(arg1, arg2);
-        }
-        else
-        {
-            // TODO: common statements
+            off += ENTRY_SIZE;
+
+            Execute(opcode, arg1, arg2);
         }
+
+        remaining -= end;
     }
 
     return true;
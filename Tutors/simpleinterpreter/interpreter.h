@@ -3,20 +3,28 @@
 #define _INTERPRETER_H_
 
 #include <iostream>
+#include <cstdio>
 #include <string>
 #include <list>
+#include <vector>
 
-#define lexer_out(x)      { std::cout << "* LEXER: " << x << "\n"; }
-#define parser_out(x)     { std::cout << "* PARSER: " << x << "\n"; }
-#define assert(r, e, x)   { if( !(x) ) { std::cout << "* ERROR: " << e << "!\n"; return r; } }
-#define nassert(r, e, x)  { if( x ) { std::cout << "* ERROR: " << e << "!\n"; return r; } }
+#include "codequeue.h"
+
+// diagnostics go to std::cerr, as the compiler thread runs concurrently with the program in CompileAndRun()
+#define lexer_out(x)      { std::cerr << "* LEXER: " << x << "\n"; }
+#define parser_out(x)     { std::cerr << "* PARSER: " << x << "\n"; }
+#define assert(r, e, x)   { if( !(x) ) { std::cerr << "* ERROR: " << e << "!\n"; return r; } }
+#define nassert(r, e, x)  { if( x ) { std::cerr << "* ERROR: " << e << "!\n"; return r; } }
 
 #define NUM_STAT          1
 #define OP_PRINT          0x0
 
-#define HEAP_SIZE         262144
-#define CODE_SIZE         65536
+#define HEAP_CHUNK_SIZE   262144
+#define CODE_SEGMENT_SIZE 65536
 #define ENTRY_SIZE        (1 + 2 * sizeof(void*))
+#define SEGMENT_ENTRIES   (CODE_SEGMENT_SIZE / ENTRY_SIZE)
+#define QUEUE_SIZE        4096
+#define MAX_FLUSH_SIZE    256
 
 class Interpreter
 {
@@ -28,21 +36,40 @@ class Interpreter
 
     // special statements
     static void Execute_Print(void* arg1, void* arg2);
+    static inline void Execute(unsigned char opcode, void* arg1, void* arg2);
+    static void Compile_Thread(void* param);
 
 private:
     typedef std::list<std::string*> garbagelist;
+    typedef std::vector<char*> chunklist;
 
     garbagelist garbage;
     std::string progname;
 
-    char* bytecode;
-    char* heap;
-    size_t bytesize;
-    size_t heapsize;
+    // neither of them moves existing data when growing
+    chunklist codesegments;
+    chunklist heapchunks;
+
+    size_t bytesize;    // total size of code
+    size_t heapsize;    // used bytes in last heap chunk
+
+    // streaming mode
+    typedef std::vector<code_entry> entrylist;
+
+    codequeue queue;
+    entrylist pending;  // entries of completed statements
+    size_t flushsize;   // grows to amortize thread switches
+    FILE* source;
+    bool streaming;
+    bool compiled;
     
     void AddCodeEntry(unsigned char opcode, void* arg1, void* arg2);
+    void Flush(bool force = false);
     void Cleanup();
 
+    bool Open(const std::string& file);
+    bool Parse();
+
     template <typename T>
     void* Allocate(T* ptr);
 
@@ -52,19 +79,46 @@ public:
 
     bool Compile(const std::string& file);
     bool Run();
+
+    // executes statements while the rest of the file is being compiled
+    bool CompileAndRun(const std::string& file);
 };
 
+inline void Interpreter::Execute(unsigned char opcode, void* arg1, void* arg2)
+{
+    // 20 special statements reserved
+    if( opcode < 0x20 )
+    {
+        stm_ptr stm = op_special[opcode];
+        (*stm)(arg1, arg2);
+    }
+    else
+    {
+        // TODO: common statements
+    }
+}
+
 template <typename T>
 void* Interpreter::Allocate(T* data)
 {
-    assert(0, "Interpreter::Allocate<T>(): Heap not yet created", heap);
-    nassert(0, "Interpreter::Allocate<T>(): Out of memory",
-        (heapsize + sizeof(T)) >= HEAP_SIZE);
+    size_t size = (sizeof(T) + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+    nassert(0, "Interpreter::Allocate<T>(): Object is too large",
+        size > HEAP_CHUNK_SIZE);
+
+    if( heapchunks.empty() || (heapsize + size) > HEAP_CHUNK_SIZE )
+    {
+        char* chunk = (char*)malloc(HEAP_CHUNK_SIZE);
+        assert(0, "Interpreter::Allocate<T>(): Out of memory", chunk);
+
+        heapchunks.push_back(chunk);
+        heapsize = 0;
+    }
 
-    char* ptr = (heap + heapsize);
+    char* ptr = (heapchunks.back() + heapsize);
 
     new (ptr) T(*data);
-    heapsize += sizeof(T);
+    heapsize += size;
 
     return ptr;
 }
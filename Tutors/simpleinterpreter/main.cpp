@@ -9,10 +9,7 @@ int main()
 {
 	{
 		Interpreter ip;
-		ip.Compile("../simpleinterpreter/programs/helloworld.p");
-
-		std::cout << "\n";
-		ip.Run();
+		ip.CompileAndRun("../simpleinterpreter/programs/helloworld.p");
 	}
 
 	_CrtDumpMemoryLeaks();
@@ -1478,13 +1478,14 @@ yyreduce:
 #line 94 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
     {
                parser_out("statement -> print");
+               interpreter->Flush();
            ;}
     break;
 
   case 11:
 
 /* Line 1455 of yacc.c  */
-#line 100 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
+#line 101 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
     {
            parser_out("print -> PRINT string");
            interpreter->AddCodeEntry(OP_PRINT, interpreter->Allocate<std::string>((yyvsp[(2) - (2)].text_t)), 0);
@@ -1494,7 +1495,7 @@ yyreduce:
   case 12:
 
 /* Line 1455 of yacc.c  */
-#line 107 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
+#line 108 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
     {
             parser_out("string -> QUOTE STRING QUOTE");
             (yyval.text_t) = (yyvsp[(2) - (3)].text_t);
@@ -1723,7 +1724,7 @@ yyreturn:
 
 
 /* Line 1675 of yacc.c  */
-#line 114 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
+#line 115 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
 
 
 #ifdef _MSC_VER
@@ -93,6 +93,7 @@ statement_block: statement SEMICOLON
 statement: print
            {
                parser_out("statement -> print");
+               interpreter->Flush();
            }
 ;
 